@@ -0,0 +1,251 @@
+#include "BenchmarkRunner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <format>
+#include <fstream>
+#include <numeric>
+#include <print>
+#include <stdexcept>
+
+static const void* volatile OptimizationSink = nullptr;
+
+void doNotOptimizeAway(const void* value) {
+    OptimizationSink = value;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+}
+
+static f64 computeMedian(std::vector<f64> values) {
+    std::ranges::sort(values);
+
+    const auto middle = values.size() / 2;
+    if (values.size() % 2 == 0) {
+        return (values[middle - 1] + values[middle]) / 2.0;
+    } else {
+        return values[middle];
+    }
+}
+
+static f64 computeQuantile(const std::vector<f64>& sortedValues, f64 quantile) {
+    const auto position = quantile * static_cast<f64>(sortedValues.size() - 1);
+    const auto lowerIndex = static_cast<usize>(std::floor(position));
+    const auto upperIndex = std::min(lowerIndex + 1, sortedValues.size() - 1);
+    const auto fraction = position - static_cast<f64>(lowerIndex);
+
+    return sortedValues[lowerIndex] + (sortedValues[upperIndex] - sortedValues[lowerIndex]) * fraction;
+}
+
+static BenchmarkStatistics computeStatistics(const std::vector<f64>& samples) {
+    auto statistics = BenchmarkStatistics{};
+
+    const auto sampleCount = static_cast<f64>(samples.size());
+    const auto sum = std::accumulate(samples.begin(), samples.end(), 0.0);
+
+    statistics.mean = sum / sampleCount;
+    statistics.median = computeMedian(samples);
+    statistics.minimum = std::ranges::min(samples);
+    statistics.maximum = std::ranges::max(samples);
+
+    auto squaredDeviationSum = 0.0;
+    for (const auto sample : samples) {
+        squaredDeviationSum += (sample - statistics.mean) * (sample - statistics.mean);
+    }
+
+    if (samples.size() > 1) {
+        statistics.standardDeviation = std::sqrt(squaredDeviationSum / (sampleCount - 1.0));
+        statistics.confidenceInterval95 = 1.96 * statistics.standardDeviation / std::sqrt(sampleCount);
+    }
+
+    auto absoluteDeviations = std::vector<f64>{};
+    for (const auto sample : samples) {
+        absoluteDeviations.push_back(std::abs(sample - statistics.median));
+    }
+
+    statistics.medianAbsoluteDeviation = computeMedian(absoluteDeviations);
+
+    auto sortedSamples = samples;
+    std::ranges::sort(sortedSamples);
+
+    const auto firstQuartile = computeQuantile(sortedSamples, 0.25);
+    const auto thirdQuartile = computeQuantile(sortedSamples, 0.75);
+    const auto interquartileRange = thirdQuartile - firstQuartile;
+
+    const auto lowerFence = firstQuartile - 1.5 * interquartileRange;
+    const auto upperFence = thirdQuartile + 1.5 * interquartileRange;
+
+    statistics.outlierCount = std::ranges::count_if(samples, [lowerFence, upperFence](f64 sample) {
+        return sample < lowerFence || sample > upperFence;
+    });
+
+    return statistics;
+}
+
+static std::string escapeJsonString(std::string_view value) {
+    auto escaped = std::string{};
+
+    for (const auto character : value) {
+        switch (character) {
+        case '"':
+            escaped += "\\\"";
+            break;
+        case '\\':
+            escaped += "\\\\";
+            break;
+        case '\n':
+            escaped += "\\n";
+            break;
+        case '\t':
+            escaped += "\\t";
+            break;
+        default:
+            escaped += character;
+            break;
+        }
+    }
+
+    return escaped;
+}
+
+static std::string_view getCompilerName() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    return "msvc";
+#elif defined(__clang__)
+    return "clang";
+#elif defined(__GNUC__)
+    return "gcc";
+#else
+    return "unknown";
+#endif
+}
+
+BenchmarkRunner::BenchmarkRunner(const BenchmarkSettings& settings)
+    : _settings(settings) {
+    if (_settings.sampleCount == 0) {
+        throw std::runtime_error("Benchmark sample count must be positive");
+    }
+}
+
+void BenchmarkRunner::add(std::string name, BenchmarkFunction function) {
+    _benchmarks.emplace_back(std::move(name), std::move(function));
+}
+
+usize BenchmarkRunner::_calibrateIterationCount(const BenchmarkFunction& function) const {
+    using Clock = std::chrono::steady_clock;
+
+    auto iterationCount = 1ull;
+
+    while (true) {
+        const auto start = Clock::now();
+        function(iterationCount);
+        const auto elapsed = Clock::now() - start;
+
+        if (elapsed >= _settings.minimumSampleDuration) {
+            return iterationCount;
+        }
+
+        const auto elapsedNanoseconds = std::max<i64>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(), 1);
+        const auto targetNanoseconds = _settings.minimumSampleDuration.count();
+        const auto estimatedIterationCount = iterationCount * targetNanoseconds / elapsedNanoseconds + 1;
+
+        iterationCount = std::clamp<usize>(estimatedIterationCount, iterationCount + 1, iterationCount * 10);
+    }
+}
+
+void BenchmarkRunner::run() {
+    using Clock = std::chrono::steady_clock;
+
+    for (const auto& benchmark : _benchmarks) {
+        if (!_settings.filter.empty() && !benchmark.name.contains(_settings.filter)) {
+            continue;
+        }
+
+        const auto iterationCount = _calibrateIterationCount(benchmark.function);
+
+        for (auto warmupIndex = 0ull; warmupIndex < _settings.warmupSampleCount; warmupIndex++) {
+            benchmark.function(iterationCount);
+        }
+
+        auto result = BenchmarkResult{};
+        result.name = benchmark.name;
+        result.iterationsPerSample = iterationCount;
+
+        for (auto sampleIndex = 0ull; sampleIndex < _settings.sampleCount; sampleIndex++) {
+            const auto start = Clock::now();
+            benchmark.function(iterationCount);
+            const auto elapsed = std::chrono::duration<f64, std::nano>{ Clock::now() - start };
+
+            result.sampleNanoseconds.push_back(elapsed.count() / static_cast<f64>(iterationCount));
+        }
+
+        result.statistics = computeStatistics(result.sampleNanoseconds);
+
+        const auto& statistics = result.statistics;
+        const auto relativeDeviation = statistics.median > 0.0 ? 100.0 * statistics.medianAbsoluteDeviation / statistics.median : 0.0;
+
+        std::println(
+            "{:<56} median {:>14.1f} ns  mean {:>14.1f} ns +- {:>10.1f}  mad {:>5.1f}%  outliers {}",
+            result.name,
+            statistics.median,
+            statistics.mean,
+            statistics.confidenceInterval95,
+            relativeDeviation,
+            statistics.outlierCount
+        );
+
+        _results.push_back(std::move(result));
+    }
+}
+
+void BenchmarkRunner::writeJson(const std::filesystem::path& path) const {
+    auto file = std::ofstream{ path };
+    if (!file) {
+        throw std::runtime_error(std::format("Failed to open benchmark output file {}", path.string()));
+    }
+
+    const auto timestamp = std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now());
+
+    file << "{\n";
+    file << "  \"context\": {\n";
+    file << std::format("    \"label\": \"{}\",\n", escapeJsonString(_settings.label));
+    file << std::format("    \"timestamp\": \"{:%FT%TZ}\",\n", timestamp);
+    file << std::format("    \"compiler\": \"{}\",\n", getCompilerName());
+    file << std::format("    \"sampleCount\": {},\n", _settings.sampleCount);
+    file << std::format("    \"warmupSampleCount\": {},\n", _settings.warmupSampleCount);
+    file << std::format("    \"minimumSampleNanoseconds\": {}\n", _settings.minimumSampleDuration.count());
+    file << "  },\n";
+    file << "  \"benchmarks\": [\n";
+
+    for (auto resultIndex = 0ull; resultIndex < _results.size(); resultIndex++) {
+        const auto& result = _results[resultIndex];
+        const auto& statistics = result.statistics;
+
+        file << "    {\n";
+        file << std::format("      \"name\": \"{}\",\n", escapeJsonString(result.name));
+        file << std::format("      \"iterationsPerSample\": {},\n", result.iterationsPerSample);
+        file << std::format("      \"meanNanoseconds\": {},\n", statistics.mean);
+        file << std::format("      \"medianNanoseconds\": {},\n", statistics.median);
+        file << std::format("      \"standardDeviationNanoseconds\": {},\n", statistics.standardDeviation);
+        file << std::format("      \"medianAbsoluteDeviationNanoseconds\": {},\n", statistics.medianAbsoluteDeviation);
+        file << std::format("      \"confidenceInterval95Nanoseconds\": {},\n", statistics.confidenceInterval95);
+        file << std::format("      \"minimumNanoseconds\": {},\n", statistics.minimum);
+        file << std::format("      \"maximumNanoseconds\": {},\n", statistics.maximum);
+        file << std::format("      \"outlierCount\": {},\n", statistics.outlierCount);
+        file << "      \"samplesNanoseconds\": [";
+
+        for (auto sampleIndex = 0ull; sampleIndex < result.sampleNanoseconds.size(); sampleIndex++) {
+            const auto separator = sampleIndex + 1 < result.sampleNanoseconds.size() ? ", " : "";
+            file << std::format("{}{}", result.sampleNanoseconds[sampleIndex], separator);
+        }
+
+        file << "]\n";
+        file << (resultIndex + 1 < _results.size() ? "    },\n" : "    }\n");
+    }
+
+    file << "  ]\n";
+    file << "}\n";
+}
+
+const std::vector<BenchmarkResult>& BenchmarkRunner::getResults() const {
+    return _results;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Pandora/Pandora.h"
+
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct BenchmarkSettings {
+    usize sampleCount = 30;
+    usize warmupSampleCount = 3;
+    std::chrono::nanoseconds minimumSampleDuration = std::chrono::milliseconds{ 10 };
+    std::string filter{};
+    std::string label{};
+};
+
+struct BenchmarkStatistics {
+    f64 mean{};
+    f64 median{};
+    f64 standardDeviation{};
+    f64 medianAbsoluteDeviation{};
+    f64 confidenceInterval95{};
+    f64 minimum{};
+    f64 maximum{};
+    usize outlierCount{};
+};
+
+struct BenchmarkResult {
+    std::string name{};
+    usize iterationsPerSample{};
+    std::vector<f64> sampleNanoseconds{};
+    BenchmarkStatistics statistics{};
+};
+
+// The benchmark function receives the iteration count so the call overhead
+// is paid once per sample instead of once per iteration.
+using BenchmarkFunction = std::function<void(usize iterationCount)>;
+
+class BenchmarkRunner {
+public:
+    BenchmarkRunner(const BenchmarkSettings& settings);
+
+    void add(std::string name, BenchmarkFunction function);
+    void run();
+
+    void writeJson(const std::filesystem::path& path) const;
+
+    const std::vector<BenchmarkResult>& getResults() const;
+private:
+    struct RegisteredBenchmark {
+        std::string name{};
+        BenchmarkFunction function{};
+    };
+
+    usize _calibrateIterationCount(const BenchmarkFunction& function) const;
+
+    BenchmarkSettings _settings{};
+
+    std::vector<RegisteredBenchmark> _benchmarks{};
+    std::vector<BenchmarkResult> _results{};
+};
+
+void doNotOptimizeAway(const void* value);
+
+template<class T>
+void doNotOptimize(const T& value) {
+    doNotOptimizeAway(&value);
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "BenchmarkRunner.h"
+
+void registerChessCoreBenchmarks(BenchmarkRunner& runner);
+
+void registerSceneRendererBenchmarks(BenchmarkRunner& runner);
+
+void registerImageBenchmarks(BenchmarkRunner& runner);
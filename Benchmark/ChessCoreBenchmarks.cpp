@@ -0,0 +1,102 @@
+#include "Benchmarks.h"
+
+#include "ChessCore/BatchMoveGen.h"
+#include "ChessCore/Fen.h"
+#include "ChessCore/MoveGen.h"
+#include "ChessCore/Position.h"
+
+#include <array>
+#include <format>
+#include <string_view>
+#include <vector>
+
+using namespace ChessCore;
+
+struct BenchmarkPosition {
+    std::string_view name{};
+    std::string_view fen{};
+};
+
+static constexpr BenchmarkPosition BenchmarkPositions[] = {
+    { "Start", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1" },
+    { "Opening", "r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4" },
+    { "Middlegame", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1" },
+    { "Endgame", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1" },
+    { "Check", "rnb1kbnr/pppp1ppp/8/4p3/6Pq/5P2/PPPPP2P/RNBQKBNR w KQkq - 1 3" },
+};
+
+void registerChessCoreBenchmarks(BenchmarkRunner& runner) {
+    for (const auto& benchmarkPosition : BenchmarkPositions) {
+        const auto position = createPositionFromFen(benchmarkPosition.fen);
+        const auto fen = benchmarkPosition.fen;
+
+        runner.add(std::format("ChessCore/ParseFen/{}", benchmarkPosition.name), [fen](usize iterationCount) {
+            for (auto iteration = 0ull; iteration < iterationCount; iteration++) {
+                auto parsedPosition = Position{};
+                const auto result = parseFen(fen, parsedPosition);
+                doNotOptimize(result);
+                doNotOptimize(parsedPosition);
+            }
+        });
+
+        runner.add(std::format("ChessCore/WriteFen/{}", benchmarkPosition.name), [position](usize iterationCount) {
+            auto buffer = FenBuffer{};
+
+            for (auto iteration = 0ull; iteration < iterationCount; iteration++) {
+                const auto writtenFen = writeFen(position, buffer);
+                doNotOptimize(writtenFen);
+            }
+        });
+
+        runner.add(std::format("ChessCore/ComputePseudoLegalMoves/{}", benchmarkPosition.name), [position](usize iterationCount) {
+            for (auto iteration = 0ull; iteration < iterationCount; iteration++) {
+                auto moves = MoveList{};
+                computePseudoLegalMoves(position, moves);
+                doNotOptimize(moves);
+            }
+        });
+
+        runner.add(std::format("ChessCore/ComputeLegalMoves/{}", benchmarkPosition.name), [position](usize iterationCount) {
+            for (auto iteration = 0ull; iteration < iterationCount; iteration++) {
+                auto moves = MoveList{};
+                computeLegalMoves(position, moves);
+                doNotOptimize(moves);
+            }
+        });
+
+        runner.add(std::format("ChessCore/IsKingUnderCheck/{}", benchmarkPosition.name), [position](usize iterationCount) {
+            for (auto iteration = 0ull; iteration < iterationCount; iteration++) {
+                const auto isUnderCheck = position.isKingUnderCheck();
+                doNotOptimize(isUnderCheck);
+            }
+        });
+    }
+
+    // All positions per iteration, so the scalar loop and the batch generator do the same work.
+    auto positions = std::vector<Position>{};
+    auto bitboardPositions = std::vector<BitboardPosition>{};
+
+    for (const auto& benchmarkPosition : BenchmarkPositions) {
+        positions.push_back(createPositionFromFen(benchmarkPosition.fen));
+        bitboardPositions.push_back(mapPositionToBitboardPosition(positions.back()));
+    }
+
+    runner.add("ChessCore/ComputeLegalMoves/All", [positions](usize iterationCount) {
+        for (auto iteration = 0ull; iteration < iterationCount; iteration++) {
+            for (const auto& position : positions) {
+                auto moves = MoveList{};
+                computeLegalMoves(position, moves);
+                doNotOptimize(moves);
+            }
+        }
+    });
+
+    runner.add("ChessCore/ComputeBitboardMoveSummaries/All", [bitboardPositions](usize iterationCount) {
+        auto summaries = std::array<BitboardMoveSummary, std::size(BenchmarkPositions)>{};
+
+        for (auto iteration = 0ull; iteration < iterationCount; iteration++) {
+            computeBitboardMoveSummaries(bitboardPositions, summaries);
+            doNotOptimize(summaries);
+        }
+    });
+}
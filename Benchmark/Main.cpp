@@ -0,0 +1,72 @@
+#include "Benchmarks.h"
+
+#include <charconv>
+#include <print>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+
+struct BenchmarkCommandLine {
+    BenchmarkSettings settings{};
+    std::filesystem::path outputPath = "benchmark_results.json";
+};
+
+static usize parseCount(std::string_view value) {
+    auto count = 0ull;
+
+    const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), count);
+    if (error != std::errc{} || end != value.data() + value.size()) {
+        throw std::runtime_error("Expected a number");
+    }
+
+    return count;
+}
+
+static BenchmarkCommandLine parseCommandLine(std::span<char*> arguments) {
+    auto commandLine = BenchmarkCommandLine{};
+
+    for (auto argumentIndex = 1ull; argumentIndex < arguments.size(); argumentIndex++) {
+        const auto argument = std::string_view{ arguments[argumentIndex] };
+
+        if (argumentIndex + 1 >= arguments.size()) {
+            throw std::runtime_error("Missing value for benchmark option");
+        }
+
+        const auto value = std::string_view{ arguments[++argumentIndex] };
+
+        if (argument == "--output") {
+            commandLine.outputPath = value;
+        } else if (argument == "--filter") {
+            commandLine.settings.filter = value;
+        } else if (argument == "--label") {
+            commandLine.settings.label = value;
+        } else if (argument == "--samples") {
+            commandLine.settings.sampleCount = parseCount(value);
+        } else if (argument == "--warmup") {
+            commandLine.settings.warmupSampleCount = parseCount(value);
+        } else if (argument == "--min-sample-ms") {
+            commandLine.settings.minimumSampleDuration = std::chrono::milliseconds{ parseCount(value) };
+        } else {
+            throw std::runtime_error("Unknown benchmark option");
+        }
+    }
+
+    return commandLine;
+}
+
+int main(int argc, char** argv) {
+    const auto commandLine = parseCommandLine(std::span{ argv, static_cast<usize>(argc) });
+
+    auto runner = BenchmarkRunner{ commandLine.settings };
+
+    registerChessCoreBenchmarks(runner);
+    registerSceneRendererBenchmarks(runner);
+    registerImageBenchmarks(runner);
+
+    runner.run();
+    runner.writeJson(commandLine.outputPath);
+
+    std::println("Results written to {}", commandLine.outputPath.string());
+
+    return 0;
+}
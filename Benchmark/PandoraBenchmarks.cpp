@@ -0,0 +1,88 @@
+#include "Benchmarks.h"
+
+#include "Pandora/Graphics/SceneRenderer.h"
+#include "Pandora/Graphics/Scene.h"
+#include "Pandora/Image.h"
+
+#include <format>
+#include <random>
+
+using namespace Pandora;
+
+static constexpr usize SceneRendererSpriteCounts[] = { 100, 10'000, 1'000'000 };
+static constexpr u32 SceneRendererLayerCount = 8;
+
+static constexpr u32 ImageSizes[] = { 80, 1024 };
+
+static std::vector<Sprite> generateSprites(usize count) {
+    auto generator = std::mt19937{ 1771 };
+    auto positionDistribution = std::uniform_real_distribution<f32>{ 0.f, 640.f };
+    auto layerDistribution = std::uniform_int_distribution<u32>{ 0, SceneRendererLayerCount - 1 };
+
+    auto sprites = std::vector<Sprite>(count);
+
+    for (auto& sprite : sprites) {
+        sprite.position = Vector2f{ positionDistribution(generator), positionDistribution(generator) };
+        sprite.scale = Vector2f{ 80.f };
+        sprite.zIndex = layerDistribution(generator);
+    }
+
+    return sprites;
+}
+
+void registerSceneRendererBenchmarks(BenchmarkRunner& runner) {
+    for (const auto spriteCount : SceneRendererSpriteCounts) {
+        const auto sprites = generateSprites(spriteCount);
+
+        // mapSpritesToDrawCommands sorts in place, so every iteration starts from an unsorted copy.
+        // CopySprites measures that copy alone so it can be subtracted from the mapping result.
+        runner.add(std::format("SceneRenderer/CopySprites/{}", spriteCount), [sprites](usize iterationCount) {
+            auto spritesCopy = std::vector<Sprite>{};
+
+            for (auto iteration = 0ull; iteration < iterationCount; iteration++) {
+                spritesCopy = sprites;
+                doNotOptimize(spritesCopy);
+            }
+        });
+
+        runner.add(std::format("SceneRenderer/MapSpritesToDrawCommands/{}", spriteCount), [sprites](usize iterationCount) {
+            auto vertices = std::vector<Implementation::Vertex>{};
+            auto indices = std::vector<u32>{};
+            auto spritesCopy = std::vector<Sprite>{};
+
+            for (auto iteration = 0ull; iteration < iterationCount; iteration++) {
+                spritesCopy = sprites;
+
+                const auto drawCommands = Implementation::mapSpritesToDrawCommands(vertices, indices, spritesCopy);
+                doNotOptimize(drawCommands);
+                doNotOptimize(vertices);
+            }
+        });
+    }
+}
+
+void registerImageBenchmarks(BenchmarkRunner& runner) {
+    for (const auto imageSize : ImageSizes) {
+        runner.add(std::format("Image/Create/{}x{}", imageSize, imageSize), [imageSize](usize iterationCount) {
+            for (auto iteration = 0ull; iteration < iterationCount; iteration++) {
+                const auto image = Image::create(imageSize, imageSize, Color8{ 95, 148, 92 });
+                doNotOptimize(image);
+            }
+        });
+
+        runner.add(std::format("Image/SetPixelFill/{}x{}", imageSize, imageSize), [imageSize](usize iterationCount) {
+            auto image = Image::create(imageSize, imageSize, {});
+            const auto color = Color8{ 178, 209, 189 };
+
+            for (auto iteration = 0ull; iteration < iterationCount; iteration++) {
+                for (auto x = 0u; x < imageSize; x++) {
+                    for (auto y = 0u; y < imageSize; y++) {
+                        image.setPixel(x, y, color);
+                    }
+                }
+
+                doNotOptimize(image);
+            }
+        });
+    }
+}
@@ -1,3 +1,15 @@
+#include "ChessCore/Fen.h"
+#include "ChessCore/LegalMoveTracker.h"
+#include "ChessCore/MateSolver.h"
+#include "ChessCore/MoveGen.h"
+#include "ChessCore/PolyglotBook.h"
+#include "ChessCore/Position.h"
+#include "ChessCore/PositionIndex.h"
+#include "ChessCore/Review.h"
+#include "ChessCore/San.h"
+#include "ChessCore/Search.h"
+#include "ChessCore/Syzygy.h"
+
 #include "Pandora/Windowing/Window.h"
 #include "Pandora/Mathematics/Vector.h"
 #include "Pandora/Image.h"
@@ -7,83 +19,48 @@
 #include "Pandora/Graphics/SceneRenderer.h"
 #include "Pandora/Graphics/Scene.h"
 
+#include <atomic>
 #include <filesystem>
+#include <functional>
 #include <optional>
 #include <compare>
 #include <algorithm>
 #include <array>
+#include <bit>
+#include <chrono>
 #include <ranges>
 #include <optional>
 #include <print>
 #include <map>
+#include <mutex>
+#include <random>
+#include <format>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <utility>
 
 using namespace Pandora;
+using namespace ChessCore;
 
-enum class ChessPieceType : i16 {
-    None,
-    Queen,
-    Rook,
-    Bishop,
-    Knight,
-    Pawn,
-    King,
-};
+static constexpr u32 BoardSquarePixelSize = 80;
 
-static bool isSlidingPiece(ChessPieceType type) {
-    using enum ChessPieceType;
-    return type == Queen || type == Rook || type == Bishop;
-}
+static const auto OpeningBookPath = std::filesystem::path{ "./Assets/Books/Book.bin" };
+static const auto TablebaseDirectoryPath = std::filesystem::path{ "./Assets/Syzygy" };
+static constexpr u32 ReviewSearchDepth = 6;
 
-enum class ChessPieceColorType : i16 {
-    None,
-    Black,
-    White
-};
+static constexpr auto EngineMoveTime = std::chrono::milliseconds{ 1000 };
+static constexpr usize EngineHashSize = 64;
 
-static ChessPieceColorType mapColorToOpposite(ChessPieceColorType type) {
-    using enum ChessPieceColorType;
-    return type == Black ? White : Black;
-}
+static constexpr u32 AnalysisSearchDepth = 6;
+static constexpr usize AnalysisLineCount = 3;
+static constexpr usize AnalysisHashSize = 64;
 
-struct ChessPiece {
-    ChessPieceType type{};
-    ChessPieceColorType color{};
-    bool isEnPassantable{};
-    bool hasMoved{};
+static constexpr u32 MateSearchMoveCount = 10;
+static constexpr u64 MateSearchNodeCount = 2'000'000;
+static constexpr usize MateSearchHashSize = 64;
 
-    auto operator<=>(const ChessPiece& other) const {
-        if (auto comparison = type <=> other.type; comparison != 0) {
-            return comparison;
-        } else {
-            return color <=> other.color;
-        }
-    }
-
-    auto operator==(const ChessPiece& other) const {
-        return type == other.type && color == other.color;
-    }
-};
-
-namespace ChessPieces {
-
-    constexpr auto None = ChessPiece{ ChessPieceType::None, ChessPieceColorType::None };
-    constexpr auto QueenWhite = ChessPiece{ ChessPieceType::Queen, ChessPieceColorType::White };
-    constexpr auto QueenBlack = ChessPiece{ ChessPieceType::Queen, ChessPieceColorType::Black };
-    constexpr auto RookWhite = ChessPiece{ ChessPieceType::Rook, ChessPieceColorType::White };
-    constexpr auto RookBlack = ChessPiece{ ChessPieceType::Rook, ChessPieceColorType::Black };
-    constexpr auto BishopWhite = ChessPiece{ ChessPieceType::Bishop, ChessPieceColorType::White };
-    constexpr auto BishopBlack = ChessPiece{ ChessPieceType::Bishop, ChessPieceColorType::Black };
-    constexpr auto KnightWhite = ChessPiece{ ChessPieceType::Knight, ChessPieceColorType::White };
-    constexpr auto KnightBlack = ChessPiece{ ChessPieceType::Knight, ChessPieceColorType::Black };
-    constexpr auto PawnWhite = ChessPiece{ ChessPieceType::Pawn, ChessPieceColorType::White };
-    constexpr auto PawnBlack = ChessPiece{ ChessPieceType::Pawn, ChessPieceColorType::Black };
-    constexpr auto KingWhite = ChessPiece{ ChessPieceType::King, ChessPieceColorType::White };
-    constexpr auto KingBlack = ChessPiece{ ChessPieceType::King, ChessPieceColorType::Black };
-}
-
-static constexpr u32 BoardSquareSize = 8;
-static constexpr u32 BoardSquarePixelSize = 80;
-static constexpr usize BoardSquareCount = BoardSquareSize * BoardSquareSize;
+static const auto PositionIndexPath = std::filesystem::path{ "./Assets/Archive/Games.idx" };
 
 static Vector2u mapCursorPositionToGridIndex(Vector2u position) {
     const auto row = std::clamp(position.x / BoardSquarePixelSize, 0u, BoardSquareSize - 1);
@@ -99,155 +76,17 @@ static Vector2u mapArrayIndexToGridIndex(usize index) {
     return{ row, column };
 }
 
-static Vector2f mapGridIndexToPosition(Vector2u grid) {
-    return { grid.x * BoardSquarePixelSize, grid.y * BoardSquarePixelSize };
-}
-
-static Vector2f mapArrayIndexToPosition(usize index) {
-    const auto gridIndex = mapArrayIndexToGridIndex(index);
-    return mapGridIndexToPosition(gridIndex);
-}
-
 static usize mapGridIndexToArrayIndex(Vector2u grid) {
     return static_cast<usize>(grid.y) * BoardSquareSize + grid.x;
 }
 
-enum class DirectionType {
-    Up,
-    Down,
-    Left,
-    Right,
-
-    UpLeft,
-    UpRight,
-    DownRight,
-    DownLeft,
-
-    Count
-};
-
-enum class KnightDirectionType {
-    UpRightRight,
-    UpRightUp,
-    UpLeftLeft,
-    UpLeftUp,
-
-    DownRightRight,
-    DownRightDown,
-    DownLeftLeft,
-    DownLeftDown,
-
-    Count
-};
-
-static bool isDirectionAvailableForChessPieceType(DirectionType directionType, ChessPieceType chessPieceType) {
-    using enum DirectionType;
-    using enum ChessPieceType;
-
-    switch (chessPieceType) {
-    case Queen:
-        return true;
-    case Bishop:
-        return directionType == UpLeft 
-            || directionType == UpRight 
-            || directionType == DownRight 
-            || directionType == DownLeft;
-    case Rook:
-        return directionType == Left
-            || directionType == Right
-            || directionType == Up
-            || directionType == Down;
-    default:
-        throw std::runtime_error("Unexpected input");
-    }
-}
-
-static int mapDirectionTypeToArrayIndexOffset(DirectionType type) {
-    using enum DirectionType;
-
-    switch (type) {
-    case Up:
-        return -8;
-    case UpRight:
-        return -7;
-    case UpLeft:
-        return -9;
-    case Down:
-        return 8;
-    case DownRight:
-        return 9;
-    case DownLeft:
-        return 7;
-    case Left:
-        return -1;
-    case Right:
-        return 1;
-    default:
-        throw std::runtime_error("Uhandled direction");
-    }
-}
-
-static int mapKnightDirectionTypeToArrayIndexOffset(KnightDirectionType type) {
-    using enum KnightDirectionType;
-
-    switch (type) {
-    case UpRightRight:
-        return -6;
-    case UpRightUp:
-        return -15;
-    case UpLeftLeft:
-        return -10;
-    case UpLeftUp:
-        return -17;
-    case DownRightRight:
-        return 10;
-    case DownRightDown:
-        return 17;
-    case DownLeftLeft:
-        return 6;
-    case DownLeftDown:
-        return 15;
-    default:
-        throw std::runtime_error("Uhandled direction");
-    }
+static Vector2f mapGridIndexToPosition(Vector2u grid) {
+    return { grid.x * BoardSquarePixelSize, grid.y * BoardSquarePixelSize };
 }
 
-static usize mapArrayIndexToSquaresToEdge(usize index, DirectionType type) {
+static Vector2f mapArrayIndexToPosition(usize index) {
     const auto gridIndex = mapArrayIndexToGridIndex(index);
-  
-    const auto squaresUp = static_cast<usize>(gridIndex.y);
-    const auto squaresDown = static_cast<usize>(BoardSquareSize) - 1 - gridIndex.y;
-    const auto squaresLeft = static_cast<usize>(gridIndex.x);
-    const auto squaresRight = static_cast<usize>(BoardSquareSize) - 1 - gridIndex.x;
-
-    const auto squaresUpLeft = std::min(squaresLeft, squaresUp);
-    const auto squaresUpRight = std::min(squaresRight, squaresUp);
-
-    const auto squaresDownLeft = std::min(squaresLeft, squaresDown);
-    const auto squaresDownRight = std::min(squaresRight, squaresDown);
-
-    using enum DirectionType;
-
-    switch (type) {
-    case Up:
-        return squaresUp;
-    case UpRight:
-        return squaresUpRight;
-    case UpLeft:
-        return squaresUpLeft;
-    case Down:
-        return squaresDown;
-    case DownRight:
-        return squaresDownRight;
-    case DownLeft:
-        return squaresDownLeft;
-    case Left:
-        return squaresLeft;
-    case Right:
-        return squaresRight;
-    default:
-        throw std::runtime_error("Uhandled direction");
-    }
+    return mapGridIndexToPosition(gridIndex);
 }
 
 static ChessPiece mapFileNameToChessPiece(std::string_view name) {
@@ -282,266 +121,122 @@ static ChessPiece mapFileNameToChessPiece(std::string_view name) {
     }
 }
 
-struct ChessMove {
-    usize startingSquareIndex{};
-    usize targetSquareIndex{};
-    bool isCastling{};
-    bool isEnPassant{};
-    bool isDoubleMovement{};
-};
-
-using ChessBoard = std::array<ChessPiece, BoardSquareCount>;
-
-class PossibleChessMoveGenerator {
+// Runs a function on a worker thread and hands its result to onUpdate, which polls for it. Starting the task again,
+// cancelling it or destroying it requests a stop through the function's stop token and waits for the thread.
+template <typename T>
+class BackgroundTask {
 public:
-    PossibleChessMoveGenerator(const ChessBoard& state, ChessPieceColorType color)
-        : _state(state), _color(color) {
-    }
+    void start(std::function<T(std::stop_token)> function) {
+        cancel();
 
-    std::vector<ChessMove> computeAvailableMoves() {
-        for (auto startingSquareIndex = 0; startingSquareIndex < BoardSquareCount; startingSquareIndex++) {
-            auto piece = _state[startingSquareIndex];
-
-            if (piece.color != _color) {
-                continue;
-            }
-
-            if (isSlidingPiece(piece.type)) {
-                _computeSlidingPieceMoves(startingSquareIndex, piece);
-            } else if (piece.type == ChessPieceType::Pawn) {
-                _computePawnMoves(startingSquareIndex, piece);
-            } else if (piece.type == ChessPieceType::King) {
-                _computeKingMoves(startingSquareIndex, piece);
-            } else if (piece.type == ChessPieceType::Knight) {
-                _computeKnightMoves(startingSquareIndex);
-            }
-        }
-
-        return _moves;
+        _isFinished.store(false, std::memory_order_relaxed);
+        _thread = std::jthread{ [this, function = std::move(function)](std::stop_token stopToken) {
+            _result = function(stopToken);
+            _isFinished.store(true, std::memory_order_release);
+        } };
     }
-private:
-    void _computeKnightMoves(i32 startingIndex) {
-        const auto directionCount = static_cast<usize>(KnightDirectionType::Count);
-        for (auto directionIndex = 0; directionIndex < directionCount; directionIndex++) {
-            const auto direction = static_cast<KnightDirectionType>(directionIndex);
-
-            const auto directionOffset = mapKnightDirectionTypeToArrayIndexOffset(direction);
-            const auto directionSquareIndex = startingIndex + directionOffset;
-
-            if (!_isKnightDirectionAvailable(startingIndex, direction)) {
-                continue;
-            }
 
-            const auto pieceIndex = static_cast<usize>(directionSquareIndex);
-            const auto& piece = _state[pieceIndex];
-
-            if (piece.color != _color) {
-                _moves.emplace_back(startingIndex, static_cast<usize>(pieceIndex));
-            }
+    // Returns the result once, after the function has returned.
+    std::optional<T> poll() {
+        if (!_thread.joinable() || !_isFinished.load(std::memory_order_acquire)) {
+            return std::nullopt;
         }
-    }
 
-    bool _isKnightDirectionAvailable(i32 startingIndex, KnightDirectionType direction) {
-        const auto leftSquareCount = mapArrayIndexToSquaresToEdge(startingIndex, DirectionType::Left);
-        const auto rightSquareCount = mapArrayIndexToSquaresToEdge(startingIndex, DirectionType::Right);
-        const auto upSquareCount = mapArrayIndexToSquaresToEdge(startingIndex, DirectionType::Up);
-        const auto downSquareCount = mapArrayIndexToSquaresToEdge(startingIndex, DirectionType::Down);
-
-        switch (direction) {
-        case KnightDirectionType::UpRightRight:
-            return upSquareCount >= 1 && rightSquareCount >= 2;
-        case KnightDirectionType::UpRightUp:
-            return upSquareCount >= 2 && rightSquareCount >= 1;
-        case KnightDirectionType::UpLeftLeft:
-            return upSquareCount >= 1 && leftSquareCount >= 2;
-        case KnightDirectionType::UpLeftUp:
-            return upSquareCount >= 2 && leftSquareCount >= 1;
-        case KnightDirectionType::DownRightRight:
-            return downSquareCount >= 1 && rightSquareCount >= 2;
-        case KnightDirectionType::DownRightDown:
-            return downSquareCount >= 2 && rightSquareCount >= 1;
-        case KnightDirectionType::DownLeftLeft:
-            return downSquareCount >= 1 && leftSquareCount >= 2;
-        case KnightDirectionType::DownLeftDown:
-            return downSquareCount >= 2 && leftSquareCount >= 1;
-        }
+        _thread.join();
+        return std::move(_result);
     }
 
-    void _computeKingMoves(i32 startingIndex, ChessPiece piece) {
-        const auto directionCount = static_cast<usize>(DirectionType::Count);
-        for (auto directionIndex = 0; directionIndex < directionCount; directionIndex++) {
-            const auto direction = static_cast<DirectionType>(directionIndex);
-
-            const auto squareCountInDirection = mapArrayIndexToSquaresToEdge(startingIndex, direction);
-            if (squareCountInDirection == 0) {
-                continue;
-            }
-
-            const auto directionArrayIndexOffset = mapDirectionTypeToArrayIndexOffset(direction);
-
-            const auto targetSquareIndex = directionArrayIndexOffset + startingIndex;
-            const auto targetSquare = _state[targetSquareIndex];
-
-            if (targetSquare.color != _color) {
-                _moves.emplace_back(startingIndex, targetSquareIndex);
-            }
-        }
-
-        if (!piece.hasMoved) {
-            _computeKingCastleInDirection(startingIndex, DirectionType::Left);
-            _computeKingCastleInDirection(startingIndex, DirectionType::Right);
+    void cancel() {
+        if (_thread.joinable()) {
+            _thread.request_stop();
+            _thread.join();
         }
     }
+private:
+    T _result{};
+    std::atomic<bool> _isFinished{};
+    std::jthread _thread{};
+};
 
-    void _computeKingCastleInDirection(i32 startingIndex, DirectionType direction) {
-        const auto directionArrayIndexOffset = mapDirectionTypeToArrayIndexOffset(direction);
-        const auto squareCountInDirection = mapArrayIndexToSquaresToEdge(startingIndex, direction);
-
-        for (auto directionSquareIndex = 1; directionSquareIndex <= squareCountInDirection; directionSquareIndex++) {
-            const auto targetSquareIndex = directionSquareIndex * directionArrayIndexOffset + startingIndex;
-            const auto targetSquare = _state[targetSquareIndex];
+class ChessGame {
+public:
+    explicit ChessGame(const Position& startingPosition) : _startingPosition(startingPosition) {}
 
-            if (targetSquare.type == ChessPieceType::Rook && targetSquare.color == _color && !targetSquare.hasMoved) {
-                _moves.emplace_back(startingIndex, 2 * directionArrayIndexOffset + startingIndex, true);
-                break;
-            } 
+    void onSetup(Window& window) {
+        const auto size = BoardSquarePixelSize * BoardSquareSize;
 
-            if (targetSquare != ChessPieces::None) {
-                break;
-            }
-        }
+        window.setFramebufferSize(size, size);
+        window.setResizeable(false);
+        window.setTitle("Chess Game");
+        window.show();
     }
 
-    void _computePawnMoves(i32 startingIndex, ChessPiece piece) {
-        using enum ChessPieceColorType;
-        using enum DirectionType;
-
-        const auto pawnVerticalDirection = piece.color == Black ? Down : Up;
-        const auto pawnDiagonalLeftDirection = piece.color == Black ? DownLeft : UpLeft;
-        const auto pawnDiagonalRightDirection = piece.color == Black ? DownRight : UpRight;
+    void onResourceLoad(GraphicsDevice& device) {
+        _loadChessPieceSprites(device);
+        _loadStaticSprites(device);
+        _loadOpeningBook();
+        _loadTablebase();
+        _loadPositionIndex();
 
-        _computePawnVerticalMoves(startingIndex, piece.hasMoved, pawnVerticalDirection);
-        _computePawnDiagonalMoves(startingIndex, pawnDiagonalLeftDirection);
-        _computePawnDiagonalMoves(startingIndex, pawnDiagonalRightDirection);
-        _computePawnEnPassantInDirection(startingIndex, piece, DirectionType::Left);
-        _computePawnEnPassantInDirection(startingIndex, piece, DirectionType::Right);
+        _resetGameState();
     }
 
-    void _computePawnEnPassantInDirection(i32 startingIndex, ChessPiece piece, DirectionType direction) {
-        using enum ChessPieceColorType;
-        using enum DirectionType;
-
-        const auto squareCountInDirection = mapArrayIndexToSquaresToEdge(startingIndex, direction);
-        const auto directionArrayIndexOffset = mapDirectionTypeToArrayIndexOffset(direction);
-
-        if (squareCountInDirection == 0) {
-            return;
+    void onUpdate(Window& window) {
+        if (window.isKeyPressed(KeyboardKeyType::Esc)) {
+            _resetGameState();
         }
 
-        const auto targetSquareIndex = directionArrayIndexOffset + startingIndex;
-        const auto targetSquare = _state[targetSquareIndex];
-
-        if (targetSquare.isEnPassantable) {
-            const auto pawnVerticalDirection = piece.color == Black ? Down : Up;
-            const auto pawnVerticalDirectionOffset = mapDirectionTypeToArrayIndexOffset(pawnVerticalDirection);
-            _moves.emplace_back(startingIndex, targetSquareIndex + pawnVerticalDirectionOffset, false, true);
+        const auto isEngineMoveKeyPressed = window.isKeyPressed(KeyboardKeyType::Space);
+        if (isEngineMoveKeyPressed && !_wasEngineMoveKeyPressed) {
+            _playEngineMove();
         }
-    }
 
-    void _computePawnVerticalMoves(i32 startingIndex, bool hasMoved, DirectionType direction) {
-        const auto maximumPawnMoveCount = hasMoved ? 1ull : 2ull;
+        _wasEngineMoveKeyPressed = isEngineMoveKeyPressed;
 
-        const auto squareCountInDirection = mapArrayIndexToSquaresToEdge(startingIndex, direction);
-        const auto directionArrayIndexOffset = mapDirectionTypeToArrayIndexOffset(direction);
-
-        const auto maximumDirectionSquareIndex = std::min(maximumPawnMoveCount, squareCountInDirection);
-
-        for (auto directionSquareIndex = 1; directionSquareIndex <= maximumDirectionSquareIndex; directionSquareIndex++) {
-            const auto targetSquareIndex = directionSquareIndex * directionArrayIndexOffset + startingIndex;
-            const auto targetSquare = _state[targetSquareIndex];
-
-            if (targetSquare != ChessPieces::None) {
-                break;
-            }
-
-            bool isDoubleMovement = directionSquareIndex == 2ull;
-            _moves.emplace_back(startingIndex, targetSquareIndex, false, false, isDoubleMovement);
+        if (const auto result = _engineMoveTask.poll(); result && result->bestMove) {
+            _playMove(*result->bestMove);
         }
-    }
-
-    void _computePawnDiagonalMoves(i32 startingIndex, DirectionType direction) {
-        const auto squareCountInDirection = mapArrayIndexToSquaresToEdge(startingIndex, direction);
 
-        if (squareCountInDirection == 0) {
-            return;
+        const auto isReviewKeyPressed = window.isKeyPressed(KeyboardKeyType::R);
+        if (isReviewKeyPressed && !_wasReviewKeyPressed) {
+            _reviewGame();
         }
 
-        const auto directionArrayIndexOffset = mapDirectionTypeToArrayIndexOffset(direction);
-
-        const auto targetSquareIndex = directionArrayIndexOffset + startingIndex;
-        const auto targetSquare = _state[targetSquareIndex];
+        _wasReviewKeyPressed = isReviewKeyPressed;
 
-        if (targetSquare.color == mapColorToOpposite(_color)) {
-            _moves.emplace_back(startingIndex, targetSquareIndex);
+        if (const auto reviewedMoves = _reviewTask.poll()) {
+            _printReview(*reviewedMoves);
         }
-    }
-
-    void _computeSlidingPieceMoves(i32 startingIndex, ChessPiece piece) {
-        const auto directionCount = static_cast<usize>(DirectionType::Count);
-        for (auto directionIndex = 0; directionIndex < directionCount; directionIndex++) {
-            const auto direction = static_cast<DirectionType>(directionIndex);
-
-            if (!isDirectionAvailableForChessPieceType(direction, piece.type)) {
-                continue;
-            }
 
-            const auto squaresInDirection = mapArrayIndexToSquaresToEdge(startingIndex, direction);
-            for (auto directionSquareIndex = 1; directionSquareIndex <= squaresInDirection; directionSquareIndex++) {
-                const auto targetSquareIndex = directionSquareIndex * mapDirectionTypeToArrayIndexOffset(direction) + startingIndex;
-                const auto targetSquare = _state[targetSquareIndex];
-
-                if (targetSquare.color == _color) {
-                    break;
-                }
-
-                _moves.emplace_back(startingIndex, targetSquareIndex);
-
-                if (targetSquare.color == mapColorToOpposite(_color)) {
-                    break;
-                }
-            }
+        const auto isAnalysisKeyPressed = window.isKeyPressed(KeyboardKeyType::A);
+        if (isAnalysisKeyPressed && !_wasAnalysisKeyPressed) {
+            _analyzePosition();
         }
-    }
-private:
-    ChessBoard _state{};
-    ChessPieceColorType _color{};
 
-    std::vector<ChessMove> _moves{};
-};
+        _wasAnalysisKeyPressed = isAnalysisKeyPressed;
 
-class ChessGame {
-public:
-    void onSetup(Window& window) {
-        const auto size = BoardSquarePixelSize * BoardSquareSize;
+        if (const auto result = _takePendingAnalysis()) {
+            _showAnalysis(*result);
+        }
 
-        window.setFramebufferSize(size, size);
-        window.setResizeable(false);
-        window.setTitle("Chess Game");
-        window.show();
-    }
+        if (const auto result = _analysisTask.poll()) {
+            _showAnalysis(*result);
+        }
 
-    void onResourceLoad(GraphicsDevice& device) {
-        _playerColorTurn = ChessPieceColorType::White;
+        const auto isMateKeyPressed = window.isKeyPressed(KeyboardKeyType::M);
+        if (isMateKeyPressed && !_wasMateKeyPressed) {
+            _solveMate();
+        }
 
-        _loadChessPieceSprites(device);
-        _loadStaticSprites(device);
+        _wasMateKeyPressed = isMateKeyPressed;
 
-        _resetGameState();
-    }
+        if (const auto result = _mateTask.poll()) {
+            _showMateResult(*result);
+        }
 
-    void onUpdate(Window& window) {
-        if (window.isKeyPressed(KeyboardKeyType::Esc)) {
-            _resetGameState();
+        if (_isWindowTitleOutdated) {
+            window.setTitle(_computeWindowTitle());
+            _isWindowTitleOutdated = false;
         }
 
         _cursorPosition = window.getCursorPosition();
@@ -551,87 +246,25 @@ public:
                 const auto gridIndex = mapCursorPositionToGridIndex(_cursorPosition);
                 const auto pieceIndex = mapGridIndexToArrayIndex(gridIndex);
 
-                auto& piece = _pieces[pieceIndex];
+                const auto piece = _position.getPiece(pieceIndex);
                 if (piece != ChessPieces::None) {
                     _movingPieceOriginalIndex = pieceIndex;
                     _movingPiece = piece;
 
                     _selectedPieceGridIndex = mapCursorPositionToGridIndex(_cursorPosition);
                     _selectedPiece = piece;
-
-                    piece = ChessPieces::None;
                 }
             } else if (event.is<MouseButtonReleaseEvent>() && _movingPiece != ChessPieces::None) {
                 if (_movingPiece != ChessPieces::None) {
                     const auto cursorGridIndex = mapCursorPositionToGridIndex(_cursorPosition);
                     const auto cursorPieceIndex = mapGridIndexToArrayIndex(cursorGridIndex);
 
-                    const auto isDropValid = [cursorPieceIndex](const ChessMove& move) { return move.targetSquareIndex == cursorPieceIndex; };
-
-                    auto movesForSelectedPiece = _getMovesForSelectedPiece();
-                    auto move = std::ranges::find_if(movesForSelectedPiece, isDropValid);
-
-                    if (move != movesForSelectedPiece.cend()) {
-                        auto& cursorPiece = _pieces[cursorPieceIndex];
-
-                        _selectedPiece = ChessPieces::None;
-                        _isDeselectPossible = false;
-                        _isKingUnderCheck = false;
-
-                        cursorPiece = _movingPiece;
-                        cursorPiece.hasMoved = true;
-
-                        bool isPawnPromotionPossible = cursorGridIndex.y == 0 || cursorGridIndex.y == BoardSquareSize - 1;
-                        if (_movingPiece.type == ChessPieceType::Pawn && isPawnPromotionPossible) {
-                            cursorPiece.type = ChessPieceType::Queen;
-                        }
-
-                        if (move->isCastling) {
-                            const auto castlingDirection = _mapTargetIndexToCastlingDirection(move->targetSquareIndex);
-                            const auto rookPieceIndex = _findCastlingRookInDirection(move->startingSquareIndex, castlingDirection);
-                            const auto offset = mapDirectionTypeToArrayIndexOffset(castlingDirection);
-
-                            _pieces[cursorPieceIndex - offset] = _pieces[rookPieceIndex];
-                            _pieces[cursorPieceIndex - offset].hasMoved = true;
-                            _pieces[rookPieceIndex] = ChessPieces::None;
-                        }
-
-                        if (move->isDoubleMovement) {
-                            using enum DirectionType;
-
-                            bool isPawnToTheLeft = _isPawnInDirection(cursorPieceIndex, Left);
-                            bool isPawnToTheRight = _isPawnInDirection(cursorPieceIndex, Right);
-
-                            cursorPiece.isEnPassantable = isPawnToTheLeft || isPawnToTheRight;
-                        }
-
-                        if (move->isEnPassant) {
-                            using enum ChessPieceColorType;
-                            using enum DirectionType;
-
-                            const auto enPassantCaptureDirection = _playerColorTurn == Black ? Up : Down;
-                            const auto offset = mapDirectionTypeToArrayIndexOffset(enPassantCaptureDirection);
-
-                            _pieces[cursorPieceIndex + offset] = ChessPieces::None;
-                        }
-
-                        _isKingUnderCheck = _computeKingUnderCheck();
-                        _movesHistory.push_back(*move);
-                        _playerColorTurn = mapColorToOpposite(_playerColorTurn);
-
-                        _computeAvailableMoves();
-
-                        if (_isKingUnderCheck && _legalMoves.empty()) {
-                            _isKingUnderMate = true;
-                        } else if (_legalMoves.empty()) {
-                            _isKingUnderDraw = true;
-                        }
+                    if (_isLegalMoveTarget(_movingPieceOriginalIndex, cursorPieceIndex)) {
+                        _playMove(_findLegalMove(_movingPieceOriginalIndex, cursorPieceIndex));
                     } else if (cursorPieceIndex == _movingPieceOriginalIndex && _isDeselectPossible) {
                         _selectedPiece = ChessPieces::None;
-                        _pieces[_movingPieceOriginalIndex] = _movingPiece;
                         _isDeselectPossible = false;
                     } else {
-                        _pieces[_movingPieceOriginalIndex] = _movingPiece;
                         _isDeselectPossible = true;
                     }
 
@@ -642,18 +275,19 @@ public:
     }
 
     void onDraw(Scene& scene) {
-        for (auto index = 0; index < _pieces.size(); index++) {
+        for (auto index = 0ull; index < BoardSquareCount; index++) {
             const auto gridIndex = mapArrayIndexToGridIndex(index);
             const auto position = mapGridIndexToPosition(gridIndex);
 
-            const auto piece = _pieces[index];
+            const auto piece = _position.getPiece(index);
+            const auto isPieceMoving = _movingPiece != ChessPieces::None && index == _movingPieceOriginalIndex;
 
             auto gridSprite = _getBoardSquareSprite(gridIndex, piece);
             gridSprite.position = position;
 
             scene.sprites.push_back(gridSprite);
 
-            if (piece != ChessPieces::None) {
+            if (piece != ChessPieces::None && !isPieceMoving) {
                 auto pieceSprite = _chessPieceSprites[piece];
                 pieceSprite.position = position;
 
@@ -700,13 +334,28 @@ public:
             scene.sprites.push_back(moveTargetSquareSprite);
         }
 
+        // The best line is drawn last, so it stays on top where lines share a square.
+        for (auto lineIndex = _analysisLines.size(); lineIndex > 0; lineIndex--) {
+            const auto& move = _analysisLines[lineIndex - 1].principalVariation[0];
+
+            for (const auto squareIndex : { move.startingSquareIndex, move.targetSquareIndex }) {
+                auto analysisSprite = _analysisSprites[lineIndex - 1];
+                analysisSprite.position = mapArrayIndexToPosition(squareIndex);
+
+                scene.sprites.push_back(analysisSprite);
+            }
+        }
+
         if (_selectedPiece != ChessPieces::None) {
-            for (const ChessMove& move : _getMovesForSelectedPiece()) {
-                const auto highlightGridIndex = mapArrayIndexToGridIndex(move.targetSquareIndex);
+            // One bit per target square, so the four promotions of a pawn share one highlight.
+            for (auto targets = _legalMoveTargets[mapGridIndexToArrayIndex(_selectedPieceGridIndex)]; targets != 0; targets &= targets - 1) {
+                const auto targetSquareIndex = static_cast<usize>(std::countr_zero(targets));
+
+                const auto highlightGridIndex = mapArrayIndexToGridIndex(targetSquareIndex);
                 const auto highlightPosition = mapGridIndexToPosition(highlightGridIndex);
 
-                auto& targetPiece = _pieces[move.targetSquareIndex];
-                if (targetPiece.color == mapColorToOpposite(_playerColorTurn)) {
+                const auto targetPiece = _position.getPiece(targetSquareIndex);
+                if (targetPiece.color == mapColorToOpposite(_position.getSideToMove())) {
                     auto highlightCaptureSprite = _highlightCaptureSprite;
                     highlightCaptureSprite.position = highlightPosition;
                     scene.sprites.push_back(highlightCaptureSprite);
@@ -730,28 +379,27 @@ private:
         _selectedPieceGridIndex = {};
 
         _isDeselectPossible = false;
-        _isKingUnderCheck = false;
-        _isKingUnderMate = false;
-        _isKingUnderDraw = false;
 
         _movingPiece = ChessPieces::None;
         _movingPieceOriginalIndex = 0;
 
-        _playerColorTurn = ChessPieceColorType::White;
-
-        _legalMoves.clear();
-        _availableMoves.clear();
         _movesHistory.clear();
+        _keyHistory.clear();
+        _engineMoveTask.cancel();
+        _reviewTask.cancel();
+        _reviewSummary.clear();
+        _cancelAnalysis();
+        _mateTask.cancel();
+        _mateSummary.clear();
 
-        _pieces = {};
-
-        _generateStartingPositions();
-        _computeAvailableMoves();
+        _position = _startingPosition;
+        _legalMoveTracker.reset(_position);
+        _computeGameState();
     }
 
     Sprite _getBoardSquareSprite(const Vector2u& gridIndex, ChessPiece piece) const {
         const auto isLightSquare = (gridIndex.x + gridIndex.y) % 2 != 0;
-        const auto isPlayerKing = piece.type == ChessPieceType::King && piece.color == _playerColorTurn;
+        const auto isPlayerKing = piece.type == ChessPieceType::King && piece.color == _position.getSideToMove();
 
         if (_isKingUnderCheck && !_isKingUnderMate && isPlayerKing) {
            return _kingUnderCheckSprite;
@@ -766,114 +414,275 @@ private:
         }
     }
 
-    DirectionType _mapTargetIndexToCastlingDirection(usize targetIndex) {
-        if (targetIndex > 60 || (targetIndex > 4 && targetIndex < 7)) {
-            return DirectionType::Right;
-        } else {
-            return DirectionType::Left;
-        }
+    bool _isLegalMoveTarget(usize startingSquareIndex, usize targetSquareIndex) const {
+        return (_legalMoveTargets[startingSquareIndex] >> targetSquareIndex & 1) != 0;
     }
 
-    usize _findCastlingRookInDirection(i32 startingIndex, DirectionType direction) {
-        const auto directionArrayIndexOffset = mapDirectionTypeToArrayIndexOffset(direction);
-        const auto squareCountInDirection = mapArrayIndexToSquaresToEdge(startingIndex, direction);
+    // Only called for a legal target; a promotion is to the queen, which the move generator lists first.
+    ChessMove _findLegalMove(usize startingSquareIndex, usize targetSquareIndex) const {
+        return *std::ranges::find_if(_legalMoves, [startingSquareIndex, targetSquareIndex](const ChessMove& move) {
+            return move.startingSquareIndex == startingSquareIndex && move.targetSquareIndex == targetSquareIndex;
+        });
+    }
+
+    void _playMove(const ChessMove& move) {
+        _selectedPiece = ChessPieces::None;
+        _isDeselectPossible = false;
 
-        for (auto directionSquareIndex = 1; directionSquareIndex <= squareCountInDirection; directionSquareIndex++) {
-            const auto targetSquareIndex = directionSquareIndex * directionArrayIndexOffset + startingIndex;
-            const auto targetSquare = _pieces[targetSquareIndex];
+        _keyHistory.push_back(_position.getKey());
+        _position.makeMove(move);
+        _legalMoveTracker.update(_position);
+        _movesHistory.push_back(move);
+        _engineMoveTask.cancel();
+        _reviewTask.cancel();
+        _reviewSummary.clear();
+        _cancelAnalysis();
+        _mateTask.cancel();
+        _mateSummary.clear();
 
-            if (targetSquare.type == ChessPieceType::Rook) {
-                return targetSquareIndex;
+        _computeGameState();
+    }
+
+    // Plays a book move at once when the book has the position, otherwise searches it on a worker thread and plays
+    // the best move when the search ends.
+    void _playEngineMove() {
+        if (_legalMoves.empty() || _movingPiece != ChessPieces::None) {
+            return;
+        }
+
+        if (_openingBook) {
+            if (const auto move = _openingBook->pickMove(_position, _random())) {
+                _playMove(*move);
+                return;
             }
         }
+
+        _engineMoveTask.start([position = _position, keys = _keyHistory](std::stop_token stopToken) {
+            auto transpositionTable = TranspositionTable{ EngineHashSize };
+            auto searcher = Searcher{ transpositionTable };
+
+            const auto stopCallback = std::stop_callback{ stopToken, [&searcher] { searcher.stop(); } };
+
+            auto limits = SearchLimits{};
+            limits.time = EngineMoveTime;
+
+            return searcher.search(position, limits, keys, [&searcher, &stopToken](const SearchResult&) {
+                if (stopToken.stop_requested()) {
+                    searcher.stop();
+                }
+            });
+        });
     }
 
-    bool _isPawnInDirection(i32 startingIndex, DirectionType direction) {
-        const auto directionArrayIndexOffset = mapDirectionTypeToArrayIndexOffset(direction);
-        const auto squareCountInDirection = mapArrayIndexToSquaresToEdge(startingIndex, direction);
+    // Searches every position of the game on a worker thread, playing a move or resetting the board cancels it.
+    void _reviewGame() {
+        if (_movesHistory.empty() || _movingPiece != ChessPieces::None) {
+            return;
+        }
 
-        if (squareCountInDirection == 0) {
-            return false;
+        const auto settings = ReviewSettings{ ReviewSearchDepth, std::max(std::thread::hardware_concurrency(), 1u) };
+
+        _reviewTask.start([startingPosition = _startingPosition, moves = _movesHistory, settings](std::stop_token stopToken) {
+            return reviewGame(startingPosition, moves, settings, stopToken);
+        });
+
+        _reviewSummary = "Review: searching";
+        _isWindowTitleOutdated = true;
+    }
+
+    // Prints every move with its classification and keeps a summary for the window title.
+    void _printReview(std::span<const ReviewedMove> reviewedMoves) {
+        auto classificationCounts = std::array<usize, MoveClassificationTypeCount>{};
+        auto position = _startingPosition;
+
+        for (const auto& reviewedMove : reviewedMoves) {
+            auto playedBuffer = SanBuffer{};
+            auto bestBuffer = SanBuffer{};
+
+            const auto playedSan = writeSan(position, reviewedMove.move, playedBuffer);
+            const auto bestSan = writeSan(position, reviewedMove.bestMove, bestBuffer);
+
+            std::println("{:>3}{} {:<8} {:<10} {:>6} best {:<8} {:>6}", position.getFullmoveNumber(), position.getSideToMove() == ChessPieceColorType::White ? ". " : "...",
+                playedSan, mapMoveClassificationTypeToString(reviewedMove.classification), reviewedMove.playedScore, bestSan, reviewedMove.bestScore);
+
+            classificationCounts[static_cast<usize>(reviewedMove.classification)]++;
+            position.makeMove(reviewedMove.move);
         }
 
-        const auto targetSquareIndex = directionArrayIndexOffset + startingIndex;
-        const auto targetSquare = _pieces[targetSquareIndex];
+        using enum MoveClassificationType;
 
-        return targetSquare.type == ChessPieceType::Pawn && targetSquare.color == mapColorToOpposite(_playerColorTurn);
+        _reviewSummary = std::format("Review: {} inaccuracies, {} mistakes, {} blunders", classificationCounts[static_cast<usize>(Inaccuracy)],
+            classificationCounts[static_cast<usize>(Mistake)], classificationCounts[static_cast<usize>(Blunder)]);
+        _isWindowTitleOutdated = true;
     }
 
-    void _generateStartingPositions() {
-        _pieces[0] = ChessPieces::RookBlack;
-        _pieces[1] = ChessPieces::KnightBlack;
-        _pieces[2] = ChessPieces::BishopBlack;
-        _pieces[3] = ChessPieces::QueenBlack;
-        _pieces[4] = ChessPieces::KingBlack;
-        _pieces[5] = ChessPieces::BishopBlack;
-        _pieces[6] = ChessPieces::KnightBlack;
-        _pieces[7] = ChessPieces::RookBlack;
-
-        _pieces[56] = ChessPieces::RookWhite;
-        _pieces[57] = ChessPieces::KnightWhite;
-        _pieces[58] = ChessPieces::BishopWhite;
-        _pieces[59] = ChessPieces::QueenWhite;
-        _pieces[60] = ChessPieces::KingWhite;
-        _pieces[61] = ChessPieces::BishopWhite;
-        _pieces[62] = ChessPieces::KnightWhite;
-        _pieces[63] = ChessPieces::RookWhite;
-
-        std::fill(&_pieces[8], &_pieces[16], ChessPieces::PawnBlack);
-        std::fill(&_pieces[48], &_pieces[56], ChessPieces::PawnWhite);
+    // Searches the current position on a worker thread. Every completed iteration is handed to onUpdate, which prints
+    // its lines and highlights their first moves until the next move is played.
+    void _analyzePosition() {
+        if (_legalMoves.empty() || _movingPiece != ChessPieces::None) {
+            return;
+        }
+
+        _cancelAnalysis();
+
+        _analysisTask.start([this, position = _position, keys = _keyHistory](std::stop_token stopToken) {
+            auto transpositionTable = TranspositionTable{ AnalysisHashSize };
+            auto searcher = Searcher{ transpositionTable };
+            searcher.setPrincipalVariationCount(AnalysisLineCount);
+
+            const auto stopCallback = std::stop_callback{ stopToken, [&searcher] { searcher.stop(); } };
+
+            return searcher.search(position, SearchLimits{ AnalysisSearchDepth }, keys, [this, &searcher, &stopToken](const SearchResult& result) {
+                if (stopToken.stop_requested()) {
+                    searcher.stop();
+                    return;
+                }
+
+                const auto lock = std::scoped_lock{ _analysisMutex };
+                _pendingAnalysis = result;
+            });
+        });
     }
 
-    auto _getMovesForSelectedPiece() {
-        const auto selectedPieceArrayIndex = mapGridIndexToArrayIndex(_selectedPieceGridIndex);
-        auto isSelectedPieceMove = [selectedPieceArrayIndex](const ChessMove& move) { 
-            return move.startingSquareIndex == selectedPieceArrayIndex; 
-        };
+    void _cancelAnalysis() {
+        _analysisTask.cancel();
+        _takePendingAnalysis();
 
-        return _legalMoves | std::views::filter(isSelectedPieceMove);
+        _analysisLines.clear();
+        _analysisDepth = 0;
     }
 
-    bool _computeKingUnderCheck() {
-        auto generator = PossibleChessMoveGenerator{ _pieces, _playerColorTurn };
-        const auto possibleMoves = generator.computeAvailableMoves();
+    std::optional<SearchResult> _takePendingAnalysis() {
+        const auto lock = std::scoped_lock{ _analysisMutex };
+        return std::exchange(_pendingAnalysis, std::nullopt);
+    }
 
-        const auto isKingUnderThreat = [this](const ChessMove& move) {
-            const auto piece = _pieces[move.targetSquareIndex];
-            return piece.type == ChessPieceType::King && piece.color == mapColorToOpposite(_playerColorTurn);
-        };
+    // The final result repeats the last iteration, so only deeper results are printed.
+    void _showAnalysis(const SearchResult& result) {
+        if (result.depth <= _analysisDepth) {
+            return;
+        }
+
+        std::println("Depth {}", result.depth);
+
+        for (const auto& line : result.lines) {
+            auto linePosition = _position;
+            auto sanLine = std::string{};
+
+            for (const auto& move : line.principalVariation) {
+                auto buffer = SanBuffer{};
+                sanLine += std::format("{} ", writeSan(linePosition, move, buffer));
+                linePosition.makeMove(move);
+            }
 
-        return std::ranges::any_of(possibleMoves, isKingUnderThreat);
+            std::println("{:>6}  {}", line.score, sanLine);
+        }
+
+        _analysisLines = result.lines;
+        _analysisDepth = result.depth;
     }
 
-    void _computeAvailableMoves() {
+    // Looks for a forced mate by the side to move on a worker thread, playing a move or resetting the board cancels it.
+    void _solveMate() {
+        if (_legalMoves.empty() || _movingPiece != ChessPieces::None) {
+            return;
+        }
+
+        _mateTask.start([position = _position](std::stop_token stopToken) {
+            auto solver = MateSolver{ MateSearchHashSize };
+            const auto stopCallback = std::stop_callback{ stopToken, [&solver] { solver.stop(); } };
+
+            return solver.solve(position, MateSearchLimits{ MateSearchMoveCount, MateSearchNodeCount });
+        });
+
+        _mateSummary = "Mate: searching";
+        _isWindowTitleOutdated = true;
+    }
+
+    // Prints the solution and highlights its first move.
+    void _showMateResult(const MateSearchResult& result) {
+        if (result.type != MateSearchResultType::Mate) {
+            _mateSummary = std::format("Mate: {} in {}", mapMateSearchResultTypeToString(result.type), MateSearchMoveCount);
+            _isWindowTitleOutdated = true;
+            return;
+        }
+
+        auto solutionPosition = _position;
+        auto sanSolution = std::string{};
+
+        for (const auto& move : result.solution) {
+            auto buffer = SanBuffer{};
+            sanSolution += std::format("{} ", writeSan(solutionPosition, move, buffer));
+            solutionPosition.makeMove(move);
+        }
+
+        std::println("Mate in {}: {}", result.moveCount, sanSolution);
+
+        _mateSummary = std::format("Mate in {}", result.moveCount);
+        _analysisLines = { SearchLine{ MateScore - static_cast<i32>(result.solution.size()), result.solution } };
+        _isWindowTitleOutdated = true;
+    }
+
+    void _computeGameState() {
         _legalMoves.clear();
+        _legalMoveTracker.computeLegalMoves(_legalMoves);
 
-        auto generator = PossibleChessMoveGenerator{ _pieces, _playerColorTurn };
-        _availableMoves = generator.computeAvailableMoves();
+        _legalMoveTargets = {};
+
+        for (const auto& move : _legalMoves) {
+            _legalMoveTargets[move.startingSquareIndex] |= 1ull << move.targetSquareIndex;
+        }
 
-        for (const auto& move : _availableMoves) {
-            const auto startingPiece = _pieces[move.startingSquareIndex];
-            const auto targetPiece = _pieces[move.targetSquareIndex];
+        _isKingUnderCheck = _position.isKingUnderCheck();
+        _isKingUnderMate = _isKingUnderCheck && _legalMoves.empty();
+        _isKingUnderDraw = !_isKingUnderCheck && _legalMoves.empty();
+        _isWindowTitleOutdated = true;
+    }
 
-            _pieces[move.startingSquareIndex] = ChessPieces::None;
-            _pieces[move.targetSquareIndex] = startingPiece;
+    std::string _computeWindowTitle() const {
+        auto title = std::string{ "Chess Game" };
 
-            auto generator = PossibleChessMoveGenerator{ _pieces, mapColorToOpposite(_playerColorTurn) };
-            const auto possibleOpponentMoves = generator.computeAvailableMoves();
+        if (_positionIndex) {
+            title += std::format(" - Archive: {} games", _countArchiveGames());
+        }
 
-            const auto isKingCaptured = [this](const ChessMove& move) {
-                const auto piece = _pieces[move.targetSquareIndex];
-                return piece.type == ChessPieceType::King && piece.color == _playerColorTurn;
-            };
+        if (!_reviewSummary.empty()) {
+            title += std::format(" - {}", _reviewSummary);
+        }
 
-            if (!std::ranges::any_of(possibleOpponentMoves, isKingCaptured)) {
-                _legalMoves.push_back(move);
-            }
+        if (!_mateSummary.empty()) {
+            title += std::format(" - {}", _mateSummary);
+        }
+
+        if (!_tablebase) {
+            return title;
+        }
+
+        const auto wdl = _tablebase->probeWdl(_position);
+        if (!wdl) {
+            return title;
+        }
 
-            _pieces[move.startingSquareIndex] = startingPiece;
-            _pieces[move.targetSquareIndex] = targetPiece;
+        if (const auto dtz = _tablebase->probeDtz(_position)) {
+            return std::format("{} - Tablebase: {}, DTZ {}", title, mapSyzygyWdlTypeToString(*wdl), *dtz);
         }
+
+        return std::format("{} - Tablebase: {}", title, mapSyzygyWdlTypeToString(*wdl));
+    }
+
+    // A game that passes through the position more than once is counted once.
+    usize _countArchiveGames() const {
+        const auto entries = _positionIndex->findEntries(_position);
+
+        auto gameCount = 0ull;
+
+        for (auto entryIndex = 0ull; entryIndex < entries.size(); entryIndex++) {
+            if (entryIndex == 0 || entries[entryIndex].gameIndex != entries[entryIndex - 1].gameIndex) {
+                gameCount++;
+            }
+        }
+
+        return gameCount;
     }
 
     void _loadStaticSprites(GraphicsDevice& device) {
@@ -907,6 +716,14 @@ private:
 
         _highlightCaptureSprite.texture = Texture{ device, _generateHighlightCaptureImage(10, Color8{ 92, 92, 92, 90 }) };
         _highlightCaptureSprite.zIndex = 5;
+
+        for (auto lineIndex = 0ull; lineIndex < AnalysisLineCount; lineIndex++) {
+            const auto alpha = static_cast<u8>(170 - lineIndex * 50);
+
+            _analysisSprites[lineIndex].texture = Texture{ device, Image::create(1, 1, Color8{ 66, 135, 245, alpha }) };
+            _analysisSprites[lineIndex].scale = Vector2f{ BoardSquarePixelSize };
+            _analysisSprites[lineIndex].zIndex = 3;
+        }
     }
 
     Image _generateBorderImage(i32 borderWidthPixels, Color8 borderColor) {
@@ -970,6 +787,24 @@ private:
         return higlightImage;
     }
 
+    void _loadOpeningBook() {
+        if (std::filesystem::exists(OpeningBookPath)) {
+            _openingBook.emplace(OpeningBookPath);
+        }
+    }
+
+    void _loadTablebase() {
+        if (IsSyzygyEnabled && std::filesystem::exists(TablebaseDirectoryPath)) {
+            _tablebase.emplace(TablebaseDirectoryPath);
+        }
+    }
+
+    void _loadPositionIndex() {
+        if (std::filesystem::exists(PositionIndexPath)) {
+            _positionIndex.emplace(PositionIndexPath);
+        }
+    }
+
     void _loadChessPieceSprites(GraphicsDevice& device) {
         const auto chessPieceDirectoryPath = std::filesystem::path{ "./Assets/ChessPieces" };
         if (!std::filesystem::exists(chessPieceDirectoryPath)) {
@@ -989,7 +824,32 @@ private:
         }
     }
 
-    std::array<ChessPiece, BoardSquareCount> _pieces{};
+    Position _startingPosition{};
+    Position _position{};
+
+    std::optional<PolyglotBook> _openingBook{};
+    std::mt19937_64 _random{ std::random_device{}() };
+    bool _wasEngineMoveKeyPressed{};
+    BackgroundTask<SearchResult> _engineMoveTask{};
+
+    std::string _reviewSummary{};
+    bool _wasReviewKeyPressed{};
+    BackgroundTask<std::vector<ReviewedMove>> _reviewTask{};
+
+    std::vector<SearchLine> _analysisLines{};
+    u32 _analysisDepth{};
+    bool _wasAnalysisKeyPressed{};
+    std::mutex _analysisMutex{};
+    std::optional<SearchResult> _pendingAnalysis{};
+    BackgroundTask<SearchResult> _analysisTask{};
+
+    std::string _mateSummary{};
+    bool _wasMateKeyPressed{};
+    BackgroundTask<MateSearchResult> _mateTask{};
+
+    std::optional<SyzygyTablebase> _tablebase{};
+    std::optional<PositionIndex> _positionIndex{};
+    bool _isWindowTitleOutdated{};
 
     Sprite _lightSquareSprite{};
     Sprite _darkSquareSprite{};
@@ -1000,6 +860,8 @@ private:
     Sprite _highlightSprite{};
     Sprite _highlightCaptureSprite{};
 
+    std::array<Sprite, AnalysisLineCount> _analysisSprites{};
+
     Sprite _kingUnderCheckSprite{};
     Sprite _kingUnderMateSprite{};
     Sprite _kingUnderDrawSprite{};
@@ -1017,17 +879,21 @@ private:
     ChessPiece _movingPiece{};
     usize _movingPieceOriginalIndex{};
 
-    ChessPieceColorType _playerColorTurn{};
-
     std::map<ChessPiece, Sprite> _chessPieceSprites{};
 
-    std::vector<ChessMove> _legalMoves{};
-    std::vector<ChessMove> _availableMoves{};
+    LegalMoveTracker _legalMoveTracker{};
+    MoveList _legalMoves{};
+    // Target squares of the legal moves as bitmasks indexed by starting square, rebuilt with the move list.
+    std::array<u64, BoardSquareCount> _legalMoveTargets{};
     std::vector<ChessMove> _movesHistory{};
+    // Keys of the positions before each move of the history, for repetition detection in the analysis.
+    std::vector<u64> _keyHistory{};
 };
 
-int main() {
-    auto game = ChessGame{};
+int main(int argc, char** argv) {
+    const auto startingPosition = argc > 1 ? createPositionFromFen(argv[1]) : Position::createStartingPosition();
+
+    auto game = ChessGame{ startingPosition };
 
     auto window = Window{};
     game.onSetup(window);
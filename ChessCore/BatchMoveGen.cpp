@@ -0,0 +1,106 @@
+#include "BatchMoveGen.h"
+#include "BatchMoveGenLanes.h"
+
+#include <stdexcept>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace ChessCore {
+
+    using LaneSummaryFunction = void (*)(std::span<const BitboardPosition, BatchLaneCount>, std::span<BitboardMoveSummary, BatchLaneCount>);
+
+#ifdef CHESSCORE_AVX2_LANES
+    // The processor must have the instructions and the operating system must save the 256-bit registers.
+    static bool isAvx2Supported() {
+#ifdef _MSC_VER
+        auto registers = std::array<int, 4>{};
+
+        __cpuid(registers.data(), 0);
+        if (registers[0] < 7) {
+            return false;
+        }
+
+        __cpuid(registers.data(), 1);
+        const auto isOsxsaveSupported = (registers[2] & 1 << 27) != 0;
+        const auto isAvxSupported = (registers[2] & 1 << 28) != 0;
+
+        if (!isOsxsaveSupported || !isAvxSupported || (_xgetbv(0) & 6) != 6) {
+            return false;
+        }
+
+        __cpuidex(registers.data(), 7, 0);
+        return (registers[1] & 1 << 5) != 0;
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+#endif
+
+    static LaneSummaryFunction selectLaneSummaryFunction() {
+#ifdef CHESSCORE_AVX2_LANES
+        if (isAvx2Supported()) {
+            return computeAvx2LaneSummaries;
+        }
+#endif
+
+        return computeLaneSummaries;
+    }
+
+    static LaneSummaryFunction getLaneSummaryFunction() {
+        static const auto laneSummaryFunction = selectLaneSummaryFunction();
+        return laneSummaryFunction;
+    }
+
+    bool isBatchMoveGenUsingAvx2() {
+        return getLaneSummaryFunction() != computeLaneSummaries;
+    }
+
+    BitboardPosition mapPositionToBitboardPosition(const Position& position) {
+        auto bitboardPosition = BitboardPosition{};
+
+        for (auto squareIndex = 0ull; squareIndex < BoardSquareCount; squareIndex++) {
+            const auto piece = position.getPiece(squareIndex);
+
+            if (piece != ChessPieces::None) {
+                bitboardPosition.pieces[static_cast<usize>(piece.type)] |= 1ull << squareIndex;
+                bitboardPosition.colors[static_cast<usize>(piece.color)] |= 1ull << squareIndex;
+            }
+        }
+
+        bitboardPosition.sideToMove = position.getSideToMove();
+        bitboardPosition.castlingRights = position.getCastlingRights();
+        bitboardPosition.enPassantSquareIndex = position.getEnPassantSquareIndex();
+
+        return bitboardPosition;
+    }
+
+    void computeBitboardMoveSummaries(std::span<const BitboardPosition> positions, std::span<BitboardMoveSummary> summaries) {
+        if (positions.size() != summaries.size()) {
+            throw std::runtime_error("Every position needs a summary");
+        }
+
+        const auto computeSummaries = getLaneSummaryFunction();
+        const auto fullBatchCount = positions.size() / BatchLaneCount;
+
+        for (auto batchIndex = 0ull; batchIndex < fullBatchCount; batchIndex++) {
+            computeSummaries(positions.subspan(batchIndex * BatchLaneCount).first<BatchLaneCount>(),
+                summaries.subspan(batchIndex * BatchLaneCount).first<BatchLaneCount>());
+        }
+
+        const auto remainingCount = positions.size() - fullBatchCount * BatchLaneCount;
+
+        if (remainingCount == 0) {
+            return;
+        }
+
+        // The last lanes are filled with empty boards, which have no moves.
+        auto remainingPositions = std::array<BitboardPosition, BatchLaneCount>{};
+        auto remainingSummaries = std::array<BitboardMoveSummary, BatchLaneCount>{};
+
+        std::ranges::copy(positions.last(remainingCount), remainingPositions.begin());
+        computeSummaries(remainingPositions, remainingSummaries);
+        std::ranges::copy_n(remainingSummaries.begin(), remainingCount, summaries.last(remainingCount).begin());
+    }
+}
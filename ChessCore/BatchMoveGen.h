@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Position.h"
+
+#include <array>
+#include <span>
+
+namespace ChessCore {
+
+    // Bit i is square index i of ChessBoard, so bit 0 is a8 and bit 63 is h1.
+    struct BitboardPosition {
+        std::array<u64, ChessPieceTypeCount> pieces{};
+        std::array<u64, ChessPieceColorTypeCount> colors{};
+        ChessPieceColorType sideToMove = ChessPieceColorType::White;
+        u8 castlingRights{};
+        u8 enPassantSquareIndex = NoSquareIndex;
+    };
+
+    BitboardPosition mapPositionToBitboardPosition(const Position& position);
+
+    // Attacked squares are indexed by the attacking side; the legal move count is the size of computeLegalMoves.
+    struct BitboardMoveSummary {
+        std::array<u64, ChessPieceColorTypeCount> attackedSquares{};
+        u32 legalMoveCount{};
+    };
+
+    inline constexpr usize BatchLaneCount = 4;
+
+    // Summarizes BatchLaneCount positions at a time, one per 64-bit lane: in a 256-bit register on processors with
+    // AVX2, otherwise in loops over four values left to the compiler. Moves are counted per direction from
+    // whole-board shifts and Kogge-Stone fills, so no move list is built; only castling and en passant are checked
+    // one position at a time.
+    void computeBitboardMoveSummaries(std::span<const BitboardPosition> positions, std::span<BitboardMoveSummary> summaries);
+
+    // Whether computeBitboardMoveSummaries runs the copy of its kernel built for AVX2, picked once from the processor.
+    bool isBatchMoveGenUsingAvx2();
+}
@@ -0,0 +1,18 @@
+// Built with AVX2 enabled (/arch:AVX2 or -mavx2), so the lanes of this copy of the kernel are 256-bit registers.
+// BatchMoveGen.cpp only calls it after checking the processor.
+#include "BatchMoveGenLanes.h"
+
+#ifdef CHESSCORE_AVX2_LANES
+
+#ifndef __AVX2__
+#error BatchMoveGenAvx2.cpp must be compiled with AVX2 enabled
+#endif
+
+namespace ChessCore {
+
+    void computeAvx2LaneSummaries(std::span<const BitboardPosition, BatchLaneCount> positions, std::span<BitboardMoveSummary, BatchLaneCount> summaries) {
+        computeLaneSummaries(positions, summaries);
+    }
+}
+
+#endif
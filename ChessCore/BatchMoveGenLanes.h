@@ -0,0 +1,442 @@
+#pragma once
+
+// The lane kernel of BatchMoveGen.cpp. Every translation unit that includes it gets its own copy, built for the
+// instruction set of that file: BatchMoveGen.cpp with the project settings and BatchMoveGenAvx2.cpp with AVX2.
+
+#include "BatchMoveGen.h"
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// Processors that may run the AVX2 build of the kernel, chosen at run time.
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define CHESSCORE_AVX2_LANES
+#endif
+
+namespace ChessCore {
+
+    namespace {
+
+        constexpr u64 FileA = 0x0101010101010101ull;
+        constexpr u64 FileB = FileA << 1;
+        constexpr u64 FileG = FileA << 6;
+        constexpr u64 FileH = FileA << 7;
+
+        constexpr u64 PromotionSquares = 0xFFull | 0xFFull << 56;
+
+        // Squares a single push from the starting rank lands on, the third rank for white and the sixth for black.
+        constexpr u64 WhiteDoublePushSquares = 0xFFull << 40;
+        constexpr u64 BlackDoublePushSquares = 0xFFull << 16;
+
+        // One bitboard per position; the operators work on all lanes at once.
+        class BitboardLanes {
+        public:
+            BitboardLanes() = default;
+
+#ifdef __AVX2__
+            explicit BitboardLanes(u64 value) : _value{ _mm256_set1_epi64x(static_cast<long long>(value)) } {}
+            explicit BitboardLanes(const std::array<u64, BatchLaneCount>& values) : _value{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values.data())) } {}
+
+            std::array<u64, BatchLaneCount> getValues() const {
+                auto values = std::array<u64, BatchLaneCount>{};
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(values.data()), _value);
+                return values;
+            }
+
+            friend BitboardLanes operator&(const BitboardLanes& first, const BitboardLanes& second) { return BitboardLanes{ _mm256_and_si256(first._value, second._value) }; }
+            friend BitboardLanes operator|(const BitboardLanes& first, const BitboardLanes& second) { return BitboardLanes{ _mm256_or_si256(first._value, second._value) }; }
+            friend BitboardLanes operator-(const BitboardLanes& first, const BitboardLanes& second) { return BitboardLanes{ _mm256_sub_epi64(first._value, second._value) }; }
+            friend BitboardLanes operator~(const BitboardLanes& lanes) { return BitboardLanes{ _mm256_xor_si256(lanes._value, _mm256_set1_epi64x(-1)) }; }
+            friend BitboardLanes operator<<(const BitboardLanes& lanes, int shift) { return BitboardLanes{ _mm256_sll_epi64(lanes._value, _mm_cvtsi32_si128(shift)) }; }
+            friend BitboardLanes operator>>(const BitboardLanes& lanes, int shift) { return BitboardLanes{ _mm256_srl_epi64(lanes._value, _mm_cvtsi32_si128(shift)) }; }
+
+            // All bits set in the lanes that are not empty.
+            friend BitboardLanes computeNonEmptyMask(const BitboardLanes& lanes) { return ~BitboardLanes{ _mm256_cmpeq_epi64(lanes._value, _mm256_setzero_si256()) }; }
+        private:
+            explicit BitboardLanes(__m256i value) : _value{ value } {}
+
+            __m256i _value{};
+#else
+            explicit BitboardLanes(u64 value) { _values.fill(value); }
+            explicit BitboardLanes(const std::array<u64, BatchLaneCount>& values) : _values{ values } {}
+
+            std::array<u64, BatchLaneCount> getValues() const {
+                return _values;
+            }
+
+            friend BitboardLanes operator&(const BitboardLanes& first, const BitboardLanes& second) { return transform(first, second, [](u64 a, u64 b) { return a & b; }); }
+            friend BitboardLanes operator|(const BitboardLanes& first, const BitboardLanes& second) { return transform(first, second, [](u64 a, u64 b) { return a | b; }); }
+            friend BitboardLanes operator-(const BitboardLanes& first, const BitboardLanes& second) { return transform(first, second, [](u64 a, u64 b) { return a - b; }); }
+            friend BitboardLanes operator~(const BitboardLanes& lanes) { return transform(lanes, lanes, [](u64 a, u64) { return ~a; }); }
+            friend BitboardLanes operator<<(const BitboardLanes& lanes, int shift) { return transform(lanes, lanes, [shift](u64 a, u64) { return a << shift; }); }
+            friend BitboardLanes operator>>(const BitboardLanes& lanes, int shift) { return transform(lanes, lanes, [shift](u64 a, u64) { return a >> shift; }); }
+
+            friend BitboardLanes computeNonEmptyMask(const BitboardLanes& lanes) { return transform(lanes, lanes, [](u64 a, u64) { return a != 0 ? ~0ull : 0ull; }); }
+        private:
+            template <typename Function>
+            static BitboardLanes transform(const BitboardLanes& first, const BitboardLanes& second, Function function) {
+                auto result = BitboardLanes{};
+
+                for (auto laneIndex = 0ull; laneIndex < BatchLaneCount; laneIndex++) {
+                    result._values[laneIndex] = function(first._values[laneIndex], second._values[laneIndex]);
+                }
+
+                return result;
+            }
+
+            std::array<u64, BatchLaneCount> _values{};
+#endif
+        };
+
+        // A square index offset and the squares it can reach without wrapping around a board edge. Directions on the
+        // same line share an axis, the only one a piece pinned on it can move along.
+        struct SquareShift {
+            int offset{};
+            u64 targetMask{};
+            usize axis{};
+        };
+
+        constexpr usize PinAxisCount = 4;
+
+        constexpr SquareShift Up{ -8, ~0ull, 0 };
+        constexpr SquareShift Down{ 8, ~0ull, 0 };
+        constexpr SquareShift Left{ -1, ~FileH, 1 };
+        constexpr SquareShift Right{ 1, ~FileA, 1 };
+        constexpr SquareShift UpLeft{ -9, ~FileH, 2 };
+        constexpr SquareShift DownRight{ 9, ~FileA, 2 };
+        constexpr SquareShift UpRight{ -7, ~FileA, 3 };
+        constexpr SquareShift DownLeft{ 7, ~FileH, 3 };
+
+        constexpr SquareShift SlidingShifts[] = { Up, Down, Left, Right, UpLeft, DownRight, UpRight, DownLeft };
+
+        constexpr SquareShift KnightShifts[] = {
+            { -17, ~FileH }, { -15, ~FileA }, { -10, ~(FileG | FileH) }, { -6, ~(FileA | FileB) },
+            { 6, ~(FileG | FileH) }, { 10, ~(FileA | FileB) }, { 15, ~FileH }, { 17, ~FileA },
+        };
+
+        constexpr bool isDiagonalShift(const SquareShift& shift) {
+            return shift.axis >= 2;
+        }
+
+        template <typename Bitboard>
+        Bitboard shiftSquares(const Bitboard& squares, int offset) {
+            return offset > 0 ? squares << offset : squares >> -offset;
+        }
+
+        template <typename Bitboard>
+        Bitboard shiftSquares(const Bitboard& squares, const SquareShift& shift) {
+            return shiftSquares(squares, shift.offset) & Bitboard{ shift.targetMask };
+        }
+
+        // Kogge-Stone occluded fill: the squares the sliders reach in one direction, up to and including the first
+        // occupied one. Rays of different sliders in one direction never overlap, so their squares can be counted.
+        template <typename Bitboard>
+        Bitboard computeSlidingAttacks(Bitboard sliders, const Bitboard& empty, const SquareShift& shift) {
+            auto propagators = empty & Bitboard{ shift.targetMask };
+
+            sliders = sliders | (propagators & shiftSquares(sliders, shift.offset));
+            propagators = propagators & shiftSquares(propagators, shift.offset);
+            sliders = sliders | (propagators & shiftSquares(sliders, shift.offset * 2));
+            propagators = propagators & shiftSquares(propagators, shift.offset * 2);
+            sliders = sliders | (propagators & shiftSquares(sliders, shift.offset * 4));
+
+            return shiftSquares(sliders, shift);
+        }
+
+        template <typename Bitboard>
+        Bitboard computeKnightAttacks(const Bitboard& knights) {
+            auto attacks = Bitboard{};
+
+            for (const auto& shift : KnightShifts) {
+                attacks = attacks | shiftSquares(knights, shift);
+            }
+
+            return attacks;
+        }
+
+        template <typename Bitboard>
+        Bitboard computeKingAttacks(const Bitboard& kings) {
+            auto attacks = Bitboard{};
+
+            for (const auto& shift : SlidingShifts) {
+                attacks = attacks | shiftSquares(kings, shift);
+            }
+
+            return attacks;
+        }
+
+        template <typename Bitboard>
+        Bitboard computePawnAttacks(const Bitboard& whitePawns, const Bitboard& blackPawns) {
+            return shiftSquares(whitePawns, UpLeft) | shiftSquares(whitePawns, UpRight) | shiftSquares(blackPawns, DownLeft) | shiftSquares(blackPawns, DownRight);
+        }
+
+        // The pieces of one side; pawns are split by colour, which decides the direction they attack in.
+        template <typename Bitboard>
+        struct BitboardSide {
+            Bitboard whitePawns{};
+            Bitboard blackPawns{};
+            Bitboard knights{};
+            Bitboard bishopsQueens{};
+            Bitboard rooksQueens{};
+            Bitboard king{};
+        };
+
+        template <typename Bitboard>
+        Bitboard getSlidersForShift(const BitboardSide<Bitboard>& side, const SquareShift& shift) {
+            return isDiagonalShift(shift) ? side.bishopsQueens : side.rooksQueens;
+        }
+
+        template <typename Bitboard>
+        BitboardSide<Bitboard> createBitboardSide(const std::array<Bitboard, ChessPieceTypeCount>& pieces, const Bitboard& white, const Bitboard& color) {
+            using enum ChessPieceType;
+
+            const auto pawns = pieces[static_cast<usize>(Pawn)] & color;
+            const auto queens = pieces[static_cast<usize>(Queen)];
+
+            return {
+                pawns & white,
+                pawns & ~white,
+                pieces[static_cast<usize>(Knight)] & color,
+                (pieces[static_cast<usize>(Bishop)] | queens) & color,
+                (pieces[static_cast<usize>(Rook)] | queens) & color,
+                pieces[static_cast<usize>(King)] & color,
+            };
+        }
+
+        template <typename Bitboard>
+        Bitboard computeAttackedSquares(const BitboardSide<Bitboard>& side, const Bitboard& empty) {
+            auto attacks = computePawnAttacks(side.whitePawns, side.blackPawns) | computeKnightAttacks(side.knights) | computeKingAttacks(side.king);
+
+            for (const auto& shift : SlidingShifts) {
+                attacks = attacks | computeSlidingAttacks(getSlidersForShift(side, shift), empty, shift);
+            }
+
+            return attacks;
+        }
+
+        template <typename Bitboard>
+        Bitboard computeKingAttackers(const Bitboard& king, const BitboardSide<Bitboard>& opponent, const Bitboard& empty) {
+            // A pawn of the king's colour on the king square would attack the opponent pawns that attack the king.
+            auto attackers = (computeKnightAttacks(king) & opponent.knights) | (computeKingAttacks(king) & opponent.king)
+                | (computePawnAttacks(king, Bitboard{}) & opponent.blackPawns) | (computePawnAttacks(Bitboard{}, king) & opponent.whitePawns);
+
+            for (const auto& shift : SlidingShifts) {
+                attackers = attackers | (computeSlidingAttacks(king, empty, shift) & getSlidersForShift(opponent, shift));
+            }
+
+            return attackers;
+        }
+
+        template <typename Function>
+        BitboardLanes gatherLanes(std::span<const BitboardPosition, BatchLaneCount> positions, Function function) {
+            auto values = std::array<u64, BatchLaneCount>{};
+
+            for (auto laneIndex = 0ull; laneIndex < BatchLaneCount; laneIndex++) {
+                values[laneIndex] = function(positions[laneIndex]);
+            }
+
+            return BitboardLanes{ values };
+        }
+
+        void addSquareCounts(std::array<u32, BatchLaneCount>& counts, const BitboardLanes& squares, u32 weight = 1) {
+            const auto values = squares.getValues();
+
+            for (auto laneIndex = 0ull; laneIndex < BatchLaneCount; laneIndex++) {
+                counts[laneIndex] += static_cast<u32>(std::popcount(values[laneIndex])) * weight;
+            }
+        }
+
+        // A pawn move to the last rank is four moves, one per promotion.
+        void addPawnSquareCounts(std::array<u32, BatchLaneCount>& counts, const BitboardLanes& squares) {
+            addSquareCounts(counts, squares & ~BitboardLanes{ PromotionSquares });
+            addSquareCounts(counts, squares & BitboardLanes{ PromotionSquares }, 4);
+        }
+
+        // The rook must be on its square and the king must not pass or land on an attacked square; the caller has
+        // checked the king is not in check. Attacks are computed without the king, which only adds squares behind it.
+        u32 countCastlingMoves(const BitboardPosition& position, u64 occupied, u64 opponentAttacks) {
+            using enum ChessPieceColorType;
+
+            const auto color = position.sideToMove;
+            const auto kingSquareIndex = color == White ? 60ull : 4ull;
+            const auto kingSideRight = color == White ? CastlingRights::WhiteKingSide : CastlingRights::BlackKingSide;
+            const auto queenSideRight = color == White ? CastlingRights::WhiteQueenSide : CastlingRights::BlackQueenSide;
+
+            const auto king = position.pieces[static_cast<usize>(ChessPieceType::King)] & position.colors[static_cast<usize>(color)];
+            const auto rooks = position.pieces[static_cast<usize>(ChessPieceType::Rook)] & position.colors[static_cast<usize>(color)];
+
+            if ((king >> kingSquareIndex & 1) == 0) {
+                return 0;
+            }
+
+            auto moveCount = 0u;
+
+            const auto kingSidePath = 3ull << (kingSquareIndex + 1);
+            if ((position.castlingRights & kingSideRight) != 0 && (rooks >> (kingSquareIndex + 3) & 1) != 0
+                && (occupied & kingSidePath) == 0 && (opponentAttacks & kingSidePath) == 0) {
+                moveCount++;
+            }
+
+            const auto queenSidePath = 3ull << (kingSquareIndex - 2);
+            if ((position.castlingRights & queenSideRight) != 0 && (rooks >> (kingSquareIndex - 4) & 1) != 0
+                && (occupied & (queenSidePath | 1ull << (kingSquareIndex - 3))) == 0 && (opponentAttacks & queenSidePath) == 0) {
+                moveCount++;
+            }
+
+            return moveCount;
+        }
+
+        // Rare enough to be played out one capture at a time: removing two pawns from a rank can expose the king.
+        u32 countEnPassantMoves(const BitboardPosition& position) {
+            using enum ChessPieceColorType;
+
+            if (position.enPassantSquareIndex == NoSquareIndex) {
+                return 0;
+            }
+
+            const auto color = position.sideToMove;
+            const auto isWhite = color == White;
+            const auto& pieces = position.pieces;
+            const auto white = position.colors[static_cast<usize>(White)];
+            const auto own = position.colors[static_cast<usize>(color)];
+            const auto opponent = position.colors[static_cast<usize>(mapColorToOpposite(color))];
+
+            const auto targetSquare = u64{ 1 } << position.enPassantSquareIndex;
+            const auto capturedSquare = isWhite ? targetSquare << 8 : targetSquare >> 8;
+
+            // The squares a pawn of the other colour on the target square would attack hold the capturing pawns.
+            auto capturingPawns = computePawnAttacks(isWhite ? u64{} : targetSquare, isWhite ? targetSquare : u64{}) & pieces[static_cast<usize>(ChessPieceType::Pawn)] & own;
+            auto moveCount = 0u;
+
+            for (; capturingPawns != 0; capturingPawns &= capturingPawns - 1) {
+                const auto capturingSquare = capturingPawns & (0 - capturingPawns);
+                const auto occupied = ((own | opponent) ^ capturingSquare ^ capturedSquare) | targetSquare;
+
+                auto capturedPieces = pieces;
+                capturedPieces[static_cast<usize>(ChessPieceType::Pawn)] &= ~capturedSquare;
+
+                const auto opponentSide = createBitboardSide(capturedPieces, white, opponent & ~capturedSquare);
+                const auto king = pieces[static_cast<usize>(ChessPieceType::King)] & own;
+
+                if (computeKingAttackers(king, opponentSide, ~occupied) == 0) {
+                    moveCount++;
+                }
+            }
+
+            return moveCount;
+        }
+
+        void computeLaneSummaries(std::span<const BitboardPosition, BatchLaneCount> positions, std::span<BitboardMoveSummary, BatchLaneCount> summaries) {
+            using enum ChessPieceColorType;
+
+            auto pieces = std::array<BitboardLanes, ChessPieceTypeCount>{};
+
+            for (auto typeIndex = 0ull; typeIndex < ChessPieceTypeCount; typeIndex++) {
+                pieces[typeIndex] = gatherLanes(positions, [typeIndex](const BitboardPosition& position) { return position.pieces[typeIndex]; });
+            }
+
+            const auto white = gatherLanes(positions, [](const BitboardPosition& position) { return position.colors[static_cast<usize>(White)]; });
+            const auto black = gatherLanes(positions, [](const BitboardPosition& position) { return position.colors[static_cast<usize>(Black)]; });
+            const auto isWhiteToMove = gatherLanes(positions, [](const BitboardPosition& position) { return position.sideToMove == White ? ~0ull : 0ull; });
+
+            const auto occupied = white | black;
+            const auto empty = ~occupied;
+
+            const auto whiteAttacks = computeAttackedSquares(createBitboardSide(pieces, white, white), empty);
+            const auto blackAttacks = computeAttackedSquares(createBitboardSide(pieces, white, black), empty);
+
+            const auto own = (white & isWhiteToMove) | (black & ~isWhiteToMove);
+            const auto opponent = occupied & ~own;
+
+            const auto ownSide = createBitboardSide(pieces, white, own);
+            const auto opponentSide = createBitboardSide(pieces, white, opponent);
+            const auto ownPawns = ownSide.whitePawns | ownSide.blackPawns;
+            const auto king = ownSide.king;
+
+            // The king does not shield the squares behind it from a slider, as it would be attacked on them too.
+            const auto opponentAttacks = computeAttackedSquares(opponentSide, empty | king);
+            const auto checkers = computeKingAttackers(king, opponentSide, empty);
+
+            auto checkRays = BitboardLanes{};
+            auto axisPinnedPieces = std::array<BitboardLanes, PinAxisCount>{};
+
+            for (const auto& shift : SlidingShifts) {
+                const auto sliders = getSlidersForShift(opponentSide, shift);
+                const auto ray = computeSlidingAttacks(king, empty, shift);
+                const auto blockers = ray & own;
+                const auto pinningRay = computeSlidingAttacks(king, empty | blockers, shift);
+
+                checkRays = checkRays | (ray & computeNonEmptyMask(ray & sliders));
+                axisPinnedPieces[shift.axis] = axisPinnedPieces[shift.axis] | (blockers & computeNonEmptyMask(pinningRay & sliders));
+            }
+
+            const auto pinnedPieces = axisPinnedPieces[0] | axisPinnedPieces[1] | axisPinnedPieces[2] | axisPinnedPieces[3];
+            const auto getAxisMovers = [&pinnedPieces, &axisPinnedPieces](const BitboardLanes& pieces, usize axis) {
+                return pieces & ~(pinnedPieces & ~axisPinnedPieces[axis]);
+            };
+
+            // Out of check every square is allowed, in check only the checker and the squares between, in double check none.
+            const auto isNotInCheck = ~computeNonEmptyMask(checkers);
+            const auto isInDoubleCheck = computeNonEmptyMask(checkers & (checkers - BitboardLanes{ 1 }));
+            const auto checkMask = isNotInCheck | (~isInDoubleCheck & (checkers | checkRays));
+            const auto targets = ~own & checkMask;
+
+            auto moveCounts = std::array<u32, BatchLaneCount>{};
+
+            addSquareCounts(moveCounts, computeKingAttacks(king) & ~own & ~opponentAttacks);
+
+            for (const auto& shift : KnightShifts) {
+                addSquareCounts(moveCounts, shiftSquares(ownSide.knights & ~pinnedPieces, shift) & targets);
+            }
+
+            for (const auto& shift : SlidingShifts) {
+                addSquareCounts(moveCounts, computeSlidingAttacks(getAxisMovers(getSlidersForShift(ownSide, shift), shift.axis), empty, shift) & targets);
+            }
+
+            const auto pushingPawns = getAxisMovers(ownPawns, Up.axis);
+            const auto whiteSinglePushes = shiftSquares(pushingPawns & ownSide.whitePawns, Up) & empty;
+            const auto blackSinglePushes = shiftSquares(pushingPawns & ownSide.blackPawns, Down) & empty;
+            const auto doublePushes = (shiftSquares(whiteSinglePushes & BitboardLanes{ WhiteDoublePushSquares }, Up)
+                | shiftSquares(blackSinglePushes & BitboardLanes{ BlackDoublePushSquares }, Down)) & empty;
+
+            addPawnSquareCounts(moveCounts, (whiteSinglePushes | blackSinglePushes) & checkMask);
+            addSquareCounts(moveCounts, doublePushes & checkMask);
+
+            for (const auto& [whiteShift, blackShift] : { std::pair{ UpLeft, DownRight }, std::pair{ UpRight, DownLeft } }) {
+                const auto capturingPawns = getAxisMovers(ownPawns, whiteShift.axis);
+                const auto captures = shiftSquares(capturingPawns & ownSide.whitePawns, whiteShift) | shiftSquares(capturingPawns & ownSide.blackPawns, blackShift);
+
+                addPawnSquareCounts(moveCounts, captures & opponent & checkMask);
+            }
+
+            const auto occupiedValues = occupied.getValues();
+            const auto checkerValues = checkers.getValues();
+            const auto opponentAttackValues = opponentAttacks.getValues();
+            const auto whiteAttackValues = whiteAttacks.getValues();
+            const auto blackAttackValues = blackAttacks.getValues();
+
+            for (auto laneIndex = 0ull; laneIndex < BatchLaneCount; laneIndex++) {
+                const auto& position = positions[laneIndex];
+                auto& summary = summaries[laneIndex];
+
+                summary.attackedSquares[static_cast<usize>(White)] = whiteAttackValues[laneIndex];
+                summary.attackedSquares[static_cast<usize>(Black)] = blackAttackValues[laneIndex];
+                summary.legalMoveCount = moveCounts[laneIndex] + countEnPassantMoves(position);
+
+                if (checkerValues[laneIndex] == 0) {
+                    summary.legalMoveCount += countCastlingMoves(position, occupiedValues[laneIndex], opponentAttackValues[laneIndex]);
+                }
+            }
+        }
+    }
+
+#ifdef CHESSCORE_AVX2_LANES
+    // Defined in BatchMoveGenAvx2.cpp, only to be called when the processor supports AVX2.
+    void computeAvx2LaneSummaries(std::span<const BitboardPosition, BatchLaneCount> positions, std::span<BitboardMoveSummary, BatchLaneCount> summaries);
+#endif
+}
@@ -0,0 +1,261 @@
+#pragma once
+
+#include "Piece.h"
+
+#include <algorithm>
+#include <array>
+
+namespace ChessCore {
+
+    inline constexpr u32 BoardSquareSize = 8;
+    inline constexpr usize BoardSquareCount = BoardSquareSize * BoardSquareSize;
+    inline constexpr u8 NoSquareIndex = 64;
+
+    using ChessBoard = std::array<ChessPiece, BoardSquareCount>;
+
+    // Square index 0 is a8 and index 63 is h1, matching the order pieces are drawn and written in FEN.
+    constexpr usize getSquareFile(usize squareIndex) {
+        return squareIndex % BoardSquareSize;
+    }
+
+    constexpr usize getSquareRank(usize squareIndex) {
+        return BoardSquareSize - 1 - squareIndex / BoardSquareSize;
+    }
+
+    constexpr usize mapFileAndRankToSquareIndex(usize file, usize rank) {
+        return (BoardSquareSize - 1 - rank) * BoardSquareSize + file;
+    }
+
+    enum class DirectionType {
+        Up,
+        Down,
+        Left,
+        Right,
+
+        UpLeft,
+        UpRight,
+        DownRight,
+        DownLeft,
+
+        Count
+    };
+
+    inline constexpr usize DirectionTypeCount = static_cast<usize>(DirectionType::Count);
+
+    enum class KnightDirectionType {
+        UpRightRight,
+        UpRightUp,
+        UpLeftLeft,
+        UpLeftUp,
+
+        DownRightRight,
+        DownRightDown,
+        DownLeftLeft,
+        DownLeftDown,
+
+        Count
+    };
+
+    inline constexpr usize KnightDirectionTypeCount = static_cast<usize>(KnightDirectionType::Count);
+
+    constexpr bool isDiagonalDirection(DirectionType type) {
+        using enum DirectionType;
+        return type == UpLeft || type == UpRight || type == DownRight || type == DownLeft;
+    }
+
+    constexpr bool isDirectionAvailableForChessPieceType(DirectionType directionType, ChessPieceType chessPieceType) {
+        using enum ChessPieceType;
+
+        switch (chessPieceType) {
+        case Queen:
+        case King:
+            return true;
+        case Bishop:
+            return isDiagonalDirection(directionType);
+        case Rook:
+            return !isDiagonalDirection(directionType);
+        default:
+            return false;
+        }
+    }
+
+    constexpr int mapDirectionTypeToArrayIndexOffset(DirectionType type) {
+        using enum DirectionType;
+
+        switch (type) {
+        case Up:
+            return -8;
+        case UpRight:
+            return -7;
+        case UpLeft:
+            return -9;
+        case Down:
+            return 8;
+        case DownRight:
+            return 9;
+        case DownLeft:
+            return 7;
+        case Left:
+            return -1;
+        case Right:
+            return 1;
+        default:
+            return 0;
+        }
+    }
+
+    constexpr int mapKnightDirectionTypeToArrayIndexOffset(KnightDirectionType type) {
+        using enum KnightDirectionType;
+
+        switch (type) {
+        case UpRightRight:
+            return -6;
+        case UpRightUp:
+            return -15;
+        case UpLeftLeft:
+            return -10;
+        case UpLeftUp:
+            return -17;
+        case DownRightRight:
+            return 10;
+        case DownRightDown:
+            return 17;
+        case DownLeftLeft:
+            return 6;
+        case DownLeftDown:
+            return 15;
+        default:
+            return 0;
+        }
+    }
+
+    namespace Implementation {
+
+        struct SquareTargets {
+            std::array<u8, 8> squareIndices{};
+            u8 count{};
+        };
+
+        constexpr usize computeSquaresToEdge(usize index, DirectionType type) {
+            const auto file = index % BoardSquareSize;
+            const auto row = index / BoardSquareSize;
+
+            const auto squaresUp = row;
+            const auto squaresDown = BoardSquareSize - 1 - row;
+            const auto squaresLeft = file;
+            const auto squaresRight = BoardSquareSize - 1 - file;
+
+            using enum DirectionType;
+
+            switch (type) {
+            case Up:
+                return squaresUp;
+            case UpRight:
+                return std::min(squaresRight, squaresUp);
+            case UpLeft:
+                return std::min(squaresLeft, squaresUp);
+            case Down:
+                return squaresDown;
+            case DownRight:
+                return std::min(squaresRight, squaresDown);
+            case DownLeft:
+                return std::min(squaresLeft, squaresDown);
+            case Left:
+                return squaresLeft;
+            case Right:
+                return squaresRight;
+            default:
+                return 0;
+            }
+        }
+
+        constexpr bool isKnightDirectionAvailable(usize index, KnightDirectionType direction) {
+            const auto leftSquareCount = computeSquaresToEdge(index, DirectionType::Left);
+            const auto rightSquareCount = computeSquaresToEdge(index, DirectionType::Right);
+            const auto upSquareCount = computeSquaresToEdge(index, DirectionType::Up);
+            const auto downSquareCount = computeSquaresToEdge(index, DirectionType::Down);
+
+            using enum KnightDirectionType;
+
+            switch (direction) {
+            case UpRightRight:
+                return upSquareCount >= 1 && rightSquareCount >= 2;
+            case UpRightUp:
+                return upSquareCount >= 2 && rightSquareCount >= 1;
+            case UpLeftLeft:
+                return upSquareCount >= 1 && leftSquareCount >= 2;
+            case UpLeftUp:
+                return upSquareCount >= 2 && leftSquareCount >= 1;
+            case DownRightRight:
+                return downSquareCount >= 1 && rightSquareCount >= 2;
+            case DownRightDown:
+                return downSquareCount >= 2 && rightSquareCount >= 1;
+            case DownLeftLeft:
+                return downSquareCount >= 1 && leftSquareCount >= 2;
+            case DownLeftDown:
+                return downSquareCount >= 2 && leftSquareCount >= 1;
+            default:
+                return false;
+            }
+        }
+
+        inline constexpr auto SquaresToEdgeTable = [] {
+            auto table = std::array<std::array<u8, DirectionTypeCount>, BoardSquareCount>{};
+
+            for (auto index = 0ull; index < BoardSquareCount; index++) {
+                for (auto directionIndex = 0ull; directionIndex < DirectionTypeCount; directionIndex++) {
+                    const auto direction = static_cast<DirectionType>(directionIndex);
+                    table[index][directionIndex] = static_cast<u8>(computeSquaresToEdge(index, direction));
+                }
+            }
+
+            return table;
+        }();
+
+        inline constexpr auto KnightTargetsTable = [] {
+            auto table = std::array<SquareTargets, BoardSquareCount>{};
+
+            for (auto index = 0ull; index < BoardSquareCount; index++) {
+                for (auto directionIndex = 0ull; directionIndex < KnightDirectionTypeCount; directionIndex++) {
+                    const auto direction = static_cast<KnightDirectionType>(directionIndex);
+
+                    if (isKnightDirectionAvailable(index, direction)) {
+                        const auto targetIndex = static_cast<int>(index) + mapKnightDirectionTypeToArrayIndexOffset(direction);
+                        table[index].squareIndices[table[index].count++] = static_cast<u8>(targetIndex);
+                    }
+                }
+            }
+
+            return table;
+        }();
+
+        inline constexpr auto KingTargetsTable = [] {
+            auto table = std::array<SquareTargets, BoardSquareCount>{};
+
+            for (auto index = 0ull; index < BoardSquareCount; index++) {
+                for (auto directionIndex = 0ull; directionIndex < DirectionTypeCount; directionIndex++) {
+                    const auto direction = static_cast<DirectionType>(directionIndex);
+
+                    if (computeSquaresToEdge(index, direction) > 0) {
+                        const auto targetIndex = static_cast<int>(index) + mapDirectionTypeToArrayIndexOffset(direction);
+                        table[index].squareIndices[table[index].count++] = static_cast<u8>(targetIndex);
+                    }
+                }
+            }
+
+            return table;
+        }();
+    }
+
+    constexpr usize mapArrayIndexToSquaresToEdge(usize index, DirectionType type) {
+        return Implementation::SquaresToEdgeTable[index][static_cast<usize>(type)];
+    }
+
+    constexpr const Implementation::SquareTargets& getKnightTargets(usize index) {
+        return Implementation::KnightTargetsTable[index];
+    }
+
+    constexpr const Implementation::SquareTargets& getKingTargets(usize index) {
+        return Implementation::KingTargetsTable[index];
+    }
+}
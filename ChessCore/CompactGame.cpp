@@ -0,0 +1,817 @@
+#include "CompactGame.h"
+
+#include "Fen.h"
+#include "MoveGen.h"
+
+#include <algorithm>
+#include <bit>
+#include <format>
+#include <fstream>
+#include <optional>
+#include <queue>
+#include <stdexcept>
+
+namespace ChessCore {
+
+    // "CGAM" followed by the format version, the encoding, three padding bytes and the game count.
+    static constexpr u32 CompactGameMagic = 0x4D414743;
+    static constexpr u32 CompactGameVersion = 3;
+    static constexpr usize CompactGameHeaderSize = 20;
+
+    static constexpr usize MoveIndexSymbolCount = 256;
+    static constexpr u8 MaximumHuffmanCodeLength = 24;
+
+    // A move symbol holds the index of the moving piece among the pieces of the side to move and the rank of the
+    // move among that piece's moves, as piece * 16 + rank. Only a queen can have more than 15 moves, so a rank of
+    // 15 or more is written as 15 followed by a second symbol with the rest of the rank.
+    static constexpr usize PieceRankCount = 16;
+    static constexpr usize EscapedRank = PieceRankCount - 1;
+    static constexpr usize MaximumPieceCount = MoveIndexSymbolCount / PieceRankCount;
+
+    // The low two bits of the game flags hold the result.
+    static constexpr u8 GameResultMask = 3;
+    static constexpr u8 CustomStartingPositionFlag = 4;
+
+    static u32 computeMoveSortKey(const ChessMove& move) {
+        return static_cast<u32>(move.startingSquareIndex) << 10 | static_cast<u32>(move.targetSquareIndex) << 4 | static_cast<u32>(move.promotionType);
+    }
+
+    // The squares of the pieces of each color, indexed by color.
+    using ColorSquares = std::array<u64, ChessPieceColorTypeCount>;
+
+    static ColorSquares computeColorSquares(const Position& position) {
+        auto colorSquares = ColorSquares{};
+
+        for (auto squareIndex = 0ull; squareIndex < BoardSquareCount; squareIndex++) {
+            colorSquares[static_cast<usize>(position.getPiece(squareIndex).color)] |= 1ull << squareIndex;
+        }
+
+        return colorSquares;
+    }
+
+    // Called on the position after the move. Castling also moves a rook and en passant removes a pawn beside the
+    // target; both are rare, so the whole board is looked at again for them.
+    static void updateColorSquares(const Position& position, const ChessMove& move, ColorSquares& colorSquares) {
+        if (move.isCastling || move.isEnPassant) {
+            colorSquares = computeColorSquares(position);
+            return;
+        }
+
+        for (const auto squareIndex : { move.startingSquareIndex, move.targetSquareIndex }) {
+            const auto square = 1ull << squareIndex;
+
+            for (auto& squares : colorSquares) {
+                squares &= ~square;
+            }
+
+            colorSquares[static_cast<usize>(position.getPiece(squareIndex).color)] |= square;
+        }
+    }
+
+    // Pieces are ordered by type, the king first and pawns last, and by square within a type, so a piece keeps
+    // much the same index through a game and the Huffman code gets shorter. The king is always the first piece.
+    static usize computePieceOrder(ChessPieceType type) {
+        return type == ChessPieceType::King ? 0 : static_cast<usize>(type);
+    }
+
+    static usize computePieceIndex(const Position& position, u64 pieceSquares, usize squareIndex) {
+        const auto order = computePieceOrder(position.getPiece(squareIndex).type);
+
+        auto pieceIndex = 0ull;
+
+        for (auto squares = pieceSquares; squares != 0; squares &= squares - 1) {
+            const auto pieceSquareIndex = static_cast<usize>(std::countr_zero(squares));
+            const auto pieceOrder = computePieceOrder(position.getPiece(pieceSquareIndex).type);
+
+            pieceIndex += pieceOrder < order || (pieceOrder == order && pieceSquareIndex < squareIndex);
+        }
+
+        return pieceIndex;
+    }
+
+    static usize findPieceSquareIndex(const Position& position, u64 pieceSquares, usize pieceIndex) {
+        auto orderCounts = std::array<usize, ChessPieceTypeCount>{};
+
+        for (auto squares = pieceSquares; squares != 0; squares &= squares - 1) {
+            orderCounts[computePieceOrder(position.getPiece(static_cast<usize>(std::countr_zero(squares))).type)]++;
+        }
+
+        auto order = 0ull;
+
+        for (; order < orderCounts.size() && pieceIndex >= orderCounts[order]; order++) {
+            pieceIndex -= orderCounts[order];
+        }
+
+        for (auto squares = pieceSquares; squares != 0; squares &= squares - 1) {
+            const auto squareIndex = static_cast<usize>(std::countr_zero(squares));
+
+            if (computePieceOrder(position.getPiece(squareIndex).type) == order && pieceIndex-- == 0) {
+                return squareIndex;
+            }
+        }
+
+        return NoSquareIndex;
+    }
+
+    // A piece's moves are in sort key order. The reader generates the moves of the one piece the symbol names and
+    // checks only the chosen move for legality, on the position it leads to.
+    static bool appendMoveSymbols(const Position& position, const ChessMove& move, MoveList& pieceMoves, std::vector<u8>& bytes) {
+        const auto pieceSquares = computeColorSquares(position)[static_cast<usize>(position.getSideToMove())];
+
+        if ((pieceSquares >> move.startingSquareIndex & 1) == 0) {
+            return false;
+        }
+
+        const auto pieceIndex = computePieceIndex(position, pieceSquares, move.startingSquareIndex);
+
+        pieceMoves.clear();
+        computePieceMoves(position, move.startingSquareIndex, pieceMoves);
+
+        if (pieceIndex >= MaximumPieceCount || !pieceMoves.contains(move) || !isMoveLegal(position, move)) {
+            return false;
+        }
+
+        const auto key = computeMoveSortKey(move);
+        const auto rank = static_cast<usize>(std::count_if(pieceMoves.begin(), pieceMoves.end(), [key](const ChessMove& pieceMove) {
+            return computeMoveSortKey(pieceMove) < key;
+        }));
+
+        bytes.push_back(static_cast<u8>(pieceIndex * PieceRankCount + std::min(rank, EscapedRank)));
+
+        if (rank >= EscapedRank) {
+            bytes.push_back(static_cast<u8>(rank - EscapedRank));
+        }
+
+        return true;
+    }
+
+    static std::optional<ChessMove> findPieceMove(const Position& position, u64 pieceSquares, usize pieceIndex, usize rank, MoveList& pieceMoves) {
+        const auto squareIndex = findPieceSquareIndex(position, pieceSquares, pieceIndex);
+
+        if (squareIndex == NoSquareIndex) {
+            return std::nullopt;
+        }
+
+        pieceMoves.clear();
+        computePieceMoves(position, squareIndex, pieceMoves);
+
+        if (rank >= pieceMoves.size()) {
+            return std::nullopt;
+        }
+
+        // The targets of a piece are distinct except for promotions, which give a pawn on its last rank four moves
+        // to every target, so the rank selects a target square and a promotion type without sorting.
+        auto targetSquares = u64{};
+
+        for (const auto& move : pieceMoves) {
+            targetSquares |= 1ull << move.targetSquareIndex;
+        }
+
+        const auto movesPerTarget = pieceMoves.size() / static_cast<usize>(std::popcount(targetSquares));
+
+        for (auto targetIndex = rank / movesPerTarget; targetIndex != 0; targetIndex--) {
+            targetSquares &= targetSquares - 1;
+        }
+
+        const auto targetSquareIndex = std::countr_zero(targetSquares);
+        const auto promotionType = movesPerTarget == 1 ? ChessPieceType::None
+            : static_cast<ChessPieceType>(static_cast<usize>(ChessPieceType::Queen) + rank % movesPerTarget);
+
+        return *std::find_if(pieceMoves.begin(), pieceMoves.end(), [targetSquareIndex, promotionType](const ChessMove& move) {
+            return move.targetSquareIndex == targetSquareIndex && move.promotionType == promotionType;
+        });
+    }
+
+    // The direction from one square to another on the same file, rank or diagonal, or Count when there is none.
+    static constexpr auto LineDirectionTable = [] {
+        using enum DirectionType;
+
+        auto table = std::array<std::array<DirectionType, BoardSquareCount>, BoardSquareCount>{};
+
+        for (auto fromSquareIndex = 0ull; fromSquareIndex < BoardSquareCount; fromSquareIndex++) {
+            for (auto toSquareIndex = 0ull; toSquareIndex < BoardSquareCount; toSquareIndex++) {
+                const auto fileDelta = static_cast<int>(getSquareFile(toSquareIndex)) - static_cast<int>(getSquareFile(fromSquareIndex));
+                const auto rankDelta = static_cast<int>(getSquareRank(toSquareIndex)) - static_cast<int>(getSquareRank(fromSquareIndex));
+
+                auto& direction = table[fromSquareIndex][toSquareIndex];
+
+                if (fromSquareIndex == toSquareIndex || (fileDelta != 0 && rankDelta != 0 && fileDelta != rankDelta && fileDelta != -rankDelta)) {
+                    direction = Count;
+                } else if (fileDelta == 0) {
+                    direction = rankDelta > 0 ? Up : Down;
+                } else if (rankDelta == 0) {
+                    direction = fileDelta > 0 ? Right : Left;
+                } else if (rankDelta > 0) {
+                    direction = fileDelta > 0 ? UpRight : UpLeft;
+                } else {
+                    direction = fileDelta > 0 ? DownRight : DownLeft;
+                }
+            }
+        }
+
+        return table;
+    }();
+
+    static usize findFirstPieceSquareIndex(const Position& position, usize squareIndex, DirectionType direction) {
+        const auto directionArrayIndexOffset = mapDirectionTypeToArrayIndexOffset(direction);
+        const auto squaresInDirection = mapArrayIndexToSquaresToEdge(squareIndex, direction);
+
+        auto targetSquareIndex = static_cast<int>(squareIndex);
+
+        for (auto directionSquareIndex = 0ull; directionSquareIndex < squaresInDirection; directionSquareIndex++) {
+            targetSquareIndex += directionArrayIndexOffset;
+
+            if (position.getPiece(targetSquareIndex) != ChessPieces::None) {
+                return static_cast<usize>(targetSquareIndex);
+            }
+        }
+
+        return NoSquareIndex;
+    }
+
+    // Replay checks one move per position, so instead of looking for attacks on the king from every direction it
+    // keeps whether the side to move is in check and looks only along the lines the move opened or occupied.
+
+    // Whether the first piece from the square along the line through the other square is a slider of the color
+    // that moves along it.
+    static bool isSliderOnLine(const Position& position, usize squareIndex, usize lineSquareIndex, ChessPieceColorType color) {
+        const auto direction = LineDirectionTable[squareIndex][lineSquareIndex];
+
+        if (direction == DirectionType::Count) {
+            return false;
+        }
+
+        const auto sliderSquareIndex = findFirstPieceSquareIndex(position, squareIndex, direction);
+
+        if (sliderSquareIndex == NoSquareIndex) {
+            return false;
+        }
+
+        const auto slider = position.getPiece(sliderSquareIndex);
+        return slider.color == color && isSlidingPiece(slider.type) && isDirectionAvailableForChessPieceType(direction, slider.type);
+    }
+
+    // Called on the position after the move. Outside of check, a move by a piece other than the king that is not
+    // en passant can only expose the king along the line through the square it left.
+    static bool isMovedSideKingSafe(const Position& position, const ChessMove& move, bool wasKingUnderCheck) {
+        const auto color = mapColorToOpposite(position.getSideToMove());
+        const auto kingSquareIndex = position.getKingSquareIndex(color);
+
+        if (wasKingUnderCheck || move.isEnPassant || kingSquareIndex == move.targetSquareIndex) {
+            return !position.isKingUnderCheck(color);
+        }
+
+        return kingSquareIndex == NoSquareIndex || !isSliderOnLine(position, kingSquareIndex, move.startingSquareIndex, mapColorToOpposite(color));
+    }
+
+    // Called on the position after the move: the moved piece attacks the king, or a slider behind the square it left
+    // does. Castling and en passant move two pieces and are checked in full.
+    static bool isCheckGiven(const Position& position, const ChessMove& move) {
+        using enum DirectionType;
+
+        const auto kingSquareIndex = position.getKingSquareIndex(position.getSideToMove());
+
+        if (move.isCastling || move.isEnPassant) {
+            return position.isKingUnderCheck();
+        }
+
+        if (kingSquareIndex == NoSquareIndex) {
+            return false;
+        }
+
+        const auto piece = position.getPiece(move.targetSquareIndex);
+
+        if (isSliderOnLine(position, kingSquareIndex, move.startingSquareIndex, piece.color)) {
+            return true;
+        }
+
+        if (isSlidingPiece(piece.type)) {
+            const auto direction = LineDirectionTable[kingSquareIndex][move.targetSquareIndex];
+
+            return direction != DirectionType::Count && isDirectionAvailableForChessPieceType(direction, piece.type)
+                && findFirstPieceSquareIndex(position, kingSquareIndex, direction) == move.targetSquareIndex;
+        }
+
+        if (piece.type == ChessPieceType::Knight) {
+            const auto& targets = getKnightTargets(move.targetSquareIndex);
+            return std::find(targets.squareIndices.begin(), targets.squareIndices.begin() + targets.count, kingSquareIndex) != targets.squareIndices.begin() + targets.count;
+        }
+
+        if (piece.type == ChessPieceType::Pawn) {
+            for (const auto direction : piece.color == ChessPieceColorType::White ? std::array{ UpLeft, UpRight } : std::array{ DownLeft, DownRight }) {
+                if (mapArrayIndexToSquaresToEdge(move.targetSquareIndex, direction) != 0
+                    && static_cast<int>(move.targetSquareIndex) + mapDirectionTypeToArrayIndexOffset(direction) == static_cast<int>(kingSquareIndex)) {
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    static u64 readLittleEndian(const u8* bytes, usize byteCount) {
+        auto value = u64{};
+
+        for (auto byteIndex = 0ull; byteIndex < byteCount; byteIndex++) {
+            value |= static_cast<u64>(bytes[byteIndex]) << (byteIndex * 8);
+        }
+
+        return value;
+    }
+
+    static void appendLittleEndian(std::vector<u8>& bytes, u64 value, usize byteCount) {
+        for (auto byteIndex = 0ull; byteIndex < byteCount; byteIndex++) {
+            bytes.push_back(static_cast<u8>(value >> (byteIndex * 8)));
+        }
+    }
+
+    static void appendVarint(std::vector<u8>& bytes, u64 value) {
+        while (value >= 0x80) {
+            bytes.push_back(static_cast<u8>(value | 0x80));
+            value >>= 7;
+        }
+
+        bytes.push_back(static_cast<u8>(value));
+    }
+
+    static u64 readVarint(std::span<const u8> bytes, usize& offset) {
+        auto value = u64{};
+        auto shift = 0;
+
+        while (true) {
+            if (offset >= bytes.size()) {
+                throw std::runtime_error("Compact game data is truncated");
+            }
+
+            const auto byte = bytes[offset++];
+            value |= static_cast<u64>(byte & 0x7F) << shift;
+
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+
+            shift += 7;
+        }
+    }
+
+    static void appendString(std::vector<u8>& bytes, std::string_view text) {
+        appendVarint(bytes, text.size());
+        bytes.insert(bytes.end(), text.begin(), text.end());
+    }
+
+    static std::string_view readString(std::span<const u8> bytes, usize& offset) {
+        const auto size = readVarint(bytes, offset);
+
+        if (bytes.size() - offset < size) {
+            throw std::runtime_error("Compact game data is truncated");
+        }
+
+        const auto text = std::string_view{ reinterpret_cast<const char*>(bytes.data()) + offset, static_cast<usize>(size) };
+        offset += static_cast<usize>(size);
+
+        return text;
+    }
+
+    struct CompactGameHeader {
+        usize offset{};
+        usize moveOffset{};
+        usize moveEnd{};
+        usize moveCount{};
+    };
+
+    // Game headers are byte aligned in both encodings: the flags, the FEN of a custom start, the tag count with a
+    // length-prefixed name and value per tag, and the ply count.
+    static CompactGameHeader readCompactGameHeader(std::span<const u8> bytes, usize offset) {
+        auto header = CompactGameHeader{ offset };
+
+        if (offset >= bytes.size()) {
+            throw std::runtime_error("Compact game data is truncated");
+        }
+
+        const auto flags = bytes[offset++];
+
+        if ((flags & CustomStartingPositionFlag) != 0) {
+            if (offset >= bytes.size() || bytes.size() - offset - 1 < bytes[offset]) {
+                throw std::runtime_error("Compact game data is truncated");
+            }
+
+            offset += 1 + bytes[offset];
+        }
+
+        const auto tagCount = readVarint(bytes, offset);
+
+        for (auto tagIndex = 0ull; tagIndex < tagCount; tagIndex++) {
+            readString(bytes, offset);
+            readString(bytes, offset);
+        }
+
+        header.moveCount = readVarint(bytes, offset);
+        header.moveOffset = offset;
+
+        for (auto moveIndex = 0ull; moveIndex < header.moveCount; moveIndex++) {
+            if (offset >= bytes.size()) {
+                throw std::runtime_error("Compact game data is truncated");
+            }
+
+            offset += bytes[offset] % PieceRankCount == EscapedRank ? 2 : 1;
+        }
+
+        header.moveEnd = offset;
+
+        return header;
+    }
+
+    // Code lengths for the symbol frequencies. When a code gets too long, the frequencies are flattened and the
+    // tree is built again.
+    static std::array<u8, MoveIndexSymbolCount> computeHuffmanCodeLengths(std::array<u64, MoveIndexSymbolCount> frequencies) {
+        auto codeLengths = std::array<u8, MoveIndexSymbolCount>{};
+
+        while (true) {
+            struct HuffmanNode {
+                u64 frequency{};
+                i32 parent = -1;
+            };
+
+            auto nodes = std::vector<HuffmanNode>{};
+            auto queue = std::priority_queue<std::pair<u64, i32>, std::vector<std::pair<u64, i32>>, std::greater<>>{};
+
+            for (auto symbol = 0ull; symbol < MoveIndexSymbolCount; symbol++) {
+                nodes.push_back({ frequencies[symbol] });
+
+                if (frequencies[symbol] != 0) {
+                    queue.emplace(frequencies[symbol], static_cast<i32>(symbol));
+                }
+            }
+
+            // A single symbol still needs a one bit code.
+            if (queue.size() == 1) {
+                codeLengths.fill(0);
+                codeLengths[queue.top().second] = 1;
+                return codeLengths;
+            }
+
+            while (queue.size() > 1) {
+                const auto [firstFrequency, firstNode] = queue.top();
+                queue.pop();
+                const auto [secondFrequency, secondNode] = queue.top();
+                queue.pop();
+
+                const auto parent = static_cast<i32>(nodes.size());
+                nodes.push_back({ firstFrequency + secondFrequency });
+                nodes[firstNode].parent = parent;
+                nodes[secondNode].parent = parent;
+
+                queue.emplace(firstFrequency + secondFrequency, parent);
+            }
+
+            auto maximumLength = u32{};
+
+            for (auto symbol = 0ull; symbol < MoveIndexSymbolCount; symbol++) {
+                auto length = u32{};
+
+                if (frequencies[symbol] != 0) {
+                    for (auto node = nodes[symbol].parent; node != -1; node = nodes[node].parent) {
+                        length++;
+                    }
+                }
+
+                codeLengths[symbol] = static_cast<u8>(std::min<u32>(length, 255));
+                maximumLength = std::max(maximumLength, length);
+            }
+
+            if (maximumLength <= MaximumHuffmanCodeLength) {
+                return codeLengths;
+            }
+
+            for (auto& frequency : frequencies) {
+                frequency = frequency == 0 ? 0 : frequency / 2 + 1;
+            }
+        }
+    }
+
+    // Canonical codes: shorter codes first, symbols of equal length in increasing order.
+    static std::array<u32, MoveIndexSymbolCount> computeHuffmanCodes(const std::array<u8, MoveIndexSymbolCount>& codeLengths) {
+        auto codes = std::array<u32, MoveIndexSymbolCount>{};
+        auto code = u32{};
+
+        for (auto length = 1u; length <= MaximumHuffmanCodeLength; length++) {
+            for (auto symbol = 0ull; symbol < MoveIndexSymbolCount; symbol++) {
+                if (codeLengths[symbol] == length) {
+                    codes[symbol] = code++;
+                }
+            }
+
+            code <<= 1;
+        }
+
+        return codes;
+    }
+
+    void CompactGameWriter::addGame(std::span<const PgnTag> tags, const Position& startingPosition, std::span<const ChessMove> moves, PgnResultType result) {
+        auto flags = static_cast<u8>(static_cast<u8>(result) & GameResultMask);
+        const auto isCustomStartingPosition = startingPosition != Position::createStartingPosition();
+
+        if (isCustomStartingPosition) {
+            flags |= CustomStartingPositionFlag;
+        }
+
+        _bytes.push_back(flags);
+
+        if (isCustomStartingPosition) {
+            auto buffer = FenBuffer{};
+            const auto fen = writeFen(startingPosition, buffer);
+
+            _bytes.push_back(static_cast<u8>(fen.size()));
+            _bytes.insert(_bytes.end(), fen.begin(), fen.end());
+        }
+
+        appendVarint(_bytes, tags.size());
+
+        for (const auto& tag : tags) {
+            appendString(_bytes, tag.name);
+            appendString(_bytes, tag.value);
+        }
+
+        appendVarint(_bytes, moves.size());
+
+        auto position = startingPosition;
+        auto pieceMoves = MoveList{};
+
+        for (const auto& move : moves) {
+            if (!appendMoveSymbols(position, move, pieceMoves, _bytes)) {
+                throw std::runtime_error(std::format("Move {} of game {} is not legal", &move - moves.data() + 1, _gameCount + 1));
+            }
+
+            position.makeMove(move);
+        }
+
+        _gameCount++;
+        _moveCount += moves.size();
+    }
+
+    void CompactGameWriter::append(const CompactGameWriter& other) {
+        _bytes.insert(_bytes.end(), other._bytes.begin(), other._bytes.end());
+        _gameCount += other._gameCount;
+        _moveCount += other._moveCount;
+    }
+
+    std::vector<u8> CompactGameWriter::encode(CompactGameEncodingType encoding) const {
+        auto bytes = std::vector<u8>{};
+
+        appendLittleEndian(bytes, CompactGameMagic, sizeof(u32));
+        appendLittleEndian(bytes, CompactGameVersion, sizeof(u32));
+        bytes.push_back(static_cast<u8>(encoding));
+        bytes.insert(bytes.end(), 3, 0);
+        appendLittleEndian(bytes, _gameCount, sizeof(u64));
+
+        if (encoding == CompactGameEncodingType::MoveIndex) {
+            bytes.insert(bytes.end(), _bytes.begin(), _bytes.end());
+            return bytes;
+        }
+
+        auto frequencies = std::array<u64, MoveIndexSymbolCount>{};
+
+        for (auto offset = 0ull; offset < _bytes.size();) {
+            const auto header = readCompactGameHeader(_bytes, offset);
+
+            for (auto symbolOffset = header.moveOffset; symbolOffset < header.moveEnd; symbolOffset++) {
+                frequencies[_bytes[symbolOffset]]++;
+            }
+
+            offset = header.moveEnd;
+        }
+
+        const auto codeLengths = computeHuffmanCodeLengths(frequencies);
+        const auto codes = computeHuffmanCodes(codeLengths);
+
+        bytes.insert(bytes.end(), codeLengths.begin(), codeLengths.end());
+
+        for (auto offset = 0ull; offset < _bytes.size();) {
+            const auto header = readCompactGameHeader(_bytes, offset);
+
+            bytes.insert(bytes.end(), _bytes.begin() + header.offset, _bytes.begin() + header.moveOffset);
+
+            // Codes are written most significant bit first and every game ends on a byte boundary.
+            auto bitBuffer = u64{};
+            auto bitCount = u32{};
+
+            for (auto symbolOffset = header.moveOffset; symbolOffset < header.moveEnd; symbolOffset++) {
+                const auto symbol = _bytes[symbolOffset];
+
+                bitBuffer = bitBuffer << codeLengths[symbol] | codes[symbol];
+                bitCount += codeLengths[symbol];
+
+                while (bitCount >= 8) {
+                    bitCount -= 8;
+                    bytes.push_back(static_cast<u8>(bitBuffer >> bitCount));
+                }
+            }
+
+            if (bitCount != 0) {
+                bytes.push_back(static_cast<u8>(bitBuffer << (8 - bitCount)));
+            }
+
+            offset = header.moveEnd;
+        }
+
+        return bytes;
+    }
+
+    CompactGameReader::CompactGameReader(std::span<const u8> bytes) : _bytes(bytes) {
+        if (bytes.size() < CompactGameHeaderSize || readLittleEndian(bytes.data(), sizeof(u32)) != CompactGameMagic) {
+            throw std::runtime_error("Data is not in the compact game format");
+        }
+
+        if (readLittleEndian(bytes.data() + 4, sizeof(u32)) != CompactGameVersion) {
+            throw std::runtime_error("Compact game data has an unsupported version");
+        }
+
+        _encoding = static_cast<CompactGameEncodingType>(bytes[8]);
+        _gameCount = readLittleEndian(bytes.data() + 12, sizeof(u64));
+        _offset = CompactGameHeaderSize;
+
+        if (_encoding == CompactGameEncodingType::MoveIndex) {
+            return;
+        }
+
+        if (_encoding != CompactGameEncodingType::Huffman || bytes.size() < _offset + MoveIndexSymbolCount) {
+            throw std::runtime_error("Compact game data has an invalid encoding");
+        }
+
+        std::copy_n(bytes.begin() + _offset, MoveIndexSymbolCount, _codeLengths.begin());
+        _offset += MoveIndexSymbolCount;
+
+        auto symbolIndex = u32{};
+        auto code = u32{};
+
+        for (auto length = 1u; length <= MaximumHuffmanCodeLength; length++) {
+            _firstCodes[length] = code;
+            _firstSymbolIndices[length] = symbolIndex;
+
+            for (auto symbol = 0ull; symbol < MoveIndexSymbolCount; symbol++) {
+                if (_codeLengths[symbol] == length) {
+                    _sortedSymbols[symbolIndex++] = static_cast<u8>(symbol);
+                    _lengthCounts[length]++;
+                    code++;
+                }
+            }
+
+            // Corrupted lengths can ask for more codes of a length than there are.
+            if (code > 1u << length) {
+                throw std::runtime_error("Compact game data has an invalid Huffman code");
+            }
+
+            code <<= 1;
+        }
+
+        for (auto length = 1u; length <= HuffmanLookupBits; length++) {
+            for (auto codeIndex = 0u; codeIndex < _lengthCounts[length]; codeIndex++) {
+                const auto entry = static_cast<u16>(length << 8 | _sortedSymbols[_firstSymbolIndices[length] + codeIndex]);
+                const auto firstEntryIndex = (_firstCodes[length] + codeIndex) << (HuffmanLookupBits - length);
+
+                std::fill_n(_lookupEntries.begin() + firstEntryIndex, 1u << (HuffmanLookupBits - length), entry);
+            }
+        }
+    }
+
+    bool CompactGameReader::readGame(CompactGame& game) {
+        if (_gameIndex == _gameCount) {
+            return false;
+        }
+
+        if (_offset >= _bytes.size()) {
+            throw std::runtime_error("Compact game data is truncated");
+        }
+
+        const auto flags = _bytes[_offset++];
+
+        if ((flags & CustomStartingPositionFlag) != 0) {
+            if (_offset >= _bytes.size() || _bytes.size() - _offset - 1 < _bytes[_offset]) {
+                throw std::runtime_error("Compact game data is truncated");
+            }
+
+            const auto fenLength = _bytes[_offset];
+            const auto fen = std::string_view{ reinterpret_cast<const char*>(_bytes.data()) + _offset + 1, fenLength };
+
+            game.startingPosition = createPositionFromFen(fen);
+            _offset += 1 + fenLength;
+        } else {
+            game.startingPosition = Position::createStartingPosition();
+        }
+
+        game.result = static_cast<PgnResultType>(flags & GameResultMask);
+        game.tags.clear();
+        game.moves.clear();
+
+        const auto tagCount = readVarint(_bytes, _offset);
+
+        for (auto tagIndex = 0ull; tagIndex < tagCount; tagIndex++) {
+            const auto name = readString(_bytes, _offset);
+            game.tags.push_back({ name, readString(_bytes, _offset) });
+        }
+
+        const auto moveCount = readVarint(_bytes, _offset);
+
+        auto position = game.startingPosition;
+        auto pieceMoves = MoveList{};
+        auto colorSquares = computeColorSquares(position);
+        auto isKingUnderCheck = position.isKingUnderCheck();
+
+        for (auto moveIndex = 0ull; moveIndex < moveCount; moveIndex++) {
+            const auto symbol = _readMoveSymbol();
+            auto rank = symbol % PieceRankCount;
+
+            if (rank == EscapedRank) {
+                rank += _readMoveSymbol();
+            }
+
+            const auto move = findPieceMove(position, colorSquares[static_cast<usize>(position.getSideToMove())], symbol / PieceRankCount, rank, pieceMoves);
+
+            if (!move) {
+                throw std::runtime_error(std::format("Move {} of game {} has an invalid index", moveIndex + 1, _gameIndex + 1));
+            }
+
+            position.makeMove(*move);
+
+            if (!isMovedSideKingSafe(position, *move, isKingUnderCheck)) {
+                throw std::runtime_error(std::format("Move {} of game {} is not legal", moveIndex + 1, _gameIndex + 1));
+            }
+
+            isKingUnderCheck = isCheckGiven(position, *move);
+            updateColorSquares(position, *move, colorSquares);
+            game.moves.push_back(*move);
+        }
+
+        // Games end on a byte boundary, so whole bytes still in the bit buffer belong to the next game.
+        _offset -= _bitCount / 8;
+        _bitCount = 0;
+
+        _gameIndex++;
+
+        return true;
+    }
+
+    usize CompactGameReader::_readMoveSymbol() {
+        if (_encoding == CompactGameEncodingType::MoveIndex) {
+            if (_offset >= _bytes.size()) {
+                throw std::runtime_error("Compact game data is truncated");
+            }
+
+            return _bytes[_offset++];
+        }
+
+        while (_bitCount <= 56 && _offset < _bytes.size()) {
+            _bitBuffer = _bitBuffer << 8 | _bytes[_offset++];
+            _bitCount += 8;
+        }
+
+        // Bits past the end of the data read as zeros; a code that needs them is truncated.
+        const auto peekBits = [this](u32 length) {
+            const auto bits = _bitCount >= length ? _bitBuffer >> (_bitCount - length) : _bitBuffer << (length - _bitCount);
+            return static_cast<u32>(bits & ((1ull << length) - 1));
+        };
+
+        const auto entry = _lookupEntries[peekBits(HuffmanLookupBits)];
+        const auto entryLength = static_cast<u32>(entry >> 8);
+
+        if (entryLength != 0 && entryLength <= _bitCount) {
+            _bitCount -= entryLength;
+            return entry & 0xFF;
+        }
+
+        for (auto length = 1u; length <= MaximumHuffmanCodeLength; length++) {
+            if (length > _bitCount) {
+                throw std::runtime_error("Compact game data is truncated");
+            }
+
+            const auto code = peekBits(length);
+
+            if (code - _firstCodes[length] < _lengthCounts[length]) {
+                _bitCount -= length;
+                return _sortedSymbols[_firstSymbolIndices[length] + code - _firstCodes[length]];
+            }
+        }
+
+        throw std::runtime_error("Compact game data has an invalid Huffman code");
+    }
+
+    void writeCompactGameFile(const std::filesystem::path& path, std::span<const u8> bytes) {
+        auto file = std::ofstream{ path, std::ios::binary | std::ios::trunc };
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+
+        if (!file) {
+            throw std::runtime_error(std::format("Compact game file {} could not be written", path.string()));
+        }
+    }
+
+    std::string_view mapCompactGameEncodingTypeToString(CompactGameEncodingType type) {
+        switch (type) {
+        case CompactGameEncodingType::MoveIndex:
+            return "move index";
+        case CompactGameEncodingType::Huffman:
+            return "Huffman";
+        default:
+            return "unknown";
+        }
+    }
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Pgn.h"
+#include "Position.h"
+
+#include <array>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace ChessCore {
+
+    enum class CompactGameEncodingType : u8 {
+        MoveIndex,
+        Huffman,
+    };
+
+    // Tag views point into the data given to the reader, which must outlive the game.
+    struct CompactGame {
+        std::vector<PgnTag> tags{};
+        Position startingPosition{};
+        std::vector<ChessMove> moves{};
+        PgnResultType result{};
+    };
+
+    // Every move is stored as the index of the moving piece among the pieces of the side to move, ordered by type
+    // and square, and the index of the move among that piece's pseudo-legal moves sorted by target square and
+    // promotion, packed in one byte; only queen moves past the fifteenth take a second one. The Huffman variant codes
+    // those bytes with a code built from their frequencies over the whole file. Tags are stored as they are, ahead
+    // of the moves.
+    class CompactGameWriter {
+    public:
+        void addGame(std::span<const PgnTag> tags, const Position& startingPosition, std::span<const ChessMove> moves, PgnResultType result);
+
+        // Appends the games of another writer, so shards converted in parallel can be joined in order.
+        void append(const CompactGameWriter& other);
+
+        std::vector<u8> encode(CompactGameEncodingType encoding) const;
+
+        usize getGameCount() const {
+            return _gameCount;
+        }
+
+        usize getMoveCount() const {
+            return _moveCount;
+        }
+    private:
+        std::vector<u8> _bytes{};
+        usize _gameCount{};
+        usize _moveCount{};
+    };
+
+    class CompactGameReader {
+    public:
+        explicit CompactGameReader(std::span<const u8> bytes);
+
+        // Replays the next game with the move generator, returns false after the last game.
+        bool readGame(CompactGame& game);
+
+        usize getGameCount() const {
+            return _gameCount;
+        }
+
+        CompactGameEncodingType getEncodingType() const {
+            return _encoding;
+        }
+    private:
+        // Codes up to this long are decoded with one table lookup, longer ones length by length.
+        static constexpr u32 HuffmanLookupBits = 10;
+
+        usize _readMoveSymbol();
+
+        std::span<const u8> _bytes{};
+        usize _offset{};
+        usize _gameCount{};
+        usize _gameIndex{};
+        CompactGameEncodingType _encoding{};
+
+        u64 _bitBuffer{};
+        u32 _bitCount{};
+
+        std::array<u8, 256> _codeLengths{};
+        std::array<u32, 33> _firstCodes{};
+        std::array<u32, 33> _firstSymbolIndices{};
+        std::array<u32, 33> _lengthCounts{};
+        std::array<u8, 256> _sortedSymbols{};
+
+        // The symbol in the low byte and the code length above it, or zero when the code is longer.
+        std::array<u16, 1 << HuffmanLookupBits> _lookupEntries{};
+    };
+
+    void writeCompactGameFile(const std::filesystem::path& path, std::span<const u8> bytes);
+
+    std::string_view mapCompactGameEncodingTypeToString(CompactGameEncodingType type);
+}
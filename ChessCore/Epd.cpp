@@ -0,0 +1,128 @@
+#include "Epd.h"
+#include "Fen.h"
+#include "San.h"
+
+#include <format>
+#include <stdexcept>
+
+namespace ChessCore {
+
+    static bool isEpdSpace(char character) {
+        return character == ' ' || character == '\t' || character == '\r';
+    }
+
+    static void skipEpdSpaces(std::string_view line, usize& offset) {
+        while (offset < line.size() && isEpdSpace(line[offset])) {
+            offset++;
+        }
+    }
+
+    static std::string parseEpdOperand(std::string_view line, usize& offset) {
+        if (line[offset] != '"') {
+            const auto begin = offset;
+
+            while (offset < line.size() && !isEpdSpace(line[offset]) && line[offset] != ';') {
+                offset++;
+            }
+
+            return std::string{ line.substr(begin, offset - begin) };
+        }
+
+        const auto end = line.find('"', offset + 1);
+
+        if (end == std::string_view::npos) {
+            throw std::runtime_error(std::format("Unterminated string in EPD line: {}", line));
+        }
+
+        auto operand = std::string{ line.substr(offset + 1, end - offset - 1) };
+        offset = end + 1;
+
+        return operand;
+    }
+
+    const EpdOperation* EpdRecord::findOperation(std::string_view opcode) const {
+        for (const auto& operation : operations) {
+            if (operation.opcode == opcode) {
+                return &operation;
+            }
+        }
+
+        return nullptr;
+    }
+
+    std::vector<ChessMove> EpdRecord::getMoves(std::string_view opcode) const {
+        auto moves = std::vector<ChessMove>{};
+
+        if (const auto* operation = findOperation(opcode)) {
+            for (const auto& operand : operation->operands) {
+                moves.push_back(createMoveFromSan(position, operand));
+            }
+        }
+
+        return moves;
+    }
+
+    EpdRecord parseEpdRecord(std::string_view line) {
+        auto record = EpdRecord{};
+
+        const auto result = parseFen(line, record.position);
+
+        if (result.error != FenParseErrorType::None) {
+            throw std::runtime_error(std::format("{} in EPD line: {}", mapFenParseErrorTypeToString(result.error), line));
+        }
+
+        auto offset = result.length;
+
+        while (true) {
+            skipEpdSpaces(line, offset);
+
+            if (offset >= line.size()) {
+                break;
+            }
+
+            auto operation = EpdOperation{};
+            operation.opcode = parseEpdOperand(line, offset);
+
+            while (true) {
+                skipEpdSpaces(line, offset);
+
+                // The last operation of a line is often written without its semicolon.
+                if (offset >= line.size()) {
+                    break;
+                }
+
+                if (line[offset] == ';') {
+                    offset++;
+                    break;
+                }
+
+                operation.operands.push_back(parseEpdOperand(line, offset));
+            }
+
+            record.operations.push_back(std::move(operation));
+        }
+
+        return record;
+    }
+
+    std::vector<EpdRecord> parseEpdRecords(std::string_view text) {
+        auto records = std::vector<EpdRecord>{};
+
+        while (!text.empty()) {
+            const auto lineEnd = text.find('\n');
+            auto line = text.substr(0, lineEnd);
+
+            text = lineEnd == std::string_view::npos ? std::string_view{} : text.substr(lineEnd + 1);
+
+            auto offset = usize{};
+            skipEpdSpaces(line, offset);
+            line = line.substr(offset);
+
+            if (!line.empty() && line.front() != '#') {
+                records.push_back(parseEpdRecord(line));
+            }
+        }
+
+        return records;
+    }
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Position.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ChessCore {
+
+    struct EpdOperation {
+        std::string opcode{};
+        std::vector<std::string> operands{};
+    };
+
+    struct EpdRecord {
+        Position position{};
+        std::vector<EpdOperation> operations{};
+
+        const EpdOperation* findOperation(std::string_view opcode) const;
+
+        // Moves listed by a SAN operation such as bm or am, throws when one of them is illegal.
+        std::vector<ChessMove> getMoves(std::string_view opcode) const;
+    };
+
+    // Parses the board fields and the semicolon separated operations of one EPD line, throws on malformed input.
+    EpdRecord parseEpdRecord(std::string_view line);
+
+    // Parses every non-empty line that does not start with '#'.
+    std::vector<EpdRecord> parseEpdRecords(std::string_view text);
+}
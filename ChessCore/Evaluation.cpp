@@ -0,0 +1,169 @@
+#include "Evaluation.h"
+
+namespace ChessCore {
+
+    using PieceSquareTable = std::array<i32, BoardSquareCount>;
+
+    static constexpr PieceSquareTable PawnMiddlegameTable = {
+          0,   0,   0,   0,   0,   0,   0,   0,
+         50,  50,  50,  50,  50,  50,  50,  50,
+         10,  10,  20,  30,  30,  20,  10,  10,
+          5,   5,  10,  25,  25,  10,   5,   5,
+          0,   0,   0,  20,  20,   0,   0,   0,
+          5,  -5, -10,   0,   0, -10,  -5,   5,
+          5,  10,  10, -20, -20,  10,  10,   5,
+          0,   0,   0,   0,   0,   0,   0,   0,
+    };
+
+    static constexpr PieceSquareTable PawnEndgameTable = {
+          0,   0,   0,   0,   0,   0,   0,   0,
+         80,  80,  80,  80,  80,  80,  80,  80,
+         50,  50,  50,  50,  50,  50,  50,  50,
+         30,  30,  30,  30,  30,  30,  30,  30,
+         15,  15,  15,  15,  15,  15,  15,  15,
+          5,   5,   5,   5,   5,   5,   5,   5,
+          0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,
+    };
+
+    static constexpr PieceSquareTable KnightTable = {
+        -50, -40, -30, -30, -30, -30, -40, -50,
+        -40, -20,   0,   0,   0,   0, -20, -40,
+        -30,   0,  10,  15,  15,  10,   0, -30,
+        -30,   5,  15,  20,  20,  15,   5, -30,
+        -30,   0,  15,  20,  20,  15,   0, -30,
+        -30,   5,  10,  15,  15,  10,   5, -30,
+        -40, -20,   0,   5,   5,   0, -20, -40,
+        -50, -40, -30, -30, -30, -30, -40, -50,
+    };
+
+    static constexpr PieceSquareTable BishopTable = {
+        -20, -10, -10, -10, -10, -10, -10, -20,
+        -10,   0,   0,   0,   0,   0,   0, -10,
+        -10,   0,   5,  10,  10,   5,   0, -10,
+        -10,   5,   5,  10,  10,   5,   5, -10,
+        -10,   0,  10,  10,  10,  10,   0, -10,
+        -10,  10,  10,  10,  10,  10,  10, -10,
+        -10,   5,   0,   0,   0,   0,   5, -10,
+        -20, -10, -10, -10, -10, -10, -10, -20,
+    };
+
+    static constexpr PieceSquareTable RookTable = {
+          0,   0,   0,   0,   0,   0,   0,   0,
+          5,  10,  10,  10,  10,  10,  10,   5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+          0,   0,   0,   5,   5,   0,   0,   0,
+    };
+
+    static constexpr PieceSquareTable QueenTable = {
+        -20, -10, -10,  -5,  -5, -10, -10, -20,
+        -10,   0,   0,   0,   0,   0,   0, -10,
+        -10,   0,   5,   5,   5,   5,   0, -10,
+         -5,   0,   5,   5,   5,   5,   0,  -5,
+          0,   0,   5,   5,   5,   5,   0,  -5,
+        -10,   5,   5,   5,   5,   5,   0, -10,
+        -10,   0,   5,   0,   0,   0,   0, -10,
+        -20, -10, -10,  -5,  -5, -10, -10, -20,
+    };
+
+    static constexpr PieceSquareTable KingMiddlegameTable = {
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -20, -30, -30, -40, -40, -30, -30, -20,
+        -10, -20, -20, -20, -20, -20, -20, -10,
+         20,  20,   0,   0,   0,   0,  20,  20,
+         20,  30,  10,   0,   0,  10,  30,  20,
+    };
+
+    static constexpr PieceSquareTable KingEndgameTable = {
+        -50, -40, -30, -20, -20, -30, -40, -50,
+        -30, -20, -10,   0,   0, -10, -20, -30,
+        -30, -10,  20,  30,  30,  20, -10, -30,
+        -30, -10,  30,  40,  40,  30, -10, -30,
+        -30, -10,  30,  40,  40,  30, -10, -30,
+        -30, -10,  20,  30,  30,  20, -10, -30,
+        -30, -30,   0,   0,   0,   0, -30, -30,
+        -50, -30, -30, -30, -30, -30, -30, -50,
+    };
+
+    static EvaluationParameters createDefaultEvaluationParameters() {
+        using enum ChessPieceType;
+
+        constexpr auto middlegame = static_cast<usize>(GamePhaseType::Middlegame);
+        constexpr auto endgame = static_cast<usize>(GamePhaseType::Endgame);
+
+        auto parameters = EvaluationParameters{};
+
+        parameters.pieceValues[middlegame] = { 0, 900, 500, 330, 320, 100, 0 };
+        parameters.pieceValues[endgame] = { 0, 920, 530, 310, 290, 120, 0 };
+
+        const auto setTables = [&parameters](ChessPieceType type, const PieceSquareTable& middlegameTable, const PieceSquareTable& endgameTable) {
+            parameters.pieceSquareValues[middlegame][static_cast<usize>(type)] = middlegameTable;
+            parameters.pieceSquareValues[endgame][static_cast<usize>(type)] = endgameTable;
+        };
+
+        setTables(Pawn, PawnMiddlegameTable, PawnEndgameTable);
+        setTables(Knight, KnightTable, KnightTable);
+        setTables(Bishop, BishopTable, BishopTable);
+        setTables(Rook, RookTable, RookTable);
+        setTables(Queen, QueenTable, QueenTable);
+        setTables(King, KingMiddlegameTable, KingEndgameTable);
+
+        return parameters;
+    }
+
+    const EvaluationParameters& getDefaultEvaluationParameters() {
+        static const auto parameters = createDefaultEvaluationParameters();
+        return parameters;
+    }
+
+    i32 computeGamePhase(const Position& position) {
+        auto phase = 0;
+
+        for (const auto piece : position.getBoard()) {
+            phase += GamePhaseWeights[static_cast<usize>(piece.type)];
+        }
+
+        return std::min(phase, MaximumGamePhase);
+    }
+
+    i32 evaluatePosition(const Position& position, const EvaluationParameters& parameters) {
+        constexpr auto middlegame = static_cast<usize>(GamePhaseType::Middlegame);
+        constexpr auto endgame = static_cast<usize>(GamePhaseType::Endgame);
+
+        auto middlegameScore = 0;
+        auto endgameScore = 0;
+        auto phase = 0;
+
+        for (auto squareIndex = 0ull; squareIndex < BoardSquareCount; squareIndex++) {
+            const auto piece = position.getPiece(squareIndex);
+
+            if (piece == ChessPieces::None) {
+                continue;
+            }
+
+            const auto type = static_cast<usize>(piece.type);
+            const auto isWhite = piece.color == ChessPieceColorType::White;
+
+            // Black pieces read the tables mirrored vertically.
+            const auto tableIndex = isWhite ? squareIndex : squareIndex ^ 56;
+            const auto sign = isWhite ? 1 : -1;
+
+            middlegameScore += sign * (parameters.pieceValues[middlegame][type] + parameters.pieceSquareValues[middlegame][type][tableIndex]);
+            endgameScore += sign * (parameters.pieceValues[endgame][type] + parameters.pieceSquareValues[endgame][type][tableIndex]);
+            phase += GamePhaseWeights[type];
+        }
+
+        phase = std::min(phase, MaximumGamePhase);
+
+        const auto score = (middlegameScore * phase + endgameScore * (MaximumGamePhase - phase)) / MaximumGamePhase;
+
+        return position.getSideToMove() == ChessPieceColorType::White ? score : -score;
+    }
+}
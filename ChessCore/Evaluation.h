@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Position.h"
+
+#include <array>
+
+namespace ChessCore {
+
+    enum class GamePhaseType : i16 {
+        Middlegame,
+        Endgame,
+    };
+
+    inline constexpr usize GamePhaseTypeCount = 2;
+
+    // Phase 24 is the starting material and 0 is bare kings and pawns.
+    inline constexpr i32 MaximumGamePhase = 24;
+
+    // Contribution of each piece type to the game phase, indexed by ChessPieceType.
+    inline constexpr std::array<i32, ChessPieceTypeCount> GamePhaseWeights = { 0, 4, 2, 1, 1, 0, 0 };
+
+    // Material and piece-square values in centipawns for both game phases, indexed by ChessPieceType.
+    // Piece-square values are written from white's point of view with square index 0 on a8.
+    struct EvaluationParameters {
+        std::array<std::array<i32, ChessPieceTypeCount>, GamePhaseTypeCount> pieceValues{};
+        std::array<std::array<std::array<i32, BoardSquareCount>, ChessPieceTypeCount>, GamePhaseTypeCount> pieceSquareValues{};
+    };
+
+    const EvaluationParameters& getDefaultEvaluationParameters();
+
+    i32 computeGamePhase(const Position& position);
+
+    // Tapered static evaluation in centipawns from the point of view of the side to move.
+    i32 evaluatePosition(const Position& position, const EvaluationParameters& parameters = getDefaultEvaluationParameters());
+}
@@ -0,0 +1,366 @@
+#include "Fen.h"
+
+#include <charconv>
+#include <format>
+#include <stdexcept>
+
+namespace ChessCore {
+
+    static constexpr std::string_view WhitePieceCharacters = " QRBNPK";
+    static constexpr std::string_view BlackPieceCharacters = " qrbnpk";
+
+    static constexpr auto CharacterToChessPieceTable = [] {
+        auto table = std::array<ChessPiece, 128>{};
+
+        for (auto typeIndex = 1ull; typeIndex < ChessPieceTypeCount; typeIndex++) {
+            const auto type = static_cast<ChessPieceType>(typeIndex);
+
+            table[WhitePieceCharacters[typeIndex]] = { type, ChessPieceColorType::White };
+            table[BlackPieceCharacters[typeIndex]] = { type, ChessPieceColorType::Black };
+        }
+
+        return table;
+    }();
+
+    static ChessPiece mapCharacterToChessPiece(char character) {
+        const auto index = static_cast<unsigned char>(character);
+        return index < CharacterToChessPieceTable.size() ? CharacterToChessPieceTable[index] : ChessPieces::None;
+    }
+
+    static char mapChessPieceToCharacter(ChessPiece piece) {
+        const auto& characters = piece.color == ChessPieceColorType::White ? WhitePieceCharacters : BlackPieceCharacters;
+        return characters[static_cast<usize>(piece.type)];
+    }
+
+    static u8 mapCastlingCharacterToCastlingRight(char character) {
+        switch (character) {
+        case 'K':
+            return CastlingRights::WhiteKingSide;
+        case 'Q':
+            return CastlingRights::WhiteQueenSide;
+        case 'k':
+            return CastlingRights::BlackKingSide;
+        case 'q':
+            return CastlingRights::BlackQueenSide;
+        default:
+            return CastlingRights::None;
+        }
+    }
+
+    static bool isDigit(char character) {
+        return character >= '0' && character <= '9';
+    }
+
+    static bool isEnPassantCapturePossible(const Position& position, usize enPassantSquareIndex) {
+        const auto sideToMove = position.getSideToMove();
+        const auto pawnDirection = sideToMove == ChessPieceColorType::White ? DirectionType::Down : DirectionType::Up;
+        const auto pawnSquareIndex = static_cast<usize>(static_cast<int>(enPassantSquareIndex) + mapDirectionTypeToArrayIndexOffset(pawnDirection));
+
+        if (position.getPiece(pawnSquareIndex) != ChessPiece{ ChessPieceType::Pawn, mapColorToOpposite(sideToMove) }) {
+            return false;
+        }
+
+        const auto capturingPawn = ChessPiece{ ChessPieceType::Pawn, sideToMove };
+        const auto file = getSquareFile(pawnSquareIndex);
+
+        return (file > 0 && position.getPiece(pawnSquareIndex - 1) == capturingPawn)
+            || (file < BoardSquareSize - 1 && position.getPiece(pawnSquareIndex + 1) == capturingPawn);
+    }
+
+    static bool parseFenNumber(std::string_view fen, usize& offset, u32& value) {
+        const auto* begin = fen.data() + offset;
+        const auto [end, error] = std::from_chars(begin, fen.data() + fen.size(), value);
+
+        if (error != std::errc{}) {
+            return false;
+        }
+
+        offset += end - begin;
+        return true;
+    }
+
+    static bool skipFenFieldSeparator(std::string_view fen, usize& offset) {
+        if (offset >= fen.size() || fen[offset] != ' ') {
+            return false;
+        }
+
+        while (offset < fen.size() && fen[offset] == ' ') {
+            offset++;
+        }
+
+        return offset < fen.size();
+    }
+
+    static FenParseErrorType parsePiecePlacement(std::string_view fen, usize& offset, Position& position) {
+        auto rank = 0ull;
+        auto file = 0ull;
+
+        for (; offset < fen.size() && fen[offset] != ' '; offset++) {
+            const auto character = fen[offset];
+
+            if (character == '/') {
+                if (file != BoardSquareSize || ++rank == BoardSquareSize) {
+                    return FenParseErrorType::InvalidPiecePlacement;
+                }
+
+                file = 0;
+            } else if (character >= '1' && character <= '8') {
+                file += character - '0';
+
+                if (file > BoardSquareSize) {
+                    return FenParseErrorType::InvalidPiecePlacement;
+                }
+            } else {
+                const auto piece = mapCharacterToChessPiece(character);
+
+                if (piece == ChessPieces::None || file == BoardSquareSize) {
+                    return FenParseErrorType::InvalidPiecePlacement;
+                }
+
+                position.setPiece(rank * BoardSquareSize + file, piece);
+                file++;
+            }
+        }
+
+        if (rank != BoardSquareSize - 1 || file != BoardSquareSize) {
+            return FenParseErrorType::InvalidPiecePlacement;
+        }
+
+        return FenParseErrorType::None;
+    }
+
+    static FenParseErrorType parseCastlingRights(std::string_view fen, usize& offset, Position& position) {
+        if (fen[offset] == '-') {
+            offset++;
+            position.setCastlingRights(CastlingRights::None);
+
+            return FenParseErrorType::None;
+        }
+
+        auto castlingRights = CastlingRights::None;
+
+        for (; offset < fen.size() && fen[offset] != ' '; offset++) {
+            const auto castlingRight = mapCastlingCharacterToCastlingRight(fen[offset]);
+
+            if (castlingRight == CastlingRights::None || (castlingRights & castlingRight) != 0) {
+                return FenParseErrorType::InvalidCastlingRights;
+            }
+
+            castlingRights |= castlingRight;
+        }
+
+        position.setCastlingRights(castlingRights);
+
+        return FenParseErrorType::None;
+    }
+
+    static FenParseErrorType parseEnPassantSquare(std::string_view fen, usize& offset, Position& position) {
+        if (fen[offset] == '-') {
+            offset++;
+            return FenParseErrorType::None;
+        }
+
+        if (offset + 1 >= fen.size()) {
+            return FenParseErrorType::InvalidEnPassantSquare;
+        }
+
+        const auto fileCharacter = fen[offset];
+        const auto rankCharacter = fen[offset + 1];
+        const auto expectedRankCharacter = position.getSideToMove() == ChessPieceColorType::White ? '6' : '3';
+
+        if (fileCharacter < 'a' || fileCharacter > 'h' || rankCharacter != expectedRankCharacter) {
+            return FenParseErrorType::InvalidEnPassantSquare;
+        }
+
+        offset += 2;
+
+        const auto squareIndex = mapFileAndRankToSquareIndex(fileCharacter - 'a', rankCharacter - '1');
+
+        // Position only keeps en passant squares that can be captured on, matching what makeMove records.
+        if (isEnPassantCapturePossible(position, squareIndex)) {
+            position.setEnPassantSquareIndex(static_cast<u8>(squareIndex));
+        }
+
+        return FenParseErrorType::None;
+    }
+
+    static FenParseErrorType parseClocks(std::string_view fen, usize& offset, Position& position) {
+        auto fieldOffset = offset;
+
+        if (!skipFenFieldSeparator(fen, fieldOffset) || !isDigit(fen[fieldOffset])) {
+            return FenParseErrorType::None;
+        }
+
+        auto halfmoveClock = 0u;
+        if (!parseFenNumber(fen, fieldOffset, halfmoveClock)) {
+            return FenParseErrorType::InvalidHalfmoveClock;
+        }
+
+        position.setHalfmoveClock(halfmoveClock);
+        offset = fieldOffset;
+
+        if (!skipFenFieldSeparator(fen, fieldOffset) || !isDigit(fen[fieldOffset])) {
+            return FenParseErrorType::None;
+        }
+
+        auto fullmoveNumber = 0u;
+        if (!parseFenNumber(fen, fieldOffset, fullmoveNumber)) {
+            return FenParseErrorType::InvalidFullmoveNumber;
+        }
+
+        position.setFullmoveNumber(std::max(fullmoveNumber, 1u));
+        offset = fieldOffset;
+
+        return FenParseErrorType::None;
+    }
+
+    FenParseResult parseFen(std::string_view fen, Position& position) {
+        using enum FenParseErrorType;
+
+        auto result = Position{};
+        auto offset = usize{};
+
+        while (offset < fen.size() && fen[offset] == ' ') {
+            offset++;
+        }
+
+        if (const auto error = parsePiecePlacement(fen, offset, result); error != None) {
+            return { error, offset };
+        }
+
+        if (!skipFenFieldSeparator(fen, offset) || (fen[offset] != 'w' && fen[offset] != 'b')) {
+            return { InvalidSideToMove, offset };
+        }
+
+        result.setSideToMove(fen[offset++] == 'w' ? ChessPieceColorType::White : ChessPieceColorType::Black);
+
+        if (!skipFenFieldSeparator(fen, offset)) {
+            return { InvalidCastlingRights, offset };
+        }
+
+        if (const auto error = parseCastlingRights(fen, offset, result); error != None) {
+            return { error, offset };
+        }
+
+        if (!skipFenFieldSeparator(fen, offset)) {
+            return { InvalidEnPassantSquare, offset };
+        }
+
+        if (const auto error = parseEnPassantSquare(fen, offset, result); error != None) {
+            return { error, offset };
+        }
+
+        if (const auto error = parseClocks(fen, offset, result); error != None) {
+            return { error, offset };
+        }
+
+        position = result;
+
+        return { None, offset };
+    }
+
+    Position createPositionFromFen(std::string_view fen) {
+        auto position = Position{};
+
+        const auto [error, length] = parseFen(fen, position);
+        if (error != FenParseErrorType::None) {
+            throw std::runtime_error(std::format("{} at character {} of FEN '{}'", mapFenParseErrorTypeToString(error), length, fen));
+        }
+
+        return position;
+    }
+
+    std::string_view writeFen(const Position& position, FenBuffer& buffer) {
+        auto* output = buffer.data();
+
+        for (auto rank = 0ull; rank < BoardSquareSize; rank++) {
+            auto emptySquareCount = 0;
+
+            for (auto file = 0ull; file < BoardSquareSize; file++) {
+                const auto piece = position.getPiece(rank * BoardSquareSize + file);
+
+                if (piece == ChessPieces::None) {
+                    emptySquareCount++;
+                    continue;
+                }
+
+                if (emptySquareCount != 0) {
+                    *output++ = static_cast<char>('0' + emptySquareCount);
+                    emptySquareCount = 0;
+                }
+
+                *output++ = mapChessPieceToCharacter(piece);
+            }
+
+            if (emptySquareCount != 0) {
+                *output++ = static_cast<char>('0' + emptySquareCount);
+            }
+
+            if (rank != BoardSquareSize - 1) {
+                *output++ = '/';
+            }
+        }
+
+        *output++ = ' ';
+        *output++ = position.getSideToMove() == ChessPieceColorType::White ? 'w' : 'b';
+        *output++ = ' ';
+
+        const auto castlingRights = position.getCastlingRights();
+
+        if (castlingRights == CastlingRights::None) {
+            *output++ = '-';
+        } else {
+            for (const auto character : { 'K', 'Q', 'k', 'q' }) {
+                if ((castlingRights & mapCastlingCharacterToCastlingRight(character)) != 0) {
+                    *output++ = character;
+                }
+            }
+        }
+
+        *output++ = ' ';
+
+        const auto enPassantSquareIndex = position.getEnPassantSquareIndex();
+
+        if (enPassantSquareIndex == NoSquareIndex) {
+            *output++ = '-';
+        } else {
+            *output++ = static_cast<char>('a' + getSquareFile(enPassantSquareIndex));
+            *output++ = static_cast<char>('1' + getSquareRank(enPassantSquareIndex));
+        }
+
+        auto* end = buffer.data() + buffer.size();
+
+        *output++ = ' ';
+        output = std::to_chars(output, end, position.getHalfmoveClock()).ptr;
+        *output++ = ' ';
+        output = std::to_chars(output, end, position.getFullmoveNumber()).ptr;
+
+        return { buffer.data(), static_cast<usize>(output - buffer.data()) };
+    }
+
+    std::string convertPositionToFen(const Position& position) {
+        auto buffer = FenBuffer{};
+        return std::string{ writeFen(position, buffer) };
+    }
+
+    std::string_view mapFenParseErrorTypeToString(FenParseErrorType type) {
+        switch (type) {
+        case FenParseErrorType::None:
+            return "No error";
+        case FenParseErrorType::InvalidPiecePlacement:
+            return "Invalid piece placement";
+        case FenParseErrorType::InvalidSideToMove:
+            return "Invalid side to move";
+        case FenParseErrorType::InvalidCastlingRights:
+            return "Invalid castling rights";
+        case FenParseErrorType::InvalidEnPassantSquare:
+            return "Invalid en passant square";
+        case FenParseErrorType::InvalidHalfmoveClock:
+            return "Invalid halfmove clock";
+        case FenParseErrorType::InvalidFullmoveNumber:
+            return "Invalid fullmove number";
+        default:
+            throw std::runtime_error("Unreachable");
+        }
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Position.h"
+
+#include <array>
+#include <string>
+#include <string_view>
+
+namespace ChessCore {
+
+    inline constexpr std::string_view StartingPositionFen = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+    // 64 squares, 7 rank separators and the longest possible side, castling, en passant and clock fields.
+    inline constexpr usize MaximumFenLength = 128;
+
+    using FenBuffer = std::array<char, MaximumFenLength>;
+
+    enum class FenParseErrorType : i16 {
+        None,
+        InvalidPiecePlacement,
+        InvalidSideToMove,
+        InvalidCastlingRights,
+        InvalidEnPassantSquare,
+        InvalidHalfmoveClock,
+        InvalidFullmoveNumber,
+    };
+
+    struct FenParseResult {
+        FenParseErrorType error{};
+        usize length{};
+    };
+
+    // Parses the four board fields and the optional clocks without allocating. On success length is the
+    // number of characters consumed, so EPD operations that follow the board fields can be parsed from there.
+    FenParseResult parseFen(std::string_view fen, Position& position);
+
+    Position createPositionFromFen(std::string_view fen);
+
+    std::string_view writeFen(const Position& position, FenBuffer& buffer);
+
+    std::string convertPositionToFen(const Position& position);
+
+    std::string_view mapFenParseErrorTypeToString(FenParseErrorType type);
+}
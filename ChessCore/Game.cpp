@@ -0,0 +1,108 @@
+#include "Game.h"
+#include "MoveGen.h"
+
+#include <stdexcept>
+
+namespace ChessCore {
+
+    bool isInsufficientMaterial(const Position& position) {
+        auto minorPieceCount = 0ull;
+        auto lightSquareBishopCount = 0ull;
+        auto darkSquareBishopCount = 0ull;
+
+        for (auto squareIndex = 0ull; squareIndex < BoardSquareCount; squareIndex++) {
+            const auto type = position.getPiece(squareIndex).type;
+
+            switch (type) {
+            case ChessPieceType::Pawn:
+            case ChessPieceType::Rook:
+            case ChessPieceType::Queen:
+                return false;
+            case ChessPieceType::Knight:
+                minorPieceCount++;
+                break;
+            case ChessPieceType::Bishop:
+                minorPieceCount++;
+                ((getSquareFile(squareIndex) + getSquareRank(squareIndex)) % 2 != 0 ? lightSquareBishopCount : darkSquareBishopCount)++;
+                break;
+            default:
+                break;
+            }
+        }
+
+        const auto hasOnlyBishopsOfOneColor = lightSquareBishopCount + darkSquareBishopCount == minorPieceCount
+            && (lightSquareBishopCount == 0 || darkSquareBishopCount == 0);
+
+        return minorPieceCount <= 1 || hasOnlyBishopsOfOneColor;
+    }
+
+    usize countRepetitions(const Position& position, std::span<const u64> previousKeys) {
+        const auto key = position.getKey();
+        const auto lookback = std::min<usize>(position.getHalfmoveClock(), previousKeys.size());
+
+        auto repetitionCount = 0ull;
+
+        // Only positions with the same side to move since the last capture or pawn move can repeat.
+        for (auto distance = 2ull; distance <= lookback; distance += 2) {
+            if (previousKeys[previousKeys.size() - distance] == key) {
+                repetitionCount++;
+            }
+        }
+
+        return repetitionCount;
+    }
+
+    GameStateType computeGameState(const Position& position, std::span<const u64> previousKeys) {
+        using enum GameStateType;
+
+        if (!hasLegalMoves(position)) {
+            return position.isKingUnderCheck() ? Checkmate : Stalemate;
+        }
+
+        if (isInsufficientMaterial(position)) {
+            return InsufficientMaterial;
+        }
+
+        if (position.getHalfmoveClock() >= 100) {
+            return FiftyMoveRule;
+        }
+
+        if (countRepetitions(position, previousKeys) >= 2) {
+            return ThreefoldRepetition;
+        }
+
+        return InProgress;
+    }
+
+    PgnResultType mapGameStateTypeToPgnResultType(GameStateType type, ChessPieceColorType sideToMove) {
+        switch (type) {
+        case GameStateType::InProgress:
+            return PgnResultType::Unknown;
+        case GameStateType::Checkmate:
+            return sideToMove == ChessPieceColorType::White ? PgnResultType::BlackWin : PgnResultType::WhiteWin;
+        default:
+            return PgnResultType::Draw;
+        }
+    }
+
+    std::string_view mapGameStateTypeToString(GameStateType type) {
+        using enum GameStateType;
+
+        switch (type) {
+        case InProgress:
+            return "In progress";
+        case Checkmate:
+            return "Checkmate";
+        case Stalemate:
+            return "Stalemate";
+        case FiftyMoveRule:
+            return "Fifty-move rule";
+        case ThreefoldRepetition:
+            return "Threefold repetition";
+        case InsufficientMaterial:
+            return "Insufficient material";
+        default:
+            throw std::runtime_error("Unreachable");
+        }
+    }
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Pgn.h"
+#include "Position.h"
+
+#include <span>
+#include <string_view>
+
+namespace ChessCore {
+
+    enum class GameStateType : i16 {
+        InProgress,
+        Checkmate,
+        Stalemate,
+        FiftyMoveRule,
+        ThreefoldRepetition,
+        InsufficientMaterial,
+    };
+
+    // Neither side can mate: bare kings, a single minor piece, or bishops that all stand on one square colour.
+    bool isInsufficientMaterial(const Position& position);
+
+    // Counts earlier occurrences of the position, where previousKeys holds the keys of the game so far, oldest first.
+    usize countRepetitions(const Position& position, std::span<const u64> previousKeys);
+
+    GameStateType computeGameState(const Position& position, std::span<const u64> previousKeys);
+
+    PgnResultType mapGameStateTypeToPgnResultType(GameStateType type, ChessPieceColorType sideToMove);
+
+    std::string_view mapGameStateTypeToString(GameStateType type);
+}
@@ -0,0 +1,285 @@
+#include "GameServer.h"
+
+#include "Fen.h"
+#include "MoveGen.h"
+#include "Uci.h"
+
+#include <algorithm>
+#include <charconv>
+#include <format>
+#include <limits>
+#include <stdexcept>
+
+namespace ChessCore {
+
+    static constexpr u32 GameIdSlotBits = 32;
+
+    static std::string_view takeToken(std::string_view& text) {
+        const auto begin = text.find_first_not_of(' ');
+
+        if (begin == std::string_view::npos) {
+            text = {};
+            return {};
+        }
+
+        const auto end = std::min(text.find(' ', begin), text.size());
+        const auto token = text.substr(begin, end - begin);
+
+        text.remove_prefix(end);
+        return token;
+    }
+
+    static void appendError(std::string_view message, std::string& response) {
+        response += std::format("error {}\n", message);
+    }
+
+    // Both kings must be on the board and the packed slot holds at most 32 pieces.
+    static bool isPositionPlayable(const Position& position) {
+        const auto pieceCount = std::count_if(position.getBoard().begin(), position.getBoard().end(), [](ChessPiece piece) {
+            return piece.type != ChessPieceType::None;
+        });
+
+        return pieceCount <= 32
+            && position.getKingSquareIndex(ChessPieceColorType::White) != NoSquareIndex
+            && position.getKingSquareIndex(ChessPieceColorType::Black) != NoSquareIndex;
+    }
+
+    GameServer::GameServer(usize capacity) {
+        if (capacity == 0 || capacity > std::numeric_limits<u32>::max()) {
+            throw std::runtime_error(std::format("Invalid game server capacity {}", capacity));
+        }
+
+        _slots.resize(capacity);
+        _freeSlotIndices.reserve(capacity);
+
+        // Slots are handed out from the back, so the first games get the lowest slot indices.
+        for (auto slotIndex = capacity; slotIndex > 0; slotIndex--) {
+            _freeSlotIndices.push_back(static_cast<u32>(slotIndex - 1));
+        }
+    }
+
+    void GameServer::handleCommand(std::string_view command, GameServerSession& session, std::string& response) {
+        if (!command.empty() && command.back() == '\r') {
+            command.remove_suffix(1);
+        }
+
+        const auto name = takeToken(command);
+
+        if (name == "new") {
+            _createGame(command, session, response);
+        } else if (name == "move") {
+            const auto id = takeToken(command);
+            _makeMove(id, takeToken(command), response);
+        } else if (name == "state") {
+            _writeGame(takeToken(command), response);
+        } else if (name == "close") {
+            _closeGame(takeToken(command), session, response);
+        } else if (name == "stats") {
+            response += std::format("ok {} {}\n", _gameCount, _slots.size());
+        } else {
+            appendError("unknown command", response);
+        }
+    }
+
+    void GameServer::closeSession(GameServerSession& session) {
+        for (const auto gameId : session.gameIds) {
+            if (auto* slot = _findGame(gameId)) {
+                _releaseGame(gameId, *slot);
+            }
+        }
+
+        session.gameIds.clear();
+    }
+
+    void GameServer::_createGame(std::string_view fen, GameServerSession& session, std::string& response) {
+        if (_freeSlotIndices.empty()) {
+            appendError("server is full", response);
+            return;
+        }
+
+        fen = fen.substr(std::min(fen.find_first_not_of(' '), fen.size()));
+
+        auto position = Position::createStartingPosition();
+
+        if (!fen.empty() && parseFen(fen, position).error != FenParseErrorType::None) {
+            appendError("invalid fen", response);
+            return;
+        }
+
+        if (!isPositionPlayable(position)) {
+            appendError("unsupported position", response);
+            return;
+        }
+
+        const auto slotIndex = _freeSlotIndices.back();
+        _freeSlotIndices.pop_back();
+        _gameCount++;
+
+        _keys.resize(std::max<usize>(_keys.size(), (slotIndex + 1ull) * RepetitionKeyCapacity));
+
+        auto& slot = _slots[slotIndex];
+        slot.isActive = true;
+        slot.keyCount = 0;
+        _storePosition(slot, position, {});
+
+        // Games other sessions closed stay in the list until it would grow, then they are dropped in one pass.
+        if (session.gameIds.size() == session.gameIds.capacity()) {
+            std::erase_if(session.gameIds, [this](u64 gameId) {
+                return _findGame(gameId) == nullptr;
+            });
+        }
+
+        const auto gameId = static_cast<u64>(slot.generation) << GameIdSlotBits | slotIndex;
+        session.gameIds.push_back(gameId);
+
+        _appendGame(gameId, slot, position, response);
+    }
+
+    void GameServer::_makeMove(std::string_view id, std::string_view moveText, std::string& response) {
+        auto gameId = u64{};
+        auto* slot = _findGame(id, gameId);
+
+        if (slot == nullptr) {
+            appendError("unknown game", response);
+            return;
+        }
+
+        if (slot->state != GameStateType::InProgress) {
+            appendError("game is over", response);
+            return;
+        }
+
+        auto position = unpackTrainingRecord(slot->position);
+        auto move = ChessMove{};
+
+        if (!parseUciMove(position, moveText, move)) {
+            appendError("illegal move", response);
+            return;
+        }
+
+        // A game in progress has a halfmove clock below 100 and at most that many keys, so there is room for one more.
+        const auto keys = _getKeys(static_cast<u32>(gameId));
+        keys[slot->keyCount++] = position.getKey();
+        position.makeMove(move);
+
+        if (position.getHalfmoveClock() == 0) {
+            slot->keyCount = 0;
+        }
+
+        _storePosition(*slot, position, keys.first(slot->keyCount));
+        _appendGame(gameId, *slot, position, response);
+    }
+
+    void GameServer::_writeGame(std::string_view id, std::string& response) {
+        auto gameId = u64{};
+        const auto* slot = _findGame(id, gameId);
+
+        if (slot == nullptr) {
+            appendError("unknown game", response);
+            return;
+        }
+
+        _appendGame(gameId, *slot, unpackTrainingRecord(slot->position), response);
+    }
+
+    void GameServer::_closeGame(std::string_view id, GameServerSession& session, std::string& response) {
+        auto gameId = u64{};
+        auto* slot = _findGame(id, gameId);
+
+        if (slot == nullptr) {
+            appendError("unknown game", response);
+            return;
+        }
+
+        _releaseGame(gameId, *slot);
+
+        if (const auto iterator = std::ranges::find(session.gameIds, gameId); iterator != session.gameIds.end()) {
+            *iterator = session.gameIds.back();
+            session.gameIds.pop_back();
+        }
+
+        response += std::format("ok {}\n", gameId);
+    }
+
+    void GameServer::_releaseGame(u64 gameId, GameSlot& slot) {
+        // Bumping the generation makes the old id invalid once the slot is reused.
+        slot.isActive = false;
+        slot.generation++;
+        slot.keyCount = 0;
+
+        _freeSlotIndices.push_back(static_cast<u32>(gameId));
+        _gameCount--;
+    }
+
+    GameServer::GameSlot* GameServer::_findGame(std::string_view id, u64& gameId) {
+        const auto result = std::from_chars(id.data(), id.data() + id.size(), gameId);
+
+        if (result.ec != std::errc{} || result.ptr != id.data() + id.size()) {
+            return nullptr;
+        }
+
+        return _findGame(gameId);
+    }
+
+    GameServer::GameSlot* GameServer::_findGame(u64 gameId) {
+        const auto slotIndex = static_cast<u32>(gameId);
+
+        if (slotIndex >= _slots.size()) {
+            return nullptr;
+        }
+
+        auto& slot = _slots[slotIndex];
+        return slot.isActive && slot.generation == gameId >> GameIdSlotBits ? &slot : nullptr;
+    }
+
+    std::span<u64> GameServer::_getKeys(u32 slotIndex) {
+        return std::span{ _keys }.subspan(slotIndex * RepetitionKeyCapacity, RepetitionKeyCapacity);
+    }
+
+    void GameServer::_storePosition(GameSlot& slot, const Position& position, std::span<const u64> keys) {
+        const auto isBlackToMove = position.getSideToMove() == ChessPieceColorType::Black;
+        const auto ply = std::min<u32>((position.getFullmoveNumber() - 1) * 2 + (isBlackToMove ? 1 : 0), std::numeric_limits<u16>::max());
+
+        slot.position = packTrainingRecord(position, 0, 0, static_cast<u16>(ply));
+        slot.state = computeGameState(position, keys);
+    }
+
+    void GameServer::_appendGame(u64 gameId, const GameSlot& slot, const Position& position, std::string& response) const {
+        auto buffer = FenBuffer{};
+        response += std::format("ok {} {} {}", gameId, mapGameStateTypeToToken(slot.state), writeFen(position, buffer));
+
+        if (slot.state == GameStateType::InProgress) {
+            auto moves = MoveList{};
+            computeLegalMoves(position, moves);
+
+            for (const auto& move : moves) {
+                auto moveBuffer = UciMoveBuffer{};
+                response += ' ';
+                response += writeUciMove(move, moveBuffer);
+            }
+        }
+
+        response += '\n';
+    }
+
+    std::string_view mapGameStateTypeToToken(GameStateType type) {
+        using enum GameStateType;
+
+        switch (type) {
+        case InProgress:
+            return "in-progress";
+        case Checkmate:
+            return "checkmate";
+        case Stalemate:
+            return "stalemate";
+        case FiftyMoveRule:
+            return "fifty-move-rule";
+        case ThreefoldRepetition:
+            return "threefold-repetition";
+        case InsufficientMaterial:
+            return "insufficient-material";
+        default:
+            throw std::runtime_error("Unreachable");
+        }
+    }
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Game.h"
+#include "TrainingData.h"
+
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ChessCore {
+
+    // Holds the state of many games without a window. Every command is one line and gets one response line:
+    //
+    //   new [fen]            -> ok <id> <state> <fen> <legal moves...>
+    //   move <id> <e2e4>     -> ok <id> <state> <fen> <legal moves...>
+    //   state <id>           -> ok <id> <state> <fen> <legal moves...>
+    //   close <id>           -> ok <id>
+    //   stats                -> ok <game count> <capacity>
+    //
+    // The FEN always has six fields and moves are in coordinate notation. Failures answer "error <message>".
+    //
+    // Commands run on behalf of a session, which remembers the games it created so they can be closed when its
+    // client goes away. Any session can move or close any game.
+    struct GameServerSession {
+        std::vector<u64> gameIds{};
+    };
+
+    class GameServer {
+    public:
+        explicit GameServer(usize capacity);
+
+        void handleCommand(std::string_view command, GameServerSession& session, std::string& response);
+
+        // Closes the games the session created that are still open.
+        void closeSession(GameServerSession& session);
+
+        usize getGameCount() const {
+            return _gameCount;
+        }
+
+        usize getCapacity() const {
+            return _slots.size();
+        }
+    private:
+        // Positions are kept packed in 32 bytes. Only the keys since the last capture or pawn move are needed to
+        // detect repetitions, and the fifty-move rule ends a game before there are more than RepetitionKeyCapacity,
+        // so each slot owns a fixed run of that many keys in one buffer shared by all slots.
+        struct GameSlot {
+            TrainingRecord position{};
+            u32 generation{};
+            u8 keyCount{};
+            GameStateType state{};
+            bool isActive{};
+        };
+
+        static constexpr usize RepetitionKeyCapacity = 100;
+
+        void _createGame(std::string_view fen, GameServerSession& session, std::string& response);
+        void _makeMove(std::string_view id, std::string_view move, std::string& response);
+        void _writeGame(std::string_view id, std::string& response);
+        void _closeGame(std::string_view id, GameServerSession& session, std::string& response);
+        void _releaseGame(u64 gameId, GameSlot& slot);
+
+        GameSlot* _findGame(std::string_view id, u64& gameId);
+        GameSlot* _findGame(u64 gameId);
+        std::span<u64> _getKeys(u32 slotIndex);
+        void _storePosition(GameSlot& slot, const Position& position, std::span<const u64> keys);
+        void _appendGame(u64 gameId, const GameSlot& slot, const Position& position, std::string& response) const;
+
+        std::vector<GameSlot> _slots{};
+        // Grows with the highest slot used so far. Closed slots are reused before new ones, so that is the peak game count.
+        std::vector<u64> _keys{};
+        std::vector<u32> _freeSlotIndices{};
+        usize _gameCount{};
+    };
+
+    std::string_view mapGameStateTypeToToken(GameStateType type);
+}
@@ -0,0 +1,168 @@
+#include "LegalMoveTracker.h"
+#include "MoveGen.h"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace ChessCore {
+
+    static u64 computeChangedSquares(const Position& previousPosition, const Position& position) {
+        auto changedSquares = u64{};
+
+        for (auto squareIndex = 0ull; squareIndex < BoardSquareCount; squareIndex++) {
+            if (previousPosition.getPiece(squareIndex) != position.getPiece(squareIndex)) {
+                changedSquares |= 1ull << squareIndex;
+            }
+        }
+
+        // En passant captures belong to the side to move, so pawns next to either square may gain or lose one.
+        if (previousPosition.getEnPassantSquareIndex() != position.getEnPassantSquareIndex() || previousPosition.getSideToMove() != position.getSideToMove()) {
+            for (const auto enPassantSquareIndex : { previousPosition.getEnPassantSquareIndex(), position.getEnPassantSquareIndex() }) {
+                if (enPassantSquareIndex != NoSquareIndex) {
+                    changedSquares |= 1ull << enPassantSquareIndex;
+                }
+            }
+        }
+
+        return changedSquares;
+    }
+
+    static void addAffectedTargets(const Position& position, const Implementation::SquareTargets& targets, bool isKnightTargets, u64& affectedSquares) {
+        for (auto targetIndex = 0; targetIndex < targets.count; targetIndex++) {
+            const auto targetSquareIndex = targets.squareIndices[targetIndex];
+            const auto pieceType = position.getPiece(targetSquareIndex).type;
+
+            const auto isAffected = isKnightTargets ? pieceType == ChessPieceType::Knight
+                : pieceType == ChessPieceType::King || pieceType == ChessPieceType::Pawn;
+
+            if (isAffected) {
+                affectedSquares |= 1ull << targetSquareIndex;
+            }
+        }
+    }
+
+    // Pieces whose pseudo-legal moves depend on the square: the first piece in every direction if it slides that way,
+    // knights a jump away, kings and pawns next to it and pawns that double push over it.
+    static u64 computeAffectedSquares(const Position& position, usize squareIndex) {
+        using enum DirectionType;
+
+        auto affectedSquares = u64{ 1 } << squareIndex;
+
+        for (auto directionIndex = 0ull; directionIndex < DirectionTypeCount; directionIndex++) {
+            const auto direction = static_cast<DirectionType>(directionIndex);
+
+            const auto directionArrayIndexOffset = mapDirectionTypeToArrayIndexOffset(direction);
+            const auto squaresInDirection = mapArrayIndexToSquaresToEdge(squareIndex, direction);
+
+            auto targetSquareIndex = static_cast<int>(squareIndex);
+
+            for (auto directionSquareIndex = 0ull; directionSquareIndex < squaresInDirection; directionSquareIndex++) {
+                targetSquareIndex += directionArrayIndexOffset;
+
+                const auto targetSquare = position.getPiece(targetSquareIndex);
+                if (targetSquare == ChessPieces::None) {
+                    continue;
+                }
+
+                if (isSlidingPiece(targetSquare.type) && isDirectionAvailableForChessPieceType(direction, targetSquare.type)) {
+                    affectedSquares |= 1ull << targetSquareIndex;
+                }
+
+                break;
+            }
+        }
+
+        addAffectedTargets(position, getKnightTargets(squareIndex), true, affectedSquares);
+        addAffectedTargets(position, getKingTargets(squareIndex), false, affectedSquares);
+
+        for (const auto direction : { Up, Down }) {
+            if (mapArrayIndexToSquaresToEdge(squareIndex, direction) >= 2) {
+                const auto pawnSquareIndex = static_cast<usize>(static_cast<int>(squareIndex) + 2 * mapDirectionTypeToArrayIndexOffset(direction));
+
+                if (position.getPiece(pawnSquareIndex).type == ChessPieceType::Pawn) {
+                    affectedSquares |= 1ull << pawnSquareIndex;
+                }
+            }
+        }
+
+        return affectedSquares;
+    }
+
+    void LegalMoveTracker::reset(const Position& position) {
+        _position = position;
+
+        for (auto squareIndex = 0ull; squareIndex < BoardSquareCount; squareIndex++) {
+            _computePieceMoves(squareIndex);
+        }
+
+        _updatedPieceCount = static_cast<usize>(std::ranges::count_if(_pieceMoves, [](const PieceMoves& pieceMoves) { return pieceMoves.count != 0; }));
+    }
+
+    void LegalMoveTracker::update(const Position& position) {
+        const auto changedSquares = computeChangedSquares(_position, position);
+        _position = position;
+
+        // Castling depends on attacks from anywhere on the board, so both kings are always generated again.
+        auto affectedSquares = u64{};
+
+        for (const auto color : { ChessPieceColorType::White, ChessPieceColorType::Black }) {
+            if (const auto kingSquareIndex = position.getKingSquareIndex(color); kingSquareIndex != NoSquareIndex) {
+                affectedSquares |= 1ull << kingSquareIndex;
+            }
+        }
+
+        for (auto squares = changedSquares; squares != 0; squares &= squares - 1) {
+            affectedSquares |= computeAffectedSquares(position, static_cast<usize>(std::countr_zero(squares)));
+        }
+
+        _updatedPieceCount = 0;
+
+        for (auto squares = affectedSquares; squares != 0; squares &= squares - 1) {
+            const auto squareIndex = static_cast<usize>(std::countr_zero(squares));
+            _computePieceMoves(squareIndex);
+
+            if (position.getPiece(squareIndex) != ChessPieces::None) {
+                _updatedPieceCount++;
+            }
+        }
+    }
+
+    void LegalMoveTracker::computeLegalMoves(MoveList& moves) const {
+        const auto color = _position.getSideToMove();
+
+        auto pseudoLegalMoves = MoveList{};
+
+        for (auto squareIndex = 0ull; squareIndex < BoardSquareCount; squareIndex++) {
+            if (_position.getPiece(squareIndex).color != color) {
+                continue;
+            }
+
+            const auto& pieceMoves = _pieceMoves[squareIndex];
+
+            for (auto moveIndex = 0ull; moveIndex < pieceMoves.count; moveIndex++) {
+                pseudoLegalMoves.push(pieceMoves.moves[moveIndex]);
+            }
+        }
+
+        const auto firstMoveIndex = moves.size();
+        filterLegalMoves(_position, pseudoLegalMoves, moves);
+
+        if constexpr (IsLegalMoveCrossCheckEnabled) {
+            const auto expectedMoves = ChessCore::computeLegalMoves(_position);
+
+            if (!std::ranges::equal(moves.begin() + firstMoveIndex, moves.end(), expectedMoves.begin(), expectedMoves.end())) {
+                throw std::runtime_error("Incremental legal moves differ from a full generation");
+            }
+        }
+    }
+
+    void LegalMoveTracker::_computePieceMoves(usize squareIndex) {
+        auto moves = MoveList{};
+        computePieceMoves(_position, squareIndex, moves);
+
+        auto& pieceMoves = _pieceMoves[squareIndex];
+        std::ranges::copy(moves, pieceMoves.moves.begin());
+        pieceMoves.count = static_cast<u8>(moves.size());
+    }
+}
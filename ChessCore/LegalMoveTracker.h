@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Position.h"
+
+#include <array>
+
+namespace ChessCore {
+
+    // Debug builds check every incremental result against a full generation and throw on a difference.
+#ifdef NDEBUG
+    inline constexpr bool IsLegalMoveCrossCheckEnabled = false;
+#else
+    inline constexpr bool IsLegalMoveCrossCheckEnabled = true;
+#endif
+
+    // Keeps the pseudo-legal moves of every piece of both sides. After a move only the pieces whose moves can have
+    // changed are generated again: those on the changed squares, sliders with a ray through one of them, knights,
+    // kings and pawns next to them, and both kings for castling. Legality is decided on the whole list as usual.
+    class LegalMoveTracker {
+    public:
+        void reset(const Position& position);
+
+        // The position can differ from the tracked one in any way; the changed squares are found by comparing boards.
+        void update(const Position& position);
+
+        // Same moves in the same order as computeLegalMoves.
+        void computeLegalMoves(MoveList& moves) const;
+
+        // Pieces generated again by the last reset or update.
+        usize getUpdatedPieceCount() const {
+            return _updatedPieceCount;
+        }
+    private:
+        // A queen in the middle of an empty board has the most moves of any piece.
+        static constexpr usize MaximumPieceMoveCount = 27;
+
+        struct PieceMoves {
+            std::array<ChessMove, MaximumPieceMoveCount> moves{};
+            u8 count{};
+        };
+
+        void _computePieceMoves(usize squareIndex);
+
+        Position _position{};
+        std::array<PieceMoves, BoardSquareCount> _pieceMoves{};
+        usize _updatedPieceCount{};
+    };
+}
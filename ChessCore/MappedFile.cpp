@@ -0,0 +1,94 @@
+#include "MappedFile.h"
+
+#include <format>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ChessCore {
+
+#ifdef _WIN32
+    MappedFile::MappedFile(const std::filesystem::path& path, MappedFileAccessType accessType) {
+        const auto accessFlag = accessType == MappedFileAccessType::Sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS;
+
+        _fileHandle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, accessFlag, nullptr);
+        if (_fileHandle == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error(std::format("File {} could not be opened", path.string()));
+        }
+
+        auto fileSize = LARGE_INTEGER{};
+        GetFileSizeEx(_fileHandle, &fileSize);
+        _size = static_cast<usize>(fileSize.QuadPart);
+
+        if (_size == 0) {
+            return;
+        }
+
+        _mappingHandle = CreateFileMappingW(_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (_mappingHandle == nullptr) {
+            CloseHandle(_fileHandle);
+            throw std::runtime_error(std::format("File {} could not be mapped", path.string()));
+        }
+
+        _data = MapViewOfFile(_mappingHandle, FILE_MAP_READ, 0, 0, 0);
+        if (_data == nullptr) {
+            CloseHandle(_mappingHandle);
+            CloseHandle(_fileHandle);
+            throw std::runtime_error(std::format("File {} could not be mapped", path.string()));
+        }
+    }
+
+    MappedFile::~MappedFile() {
+        if (_data != nullptr) {
+            UnmapViewOfFile(_data);
+        }
+
+        if (_mappingHandle != nullptr) {
+            CloseHandle(_mappingHandle);
+        }
+
+        CloseHandle(_fileHandle);
+    }
+#else
+    MappedFile::MappedFile(const std::filesystem::path& path, MappedFileAccessType accessType) {
+        _fileDescriptor = open(path.c_str(), O_RDONLY);
+        if (_fileDescriptor < 0) {
+            throw std::runtime_error(std::format("File {} could not be opened", path.string()));
+        }
+
+        struct stat fileStatus {};
+        fstat(_fileDescriptor, &fileStatus);
+        _size = static_cast<usize>(fileStatus.st_size);
+
+        if (_size == 0) {
+            return;
+        }
+
+        auto* data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, _fileDescriptor, 0);
+        if (data == MAP_FAILED) {
+            close(_fileDescriptor);
+            throw std::runtime_error(std::format("File {} could not be mapped", path.string()));
+        }
+
+        madvise(data, _size, accessType == MappedFileAccessType::Sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+        _data = data;
+    }
+
+    MappedFile::~MappedFile() {
+        if (_data != nullptr) {
+            munmap(const_cast<void*>(_data), _size);
+        }
+
+        close(_fileDescriptor);
+    }
+#endif
+}
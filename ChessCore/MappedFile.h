@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Pandora/Pandora.h"
+
+#include <filesystem>
+#include <span>
+#include <string_view>
+
+namespace ChessCore {
+
+    enum class MappedFileAccessType : i16 {
+        Sequential,
+        Random,
+    };
+
+    // Read-only memory mapping of a whole file, so multi-gigabyte databases are paged in on demand.
+    class MappedFile {
+    public:
+        explicit MappedFile(const std::filesystem::path& path, MappedFileAccessType accessType = MappedFileAccessType::Sequential);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        std::string_view getContents() const {
+            return { static_cast<const char*>(_data), _size };
+        }
+
+        std::span<const u8> getBytes() const {
+            return { static_cast<const u8*>(_data), _size };
+        }
+
+        usize getSize() const {
+            return _size;
+        }
+    private:
+        const void* _data = nullptr;
+        usize _size{};
+
+#ifdef _WIN32
+        void* _fileHandle = nullptr;
+        void* _mappingHandle = nullptr;
+#else
+        int _fileDescriptor = -1;
+#endif
+    };
+}
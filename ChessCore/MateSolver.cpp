@@ -0,0 +1,254 @@
+#include "MateSolver.h"
+#include "MoveGen.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <optional>
+#include <stdexcept>
+
+namespace ChessCore {
+
+    static constexpr u32 InfiniteProofNumber = 1u << 30;
+
+    // Plies left to the mate limit are part of the table key: a result only holds for the remaining depth it was searched with.
+    static constexpr u64 RemainingPlyKeyMultiplier = 0x9E3779B97F4A7C15ull;
+
+    static u64 mixRemainingPlyCount(u64 key, u32 remainingPlyCount) {
+        return key ^ (remainingPlyCount + 1) * RemainingPlyKeyMultiplier;
+    }
+
+    static u32 addProofNumbers(u32 first, u32 second) {
+        return static_cast<u32>(std::min<u64>(static_cast<u64>(first) + second, InfiniteProofNumber));
+    }
+
+    // The attacker moves at odd remaining ply counts, so the last ply of the limit is always the attacker's.
+    static bool isAttackerNode(u32 remainingPlyCount) {
+        return remainingPlyCount % 2 == 1;
+    }
+
+    MateSolver::MateSolver(usize hashSize) {
+        const auto requestedEntryCount = std::max<usize>(hashSize * 1024 * 1024 / sizeof(Entry), 1);
+        _entries.resize(std::bit_floor(requestedEntryCount));
+    }
+
+    MateSearchResult MateSolver::solve(const Position& position, const MateSearchLimits& limits) {
+        const auto startTime = std::chrono::steady_clock::now();
+
+        _nodeCount = 0;
+        _nodeLimit = limits.nodeCount;
+        _isStopped = false;
+        _pathKeys.clear();
+
+        auto result = MateSearchResult{ MateSearchResultType::NoMate };
+
+        for (auto moveCount = 1u; moveCount <= limits.moveCount; moveCount++) {
+            const auto remainingPlyCount = moveCount * 2 - 1;
+
+            _searchNode(position, remainingPlyCount, InfiniteProofNumber, InfiniteProofNumber);
+
+            if (_isStopped) {
+                result.type = MateSearchResultType::Unknown;
+                break;
+            }
+
+            if (_probe(mixRemainingPlyCount(position.getKey(), remainingPlyCount)).phi == 0) {
+                result.type = MateSearchResultType::Mate;
+                result.moveCount = moveCount;
+
+                // The proof is complete, so the line is extracted without a node limit.
+                _nodeLimit = 0;
+                _extractSolution(position, remainingPlyCount, result.solution);
+                break;
+            }
+        }
+
+        result.nodeCount = _nodeCount;
+        result.elapsedTime = std::chrono::steady_clock::now() - startTime;
+
+        _isStopRequested.store(false, std::memory_order_relaxed);
+
+        return result;
+    }
+
+    void MateSolver::stop() {
+        _isStopRequested.store(true, std::memory_order_relaxed);
+    }
+
+    void MateSolver::_searchNode(const Position& position, u32 remainingPlyCount, u32 phiThreshold, u32 deltaThreshold) {
+        _nodeCount++;
+
+        const auto key = mixRemainingPlyCount(position.getKey(), remainingPlyCount);
+        const auto isAttacker = isAttackerNode(remainingPlyCount);
+
+        auto moves = MoveList{};
+        computeLegalMoves(position, moves);
+
+        // Being mated loses for either side, stalemate only loses for the attacker.
+        if (moves.empty()) {
+            const auto isLoss = isAttacker || position.isKingUnderCheck();
+            _store(key, isLoss ? InfiniteProofNumber : 0, isLoss ? 0 : InfiniteProofNumber);
+            return;
+        }
+
+        if (remainingPlyCount == 0) {
+            _store(key, 0, InfiniteProofNumber);
+            return;
+        }
+
+        auto childKeys = std::array<u64, MaximumMoveCount>{};
+        auto repetitionFlags = std::array<bool, MaximumMoveCount>{};
+
+        _pathKeys.push_back(position.getKey());
+
+        for (auto moveIndex = 0ull; moveIndex < moves.size(); moveIndex++) {
+            auto childPosition = position;
+            childPosition.makeMove(moves[moveIndex]);
+
+            childKeys[moveIndex] = mixRemainingPlyCount(childPosition.getKey(), remainingPlyCount - 1);
+            repetitionFlags[moveIndex] = std::ranges::find(_pathKeys, childPosition.getKey()) != _pathKeys.end();
+        }
+
+        while (true) {
+            auto phi = InfiniteProofNumber;
+            auto delta = 0u;
+            auto bestMoveIndex = 0ull;
+            auto bestChildPhi = 0u;
+            auto secondBestChildDelta = InfiniteProofNumber;
+
+            for (auto moveIndex = 0ull; moveIndex < moves.size(); moveIndex++) {
+                // A repetition is a draw, which fails the attacker whoever is to move in it.
+                auto child = repetitionFlags[moveIndex] ? Entry{ 0, isAttacker ? 0 : InfiniteProofNumber, isAttacker ? InfiniteProofNumber : 0 }
+                    : _probe(childKeys[moveIndex]);
+
+                delta = addProofNumbers(delta, child.phi);
+
+                if (child.delta < phi) {
+                    secondBestChildDelta = phi;
+                    phi = child.delta;
+                    bestMoveIndex = moveIndex;
+                    bestChildPhi = child.phi;
+                } else if (child.delta < secondBestChildDelta) {
+                    secondBestChildDelta = child.delta;
+                }
+            }
+
+            if (phi >= phiThreshold || delta >= deltaThreshold || _shouldStop()) {
+                _store(key, phi, delta);
+                break;
+            }
+
+            const auto childPhiThreshold = static_cast<u32>(std::min<u64>(static_cast<u64>(deltaThreshold) + bestChildPhi - delta, InfiniteProofNumber));
+            const auto childDeltaThreshold = std::min(phiThreshold, addProofNumbers(secondBestChildDelta, 1));
+
+            auto childPosition = position;
+            childPosition.makeMove(moves[bestMoveIndex]);
+
+            _searchNode(childPosition, remainingPlyCount - 1, childPhiThreshold, childDeltaThreshold);
+        }
+
+        _pathKeys.pop_back();
+    }
+
+    // Solves the node completely and reports whether the attacker mates within the remaining plies.
+    bool MateSolver::_proveMate(const Position& position, u32 remainingPlyCount) {
+        _searchNode(position, remainingPlyCount, InfiniteProofNumber, InfiniteProofNumber);
+
+        const auto entry = _probe(mixRemainingPlyCount(position.getKey(), remainingPlyCount));
+        return isAttackerNode(remainingPlyCount) ? entry.phi == 0 : entry.delta == 0;
+    }
+
+    // The attacker plays a move that keeps the mate within the limit, the defender the move that delays it longest.
+    void MateSolver::_extractSolution(const Position& position, u32 remainingPlyCount, std::vector<ChessMove>& solution) {
+        if (remainingPlyCount == 0 || _isStopped) {
+            return;
+        }
+
+        const auto isAttacker = isAttackerNode(remainingPlyCount);
+
+        auto bestMove = std::optional<ChessMove>{};
+        auto bestPlyCount = 0u;
+
+        _pathKeys.push_back(position.getKey());
+
+        for (const auto& move : computeLegalMoves(position)) {
+            auto childPosition = position;
+            childPosition.makeMove(move);
+
+            if (std::ranges::find(_pathKeys, childPosition.getKey()) != _pathKeys.end()) {
+                continue;
+            }
+
+            if (isAttacker) {
+                if (_proveMate(childPosition, remainingPlyCount - 1)) {
+                    bestMove = move;
+                    bestPlyCount = remainingPlyCount - 1;
+                    break;
+                }
+
+                continue;
+            }
+
+            // The shortest mate after this defence, trying the attacker's move counts in turn.
+            for (auto plyCount = 1u; plyCount < remainingPlyCount; plyCount += 2) {
+                if (_proveMate(childPosition, plyCount)) {
+                    if (!bestMove || plyCount > bestPlyCount) {
+                        bestMove = move;
+                        bestPlyCount = plyCount;
+                    }
+
+                    break;
+                }
+            }
+        }
+
+        _pathKeys.pop_back();
+
+        if (!bestMove) {
+            return;
+        }
+
+        solution.push_back(*bestMove);
+
+        auto childPosition = position;
+        childPosition.makeMove(*bestMove);
+
+        _extractSolution(childPosition, bestPlyCount, solution);
+    }
+
+    MateSolver::Entry MateSolver::_probe(u64 key) const {
+        const auto& entry = _entries[key & (_entries.size() - 1)];
+
+        // Unsearched nodes start at one; no stored entry has both numbers at zero.
+        if (entry.key != key || (entry.phi == 0 && entry.delta == 0)) {
+            return { key, 1, 1 };
+        }
+
+        return entry;
+    }
+
+    void MateSolver::_store(u64 key, u32 phi, u32 delta) {
+        _entries[key & (_entries.size() - 1)] = { key, phi, delta };
+    }
+
+    bool MateSolver::_shouldStop() {
+        if (!_isStopped) {
+            _isStopped = _isStopRequested.load(std::memory_order_relaxed) || (_nodeLimit != 0 && _nodeCount >= _nodeLimit);
+        }
+
+        return _isStopped;
+    }
+
+    std::string_view mapMateSearchResultTypeToString(MateSearchResultType type) {
+        switch (type) {
+        case MateSearchResultType::Mate:
+            return "mate";
+        case MateSearchResultType::NoMate:
+            return "no mate";
+        case MateSearchResultType::Unknown:
+            return "unknown";
+        default:
+            throw std::runtime_error("Unreachable");
+        }
+    }
+}
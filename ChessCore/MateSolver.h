@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Position.h"
+
+#include <atomic>
+#include <chrono>
+#include <string_view>
+#include <vector>
+
+namespace ChessCore {
+
+    enum class MateSearchResultType : i16 {
+        Mate,
+        NoMate,
+        Unknown,
+    };
+
+    // A zero node count means no limit.
+    struct MateSearchLimits {
+        u32 moveCount = 10;
+        u64 nodeCount = 10'000'000;
+    };
+
+    // NoMate means no mate within the move count exists; Unknown means the node budget ran out first.
+    struct MateSearchResult {
+        MateSearchResultType type{};
+        u32 moveCount{};
+        std::vector<ChessMove> solution{};
+        u64 nodeCount{};
+        std::chrono::nanoseconds elapsedTime{};
+    };
+
+    // Depth-first proof-number search (df-pn) for a forced mate by the side to move, independent of Searcher and
+    // with its own table of proof and disproof numbers. Mates in 1, 2, ... moves are tried in turn, so the mate
+    // found is the shortest; the solution follows the longest defence.
+    class MateSolver {
+    public:
+        explicit MateSolver(usize hashSize);
+
+        MateSearchResult solve(const Position& position, const MateSearchLimits& limits);
+
+        // Stops a running search as soon as possible, can be called from any thread. A stop requested just before
+        // solve starts ends it at once; solve clears the request when it returns.
+        void stop();
+    private:
+        // Numbers are seen from the side to move: phi is the proof number of its win and delta of its loss.
+        struct Entry {
+            u64 key{};
+            u32 phi{};
+            u32 delta{};
+        };
+
+        void _searchNode(const Position& position, u32 remainingPlyCount, u32 phiThreshold, u32 deltaThreshold);
+        bool _proveMate(const Position& position, u32 remainingPlyCount);
+        void _extractSolution(const Position& position, u32 remainingPlyCount, std::vector<ChessMove>& solution);
+
+        Entry _probe(u64 key) const;
+        void _store(u64 key, u32 phi, u32 delta);
+        bool _shouldStop();
+
+        std::vector<Entry> _entries{};
+        std::vector<u64> _pathKeys{};
+
+        std::atomic<bool> _isStopRequested{};
+        bool _isStopped{};
+
+        u64 _nodeCount{};
+        u64 _nodeLimit{};
+    };
+
+    std::string_view mapMateSearchResultTypeToString(MateSearchResultType type);
+}
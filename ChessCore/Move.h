@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Piece.h"
+
+#include <algorithm>
+#include <array>
+
+namespace ChessCore {
+
+    struct ChessMove {
+        u8 startingSquareIndex{};
+        u8 targetSquareIndex{};
+        ChessPieceType promotionType{};
+        bool isCastling{};
+        bool isEnPassant{};
+        bool isDoubleMovement{};
+
+        bool operator==(const ChessMove&) const = default;
+    };
+
+    // No legal chess position has more than 218 moves.
+    inline constexpr usize MaximumMoveCount = 256;
+
+    class MoveList {
+    public:
+        void push(const ChessMove& move) {
+            _moves[_size++] = move;
+        }
+
+        void clear() {
+            _size = 0;
+        }
+
+        usize size() const {
+            return _size;
+        }
+
+        bool empty() const {
+            return _size == 0;
+        }
+
+        bool contains(const ChessMove& move) const {
+            return std::find(begin(), end(), move) != end();
+        }
+
+        ChessMove& operator[](usize index) {
+            return _moves[index];
+        }
+
+        const ChessMove& operator[](usize index) const {
+            return _moves[index];
+        }
+
+        ChessMove* begin() {
+            return _moves.data();
+        }
+
+        ChessMove* end() {
+            return _moves.data() + _size;
+        }
+
+        const ChessMove* begin() const {
+            return _moves.data();
+        }
+
+        const ChessMove* end() const {
+            return _moves.data() + _size;
+        }
+    private:
+        std::array<ChessMove, MaximumMoveCount> _moves{};
+        usize _size{};
+    };
+}
@@ -0,0 +1,246 @@
+#include "MoveGen.h"
+
+namespace ChessCore {
+
+    static constexpr ChessPieceType PromotionTypes[] = {
+        ChessPieceType::Queen,
+        ChessPieceType::Rook,
+        ChessPieceType::Bishop,
+        ChessPieceType::Knight,
+    };
+
+    static bool isPromotionSquare(usize squareIndex) {
+        const auto rank = getSquareRank(squareIndex);
+        return rank == 0 || rank == BoardSquareSize - 1;
+    }
+
+    static void pushPawnMove(MoveList& moves, usize startingIndex, usize targetIndex) {
+        const auto startingSquareIndex = static_cast<u8>(startingIndex);
+        const auto targetSquareIndex = static_cast<u8>(targetIndex);
+
+        if (isPromotionSquare(targetIndex)) {
+            for (const auto promotionType : PromotionTypes) {
+                moves.push({ startingSquareIndex, targetSquareIndex, promotionType });
+            }
+        } else {
+            moves.push({ startingSquareIndex, targetSquareIndex });
+        }
+    }
+
+    static void computeKnightMoves(const Position& position, usize startingIndex, MoveList& moves) {
+        const auto color = position.getPiece(startingIndex).color;
+        const auto& targets = getKnightTargets(startingIndex);
+
+        for (auto targetIndex = 0; targetIndex < targets.count; targetIndex++) {
+            const auto targetSquareIndex = targets.squareIndices[targetIndex];
+
+            if (position.getPiece(targetSquareIndex).color != color) {
+                moves.push({ static_cast<u8>(startingIndex), targetSquareIndex });
+            }
+        }
+    }
+
+    static void computeKingCastleMoves(const Position& position, usize startingIndex, MoveList& moves) {
+        using enum ChessPieceColorType;
+
+        const auto color = position.getPiece(startingIndex).color;
+        const auto opponentColor = mapColorToOpposite(color);
+        const auto castlingRights = position.getCastlingRights();
+
+        const auto kingSideRight = color == White ? CastlingRights::WhiteKingSide : CastlingRights::BlackKingSide;
+        const auto queenSideRight = color == White ? CastlingRights::WhiteQueenSide : CastlingRights::BlackQueenSide;
+        const auto kingStartingIndex = color == White ? 60ull : 4ull;
+        const auto rook = ChessPiece{ ChessPieceType::Rook, color };
+
+        if (startingIndex != kingStartingIndex || (castlingRights & (kingSideRight | queenSideRight)) == 0) {
+            return;
+        }
+
+        if (position.isSquareAttacked(startingIndex, opponentColor)) {
+            return;
+        }
+
+        const auto isEmpty = [&position](usize squareIndex) {
+            return position.getPiece(squareIndex) == ChessPieces::None;
+        };
+
+        const auto canKingSideCastle = (castlingRights & kingSideRight) != 0
+            && position.getPiece(startingIndex + 3) == rook
+            && isEmpty(startingIndex + 1)
+            && isEmpty(startingIndex + 2)
+            && !position.isSquareAttacked(startingIndex + 1, opponentColor);
+
+        if (canKingSideCastle) {
+            moves.push({ static_cast<u8>(startingIndex), static_cast<u8>(startingIndex + 2), ChessPieceType::None, true });
+        }
+
+        const auto canQueenSideCastle = (castlingRights & queenSideRight) != 0
+            && position.getPiece(startingIndex - 4) == rook
+            && isEmpty(startingIndex - 1)
+            && isEmpty(startingIndex - 2)
+            && isEmpty(startingIndex - 3)
+            && !position.isSquareAttacked(startingIndex - 1, opponentColor);
+
+        if (canQueenSideCastle) {
+            moves.push({ static_cast<u8>(startingIndex), static_cast<u8>(startingIndex - 2), ChessPieceType::None, true });
+        }
+    }
+
+    static void computeKingMoves(const Position& position, usize startingIndex, MoveList& moves) {
+        const auto color = position.getPiece(startingIndex).color;
+        const auto& targets = getKingTargets(startingIndex);
+
+        for (auto targetIndex = 0; targetIndex < targets.count; targetIndex++) {
+            const auto targetSquareIndex = targets.squareIndices[targetIndex];
+
+            if (position.getPiece(targetSquareIndex).color != color) {
+                moves.push({ static_cast<u8>(startingIndex), targetSquareIndex });
+            }
+        }
+
+        computeKingCastleMoves(position, startingIndex, moves);
+    }
+
+    static void computePawnMoves(const Position& position, usize startingIndex, MoveList& moves) {
+        using enum ChessPieceColorType;
+        using enum DirectionType;
+
+        const auto color = position.getPiece(startingIndex).color;
+        const auto opponentColor = mapColorToOpposite(color);
+        const auto enPassantSquareIndex = color == position.getSideToMove() ? position.getEnPassantSquareIndex() : NoSquareIndex;
+
+        const auto pawnVerticalDirection = color == Black ? Down : Up;
+        const auto pawnDiagonalDirections = color == Black ? std::array{ DownLeft, DownRight } : std::array{ UpLeft, UpRight };
+        const auto pawnStartingRank = color == Black ? BoardSquareSize - 2 : 1ull;
+
+        if (mapArrayIndexToSquaresToEdge(startingIndex, pawnVerticalDirection) == 0) {
+            return;
+        }
+
+        const auto verticalOffset = mapDirectionTypeToArrayIndexOffset(pawnVerticalDirection);
+        const auto singleMoveIndex = static_cast<usize>(static_cast<int>(startingIndex) + verticalOffset);
+
+        if (position.getPiece(singleMoveIndex) == ChessPieces::None) {
+            pushPawnMove(moves, startingIndex, singleMoveIndex);
+
+            const auto doubleMoveIndex = static_cast<usize>(static_cast<int>(singleMoveIndex) + verticalOffset);
+
+            if (getSquareRank(startingIndex) == pawnStartingRank && position.getPiece(doubleMoveIndex) == ChessPieces::None) {
+                moves.push({ static_cast<u8>(startingIndex), static_cast<u8>(doubleMoveIndex), ChessPieceType::None, false, false, true });
+            }
+        }
+
+        for (const auto direction : pawnDiagonalDirections) {
+            if (mapArrayIndexToSquaresToEdge(startingIndex, direction) == 0) {
+                continue;
+            }
+
+            const auto targetSquareIndex = static_cast<usize>(static_cast<int>(startingIndex) + mapDirectionTypeToArrayIndexOffset(direction));
+
+            if (position.getPiece(targetSquareIndex).color == opponentColor) {
+                pushPawnMove(moves, startingIndex, targetSquareIndex);
+            } else if (targetSquareIndex == enPassantSquareIndex) {
+                moves.push({ static_cast<u8>(startingIndex), static_cast<u8>(targetSquareIndex), ChessPieceType::None, false, true });
+            }
+        }
+    }
+
+    static void computeSlidingPieceMoves(const Position& position, usize startingIndex, ChessPiece piece, MoveList& moves) {
+        const auto color = piece.color;
+        const auto opponentColor = mapColorToOpposite(color);
+
+        for (auto directionIndex = 0ull; directionIndex < DirectionTypeCount; directionIndex++) {
+            const auto direction = static_cast<DirectionType>(directionIndex);
+
+            if (!isDirectionAvailableForChessPieceType(direction, piece.type)) {
+                continue;
+            }
+
+            const auto directionArrayIndexOffset = mapDirectionTypeToArrayIndexOffset(direction);
+            const auto squaresInDirection = mapArrayIndexToSquaresToEdge(startingIndex, direction);
+
+            auto targetSquareIndex = static_cast<int>(startingIndex);
+
+            for (auto directionSquareIndex = 0ull; directionSquareIndex < squaresInDirection; directionSquareIndex++) {
+                targetSquareIndex += directionArrayIndexOffset;
+
+                const auto targetSquare = position.getPiece(targetSquareIndex);
+
+                if (targetSquare.color == color) {
+                    break;
+                }
+
+                moves.push({ static_cast<u8>(startingIndex), static_cast<u8>(targetSquareIndex) });
+
+                if (targetSquare.color == opponentColor) {
+                    break;
+                }
+            }
+        }
+    }
+
+    void computePieceMoves(const Position& position, usize startingSquareIndex, MoveList& moves) {
+        const auto piece = position.getPiece(startingSquareIndex);
+
+        if (isSlidingPiece(piece.type)) {
+            computeSlidingPieceMoves(position, startingSquareIndex, piece, moves);
+        } else if (piece.type == ChessPieceType::Pawn) {
+            computePawnMoves(position, startingSquareIndex, moves);
+        } else if (piece.type == ChessPieceType::King) {
+            computeKingMoves(position, startingSquareIndex, moves);
+        } else if (piece.type == ChessPieceType::Knight) {
+            computeKnightMoves(position, startingSquareIndex, moves);
+        }
+    }
+
+    void computePseudoLegalMoves(const Position& position, MoveList& moves) {
+        const auto color = position.getSideToMove();
+
+        for (auto startingSquareIndex = 0ull; startingSquareIndex < BoardSquareCount; startingSquareIndex++) {
+            if (position.getPiece(startingSquareIndex).color == color) {
+                computePieceMoves(position, startingSquareIndex, moves);
+            }
+        }
+    }
+
+    bool isMoveLegal(const Position& position, const ChessMove& move) {
+        auto nextPosition = position;
+        nextPosition.makeMove(move);
+
+        return !nextPosition.isKingUnderCheck(position.getSideToMove());
+    }
+
+    void filterLegalMoves(const Position& position, const MoveList& pseudoLegalMoves, MoveList& moves) {
+        for (const auto& move : pseudoLegalMoves) {
+            if (isMoveLegal(position, move)) {
+                moves.push(move);
+            }
+        }
+    }
+
+    void computeLegalMoves(const Position& position, MoveList& moves) {
+        auto pseudoLegalMoves = MoveList{};
+        computePseudoLegalMoves(position, pseudoLegalMoves);
+
+        filterLegalMoves(position, pseudoLegalMoves, moves);
+    }
+
+    MoveList computeLegalMoves(const Position& position) {
+        auto moves = MoveList{};
+        computeLegalMoves(position, moves);
+        return moves;
+    }
+
+    bool hasLegalMoves(const Position& position) {
+        auto pseudoLegalMoves = MoveList{};
+        computePseudoLegalMoves(position, pseudoLegalMoves);
+
+        for (const auto& move : pseudoLegalMoves) {
+            if (isMoveLegal(position, move)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Position.h"
+
+namespace ChessCore {
+
+    // Pseudo-legal moves of the piece on the square, whichever side it belongs to. En passant is only generated
+    // for the side to move.
+    void computePieceMoves(const Position& position, usize startingSquareIndex, MoveList& moves);
+
+    void computePseudoLegalMoves(const Position& position, MoveList& moves);
+
+    // Keeps the pseudo-legal moves of the side to move that do not leave its king in check, in order.
+    void filterLegalMoves(const Position& position, const MoveList& pseudoLegalMoves, MoveList& moves);
+
+    void computeLegalMoves(const Position& position, MoveList& moves);
+
+    MoveList computeLegalMoves(const Position& position);
+
+    bool isMoveLegal(const Position& position, const ChessMove& move);
+
+    bool hasLegalMoves(const Position& position);
+}
@@ -0,0 +1,184 @@
+#include "Perft.h"
+#include "MoveGen.h"
+
+#include <algorithm>
+#include <bit>
+#include <optional>
+#include <thread>
+
+namespace ChessCore {
+
+    // The depth takes the low byte of the slot data and the node count the rest, which holds any perft count.
+    static u64 packPerftEntry(u32 depth, u64 nodeCount) {
+        return nodeCount << 8 | depth;
+    }
+
+    struct PerftWorkItem {
+        usize rootMoveIndex{};
+        Position position{};
+    };
+
+    PerftTable::PerftTable(usize sizeInMegabytes) {
+        const auto requestedSlotCount = std::max<usize>(sizeInMegabytes * 1024 * 1024 / sizeof(Slot), 1);
+
+        _slotCount = std::bit_floor(requestedSlotCount);
+        _slots = std::make_unique<Slot[]>(_slotCount);
+    }
+
+    bool PerftTable::probe(u64 key, u32 depth, u64& nodeCount) const {
+        const auto& slot = _slots[key & (_slotCount - 1)];
+
+        const auto data = slot.data.load(std::memory_order_relaxed);
+        const auto check = slot.check.load(std::memory_order_relaxed);
+
+        if ((check ^ data) != key || (data & 0xFF) != depth) {
+            return false;
+        }
+
+        nodeCount = data >> 8;
+        return true;
+    }
+
+    void PerftTable::store(u64 key, u32 depth, u64 nodeCount) {
+        auto& slot = _slots[key & (_slotCount - 1)];
+        const auto data = packPerftEntry(depth, nodeCount);
+
+        slot.check.store(key ^ data, std::memory_order_relaxed);
+        slot.data.store(data, std::memory_order_relaxed);
+    }
+
+    u64 perft(const Position& position, u32 depth) {
+        if (depth == 0) {
+            return 1;
+        }
+
+        auto moves = MoveList{};
+        computeLegalMoves(position, moves);
+
+        if (depth == 1) {
+            return moves.size();
+        }
+
+        auto nodeCount = 0ull;
+
+        for (const auto& move : moves) {
+            auto nextPosition = position;
+            nextPosition.makeMove(move);
+            nodeCount += perft(nextPosition, depth - 1);
+        }
+
+        return nodeCount;
+    }
+
+    // Depth 1 is counted from the move list, which is cheaper than a table lookup, so only deeper subtrees are stored.
+    u64 perft(const Position& position, u32 depth, PerftTable& table) {
+        if (depth <= 1) {
+            return perft(position, depth);
+        }
+
+        auto nodeCount = u64{};
+
+        if (table.probe(position.getKey(), depth, nodeCount)) {
+            return nodeCount;
+        }
+
+        auto moves = MoveList{};
+        computeLegalMoves(position, moves);
+
+        for (const auto& move : moves) {
+            auto nextPosition = position;
+            nextPosition.makeMove(move);
+            nodeCount += perft(nextPosition, depth - 1, table);
+        }
+
+        table.store(position.getKey(), depth, nodeCount);
+
+        return nodeCount;
+    }
+
+    std::vector<PerftMoveCount> perftDivide(const Position& position, u32 depth) {
+        auto moveCounts = std::vector<PerftMoveCount>{};
+
+        if (depth == 0) {
+            return moveCounts;
+        }
+
+        for (const auto& move : computeLegalMoves(position)) {
+            auto nextPosition = position;
+            nextPosition.makeMove(move);
+            moveCounts.emplace_back(move, perft(nextPosition, depth - 1));
+        }
+
+        return moveCounts;
+    }
+
+    std::vector<PerftMoveCount> perftDivide(const Position& position, u32 depth, const PerftSettings& settings) {
+        auto moveCounts = std::vector<PerftMoveCount>{};
+
+        if (depth == 0) {
+            return moveCounts;
+        }
+
+        const auto rootMoves = computeLegalMoves(position);
+
+        // The 20 root moves of the starting position are too few to keep many threads busy, so from depth 3 the
+        // work is split one ply deeper.
+        const auto workDepth = depth >= 3 ? 2u : 1u;
+        auto workItems = std::vector<PerftWorkItem>{};
+
+        for (auto moveIndex = 0ull; moveIndex < rootMoves.size(); moveIndex++) {
+            auto nextPosition = position;
+            nextPosition.makeMove(rootMoves[moveIndex]);
+
+            if (workDepth == 1) {
+                workItems.emplace_back(moveIndex, nextPosition);
+                continue;
+            }
+
+            for (const auto& reply : computeLegalMoves(nextPosition)) {
+                auto replyPosition = nextPosition;
+                replyPosition.makeMove(reply);
+                workItems.emplace_back(moveIndex, replyPosition);
+            }
+        }
+
+        auto table = std::optional<PerftTable>{};
+
+        if (settings.hashSize != 0) {
+            table.emplace(settings.hashSize);
+        }
+
+        auto nodeCounts = std::vector<std::atomic<u64>>(rootMoves.size());
+        auto nextWorkItemIndex = std::atomic<usize>{};
+
+        const auto threadCount = std::clamp<usize>(settings.threadCount, 1, std::max<usize>(workItems.size(), 1));
+
+        {
+            auto threads = std::vector<std::jthread>{};
+            threads.reserve(threadCount);
+
+            for (auto threadIndex = 0ull; threadIndex < threadCount; threadIndex++) {
+                threads.emplace_back([&] {
+                    while (true) {
+                        const auto workItemIndex = nextWorkItemIndex++;
+
+                        if (workItemIndex >= workItems.size()) {
+                            break;
+                        }
+
+                        const auto& workItem = workItems[workItemIndex];
+                        const auto nodeCount = table ? perft(workItem.position, depth - workDepth, *table) : perft(workItem.position, depth - workDepth);
+
+                        nodeCounts[workItem.rootMoveIndex].fetch_add(nodeCount, std::memory_order_relaxed);
+                    }
+                });
+            }
+        }
+
+        for (auto moveIndex = 0ull; moveIndex < rootMoves.size(); moveIndex++) {
+            moveCounts.emplace_back(rootMoves[moveIndex], nodeCounts[moveIndex].load(std::memory_order_relaxed));
+        }
+
+        return moveCounts;
+    }
+}
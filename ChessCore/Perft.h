@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Position.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace ChessCore {
+
+    struct PerftMoveCount {
+        ChessMove move{};
+        u64 nodeCount{};
+    };
+
+    // A zero hash size runs without a table.
+    struct PerftSettings {
+        usize threadCount = 1;
+        usize hashSize = 0;
+    };
+
+    // Subtree node counts by Zobrist key and depth. Like TranspositionTable, each slot stores the key xor-ed with
+    // its data, so threads share the table without locks and a torn slot fails verification.
+    class PerftTable {
+    public:
+        explicit PerftTable(usize sizeInMegabytes);
+
+        bool probe(u64 key, u32 depth, u64& nodeCount) const;
+        void store(u64 key, u32 depth, u64 nodeCount);
+    private:
+        struct Slot {
+            std::atomic<u64> check{};
+            std::atomic<u64> data{};
+        };
+
+        std::unique_ptr<Slot[]> _slots{};
+        usize _slotCount{};
+    };
+
+    u64 perft(const Position& position, u32 depth);
+    u64 perft(const Position& position, u32 depth, PerftTable& table);
+
+    std::vector<PerftMoveCount> perftDivide(const Position& position, u32 depth);
+
+    // Splits the root moves, and the replies to them from depth 3 on, across a pool of threads that share one table.
+    std::vector<PerftMoveCount> perftDivide(const Position& position, u32 depth, const PerftSettings& settings);
+}
@@ -0,0 +1,407 @@
+#include "Pgn.h"
+#include "Fen.h"
+#include "San.h"
+
+#include <algorithm>
+#include <format>
+#include <stdexcept>
+#include <thread>
+
+namespace ChessCore {
+
+    static constexpr std::string_view Utf8ByteOrderMark = "\xEF\xBB\xBF";
+
+    static bool isPgnWhitespace(char character) {
+        return character == ' ' || character == '\t' || character == '\n' || character == '\r' || character == '\f' || character == '\v';
+    }
+
+    static bool isPgnTokenDelimiter(char character) {
+        return isPgnWhitespace(character) || character == '{' || character == '}' || character == '(' || character == ')'
+            || character == ';' || character == '$' || character == '[';
+    }
+
+    static bool isLineStart(std::string_view text, usize offset) {
+        return offset == 0 || text[offset - 1] == '\n';
+    }
+
+    static bool isBlankLine(std::string_view line) {
+        return std::ranges::all_of(line, isPgnWhitespace);
+    }
+
+    static bool isPreviousLineTagAt(std::string_view text, usize lineOffset) {
+        while (lineOffset > 0) {
+            const auto newlineOffset = lineOffset - 1;
+            const auto previousNewlineOffset = newlineOffset == 0 ? std::string_view::npos : text.rfind('\n', newlineOffset - 1);
+            const auto lineStart = previousNewlineOffset == std::string_view::npos ? 0 : previousNewlineOffset + 1;
+            const auto line = text.substr(lineStart, newlineOffset - lineStart);
+
+            if (!isBlankLine(line)) {
+                return line.front() == '[';
+            }
+
+            lineOffset = lineStart;
+        }
+
+        return false;
+    }
+
+    static std::string_view stripMoveNumber(std::string_view token) {
+        auto digitCount = 0ull;
+
+        while (digitCount < token.size() && token[digitCount] >= '0' && token[digitCount] <= '9') {
+            digitCount++;
+        }
+
+        if (digitCount == 0 || digitCount == token.size() || token[digitCount] != '.') {
+            return token;
+        }
+
+        token.remove_prefix(digitCount);
+
+        while (!token.empty() && token.front() == '.') {
+            token.remove_prefix(1);
+        }
+
+        return token;
+    }
+
+    std::string_view PgnGame::findTag(std::string_view name) const {
+        const auto tag = std::ranges::find(tags, name, &PgnTag::name);
+        return tag != tags.end() ? tag->value : std::string_view{};
+    }
+
+    bool PgnReader::readGame(PgnGame& game) {
+        if (_offset == 0 && _text.starts_with(Utf8ByteOrderMark)) {
+            _offset = Utf8ByteOrderMark.size();
+        }
+
+        game.tags.clear();
+        game.moves.clear();
+        game.startingPosition = Position::createStartingPosition();
+        game.result = PgnResultType::Unknown;
+        game.error = PgnErrorType::None;
+
+        _skipWhitespace();
+
+        if (_offset >= _text.size()) {
+            return false;
+        }
+
+        const auto gameOffset = _offset;
+
+        _readTags(game);
+
+        if (game.error == PgnErrorType::None) {
+            const auto fen = game.findTag("FEN");
+
+            if (!fen.empty() && parseFen(fen, game.startingPosition).error != FenParseErrorType::None) {
+                game.error = PgnErrorType::InvalidFen;
+            }
+        }
+
+        if (game.error == PgnErrorType::None) {
+            _readMovetext(game);
+        } else {
+            _skipToNextGame();
+        }
+
+        game.text = _text.substr(gameOffset, _offset - gameOffset);
+
+        return true;
+    }
+
+    void PgnReader::_skipWhitespace() {
+        while (_offset < _text.size()) {
+            const auto character = _text[_offset];
+
+            if (character == '%' && isLineStart(_text, _offset)) {
+                _skipLine();
+            } else if (isPgnWhitespace(character)) {
+                _offset++;
+            } else {
+                break;
+            }
+        }
+    }
+
+    void PgnReader::_skipLine() {
+        const auto lineEnd = _text.find('\n', _offset);
+        _offset = lineEnd == std::string_view::npos ? _text.size() : lineEnd + 1;
+    }
+
+    void PgnReader::_readTags(PgnGame& game) {
+        while (_offset < _text.size() && _text[_offset] == '[') {
+            _offset++;
+
+            const auto nameOffset = _offset;
+            while (_offset < _text.size() && !isPgnWhitespace(_text[_offset]) && _text[_offset] != '"' && _text[_offset] != ']') {
+                _offset++;
+            }
+
+            const auto name = _text.substr(nameOffset, _offset - nameOffset);
+
+            while (_offset < _text.size() && (_text[_offset] == ' ' || _text[_offset] == '\t')) {
+                _offset++;
+            }
+
+            if (name.empty() || _offset >= _text.size() || _text[_offset] != '"') {
+                game.error = PgnErrorType::InvalidTag;
+                return;
+            }
+
+            const auto valueOffset = ++_offset;
+            while (_offset < _text.size() && _text[_offset] != '"' && _text[_offset] != '\n') {
+                _offset += _text[_offset] == '\\' ? 2 : 1;
+            }
+
+            if (_offset >= _text.size() || _text[_offset] != '"') {
+                game.error = PgnErrorType::InvalidTag;
+                return;
+            }
+
+            game.tags.push_back({ name, _text.substr(valueOffset, _offset - valueOffset) });
+
+            _skipLine();
+            _skipWhitespace();
+        }
+    }
+
+    void PgnReader::_readMovetext(PgnGame& game) {
+        auto position = game.startingPosition;
+        auto variationDepth = 0;
+
+        while (true) {
+            _skipWhitespace();
+
+            if (_offset >= _text.size()) {
+                return;
+            }
+
+            const auto character = _text[_offset];
+
+            if (character == '[' && isLineStart(_text, _offset) && variationDepth == 0) {
+                return;
+            } else if (character == '{') {
+                const auto commentEnd = _text.find('}', _offset);
+                _offset = commentEnd == std::string_view::npos ? _text.size() : commentEnd + 1;
+                continue;
+            } else if (character == ';') {
+                _skipLine();
+                continue;
+            } else if (character == '(') {
+                variationDepth++;
+                _offset++;
+                continue;
+            } else if (character == ')') {
+                variationDepth = std::max(variationDepth - 1, 0);
+                _offset++;
+                continue;
+            }
+
+            const auto tokenOffset = _offset++;
+            while (_offset < _text.size() && !isPgnTokenDelimiter(_text[_offset])) {
+                _offset++;
+            }
+
+            const auto token = _text.substr(tokenOffset, _offset - tokenOffset);
+
+            if (variationDepth != 0 || character == '$') {
+                continue;
+            }
+
+            const auto result = mapPgnResultStringToPgnResultType(token);
+
+            if (result != PgnResultType::Unknown || token == "*") {
+                game.result = result;
+                return;
+            }
+
+            const auto san = stripMoveNumber(token);
+
+            if (san.empty() || game.error != PgnErrorType::None) {
+                continue;
+            }
+
+            auto move = ChessMove{};
+
+            if (!parseSan(position, san, move)) {
+                game.error = PgnErrorType::InvalidMove;
+                continue;
+            }
+
+            game.moves.push_back(move);
+            position.makeMove(move);
+        }
+    }
+
+    void PgnReader::_skipToNextGame() {
+        _offset = findPgnGameBoundary(_text, _offset);
+    }
+
+    usize findPgnGameBoundary(std::string_view text, usize offset) {
+        auto lineOffset = offset;
+
+        if (!isLineStart(text, lineOffset)) {
+            const auto lineEnd = text.find('\n', lineOffset);
+            lineOffset = lineEnd == std::string_view::npos ? text.size() : lineEnd + 1;
+        }
+
+        auto isPreviousLineTag = lineOffset < text.size() && isPreviousLineTagAt(text, lineOffset);
+
+        while (lineOffset < text.size()) {
+            const auto lineEnd = std::min(text.find('\n', lineOffset), text.size());
+            const auto line = text.substr(lineOffset, lineEnd - lineOffset);
+
+            if (!isBlankLine(line)) {
+                const auto isTag = line.front() == '[';
+
+                if (isTag && !isPreviousLineTag) {
+                    return lineOffset;
+                }
+
+                isPreviousLineTag = isTag;
+            }
+
+            lineOffset = lineEnd + 1;
+        }
+
+        return text.size();
+    }
+
+    static void accumulatePgnGame(PgnReadStatistics& statistics, const PgnGame& game) {
+        statistics.gameCount++;
+        statistics.moveCount += game.moves.size();
+
+        if (game.error != PgnErrorType::None) {
+            statistics.errorCount++;
+        }
+    }
+
+    PgnReadStatistics readPgnGames(std::string_view text, const PgnGameCallback& callback) {
+        auto statistics = PgnReadStatistics{};
+        auto reader = PgnReader{ text };
+        auto game = PgnGame{};
+
+        while (reader.readGame(game)) {
+            accumulatePgnGame(statistics, game);
+            callback(game);
+        }
+
+        return statistics;
+    }
+
+    PgnReadStatistics readPgnGamesInParallel(std::string_view text, usize threadCount, const PgnShardGameCallback& callback) {
+        threadCount = std::max<usize>(threadCount, 1);
+
+        auto shardOffsets = std::vector<usize>(threadCount + 1);
+        shardOffsets.back() = text.size();
+
+        for (auto shardIndex = 1ull; shardIndex < threadCount; shardIndex++) {
+            const auto boundary = findPgnGameBoundary(text, text.size() / threadCount * shardIndex);
+            shardOffsets[shardIndex] = std::max(boundary, shardOffsets[shardIndex - 1]);
+        }
+
+        auto shardStatistics = std::vector<PgnReadStatistics>(threadCount);
+
+        {
+            auto threads = std::vector<std::jthread>{};
+            threads.reserve(threadCount);
+
+            for (auto shardIndex = 0ull; shardIndex < threadCount; shardIndex++) {
+                const auto shardText = text.substr(shardOffsets[shardIndex], shardOffsets[shardIndex + 1] - shardOffsets[shardIndex]);
+
+                threads.emplace_back([shardText, shardIndex, &callback, &statistics = shardStatistics[shardIndex]] {
+                    statistics = readPgnGames(shardText, [shardIndex, &callback](const PgnGame& game) { callback(shardIndex, game); });
+                });
+            }
+        }
+
+        auto statistics = PgnReadStatistics{};
+
+        for (const auto& shard : shardStatistics) {
+            statistics.gameCount += shard.gameCount;
+            statistics.moveCount += shard.moveCount;
+            statistics.errorCount += shard.errorCount;
+        }
+
+        return statistics;
+    }
+
+    static void appendPgnToken(std::string& text, std::string_view token, usize& lineLength) {
+        if (lineLength != 0 && lineLength + 1 + token.size() > 80) {
+            text += '\n';
+            lineLength = 0;
+        } else if (lineLength != 0) {
+            text += ' ';
+            lineLength++;
+        }
+
+        text += token;
+        lineLength += token.size();
+    }
+
+    static void appendPgnTag(std::string& text, std::string_view name, std::string_view value) {
+        text += std::format("[{} \"{}\"]\n", name, value);
+    }
+
+    void writePgnGame(const PgnGame& game, std::string& text) {
+        for (const auto& tag : game.tags) {
+            appendPgnTag(text, tag.name, tag.value);
+        }
+
+        if (game.startingPosition != Position::createStartingPosition() && game.findTag("FEN").empty()) {
+            appendPgnTag(text, "SetUp", "1");
+            appendPgnTag(text, "FEN", convertPositionToFen(game.startingPosition));
+        }
+
+        text += '\n';
+
+        auto position = game.startingPosition;
+        auto lineLength = usize{};
+
+        for (auto moveIndex = 0ull; moveIndex < game.moves.size(); moveIndex++) {
+            const auto& move = game.moves[moveIndex];
+
+            if (position.getSideToMove() == ChessPieceColorType::White) {
+                appendPgnToken(text, std::format("{}.", position.getFullmoveNumber()), lineLength);
+            } else if (moveIndex == 0) {
+                appendPgnToken(text, std::format("{}...", position.getFullmoveNumber()), lineLength);
+            }
+
+            auto buffer = SanBuffer{};
+            appendPgnToken(text, writeSan(position, move, buffer), lineLength);
+
+            position.makeMove(move);
+        }
+
+        appendPgnToken(text, mapPgnResultTypeToString(game.result), lineLength);
+        text += "\n\n";
+    }
+
+    PgnResultType mapPgnResultStringToPgnResultType(std::string_view result) {
+        if (result == "1-0") {
+            return PgnResultType::WhiteWin;
+        } else if (result == "0-1") {
+            return PgnResultType::BlackWin;
+        } else if (result == "1/2-1/2") {
+            return PgnResultType::Draw;
+        } else {
+            return PgnResultType::Unknown;
+        }
+    }
+
+    std::string_view mapPgnResultTypeToString(PgnResultType type) {
+        switch (type) {
+        case PgnResultType::WhiteWin:
+            return "1-0";
+        case PgnResultType::BlackWin:
+            return "0-1";
+        case PgnResultType::Draw:
+            return "1/2-1/2";
+        case PgnResultType::Unknown:
+            return "*";
+        default:
+            throw std::runtime_error("Unreachable");
+        }
+    }
+}
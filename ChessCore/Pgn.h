@@ -0,0 +1,93 @@
+#pragma once
+
+#include "Position.h"
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ChessCore {
+
+    enum class PgnResultType : i16 {
+        Unknown,
+        WhiteWin,
+        BlackWin,
+        Draw,
+    };
+
+    enum class PgnErrorType : i16 {
+        None,
+        InvalidTag,
+        InvalidFen,
+        InvalidMove,
+    };
+
+    // Values are kept as written between the quotes, so \" and \\ escapes are not resolved. writePgnGame writes
+    // them back unchanged, which makes tags round-trip; values built in code must be escaped by the caller.
+    struct PgnTag {
+        std::string_view name{};
+        std::string_view value{};
+    };
+
+    // Views point into the source text; the vectors keep their capacity between games, so reading
+    // a database does not allocate per game or per token once they have grown.
+    struct PgnGame {
+        std::string_view text{};
+        std::vector<PgnTag> tags{};
+        Position startingPosition{};
+        std::vector<ChessMove> moves{};
+        PgnResultType result{};
+        PgnErrorType error{};
+
+        std::string_view findTag(std::string_view name) const;
+    };
+
+    class PgnReader {
+    public:
+        explicit PgnReader(std::string_view text) : _text(text) {}
+
+        // Reads the next game into game and returns false at the end of the text. Games with an error
+        // are still returned with the moves resolved before the error.
+        bool readGame(PgnGame& game);
+
+        usize getOffset() const {
+            return _offset;
+        }
+    private:
+        void _skipWhitespace();
+        void _skipLine();
+        void _readTags(PgnGame& game);
+        void _readMovetext(PgnGame& game);
+        void _skipToNextGame();
+
+        std::string_view _text{};
+        usize _offset{};
+    };
+
+    struct PgnReadStatistics {
+        usize gameCount{};
+        usize moveCount{};
+        usize errorCount{};
+    };
+
+    using PgnGameCallback = std::function<void(const PgnGame& game)>;
+    using PgnShardGameCallback = std::function<void(usize shardIndex, const PgnGame& game)>;
+
+    // Returns the offset of the first game that starts at or after offset.
+    usize findPgnGameBoundary(std::string_view text, usize offset);
+
+    PgnReadStatistics readPgnGames(std::string_view text, const PgnGameCallback& callback);
+
+    // Splits the text at game boundaries into one shard per thread. The callback is called
+    // concurrently from the worker threads and must synchronize any state it shares.
+    PgnReadStatistics readPgnGamesInParallel(std::string_view text, usize threadCount, const PgnShardGameCallback& callback);
+
+    // Appends the tags, the movetext in SAN wrapped at 80 columns and the result. SetUp and FEN tags are
+    // added when the game does not start from the standard position and the tags have none.
+    void writePgnGame(const PgnGame& game, std::string& text);
+
+    PgnResultType mapPgnResultStringToPgnResultType(std::string_view result);
+
+    std::string_view mapPgnResultTypeToString(PgnResultType type);
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Pandora/Pandora.h"
+
+#include <compare>
+
+namespace ChessCore {
+
+    enum class ChessPieceType : i16 {
+        None,
+        Queen,
+        Rook,
+        Bishop,
+        Knight,
+        Pawn,
+        King,
+    };
+
+    inline constexpr usize ChessPieceTypeCount = 7;
+
+    constexpr bool isSlidingPiece(ChessPieceType type) {
+        using enum ChessPieceType;
+        return type == Queen || type == Rook || type == Bishop;
+    }
+
+    enum class ChessPieceColorType : i16 {
+        None,
+        Black,
+        White
+    };
+
+    inline constexpr usize ChessPieceColorTypeCount = 3;
+
+    constexpr ChessPieceColorType mapColorToOpposite(ChessPieceColorType type) {
+        using enum ChessPieceColorType;
+        return type == Black ? White : Black;
+    }
+
+    struct ChessPiece {
+        ChessPieceType type{};
+        ChessPieceColorType color{};
+
+        auto operator<=>(const ChessPiece&) const = default;
+    };
+
+    namespace ChessPieces {
+
+        constexpr auto None = ChessPiece{ ChessPieceType::None, ChessPieceColorType::None };
+        constexpr auto QueenWhite = ChessPiece{ ChessPieceType::Queen, ChessPieceColorType::White };
+        constexpr auto QueenBlack = ChessPiece{ ChessPieceType::Queen, ChessPieceColorType::Black };
+        constexpr auto RookWhite = ChessPiece{ ChessPieceType::Rook, ChessPieceColorType::White };
+        constexpr auto RookBlack = ChessPiece{ ChessPieceType::Rook, ChessPieceColorType::Black };
+        constexpr auto BishopWhite = ChessPiece{ ChessPieceType::Bishop, ChessPieceColorType::White };
+        constexpr auto BishopBlack = ChessPiece{ ChessPieceType::Bishop, ChessPieceColorType::Black };
+        constexpr auto KnightWhite = ChessPiece{ ChessPieceType::Knight, ChessPieceColorType::White };
+        constexpr auto KnightBlack = ChessPiece{ ChessPieceType::Knight, ChessPieceColorType::Black };
+        constexpr auto PawnWhite = ChessPiece{ ChessPieceType::Pawn, ChessPieceColorType::White };
+        constexpr auto PawnBlack = ChessPiece{ ChessPieceType::Pawn, ChessPieceColorType::Black };
+        constexpr auto KingWhite = ChessPiece{ ChessPieceType::King, ChessPieceColorType::White };
+        constexpr auto KingBlack = ChessPiece{ ChessPieceType::King, ChessPieceColorType::Black };
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "MappedFile.h"
+#include "Position.h"
+
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+namespace ChessCore {
+
+    // Hashes the position with the Random64 table of the Polyglot book format, which every Polyglot book is keyed by.
+    u64 computePolyglotKey(const Position& position);
+
+    struct PolyglotBookMove {
+        ChessMove move{};
+        u16 weight{};
+    };
+
+    class PolyglotBook {
+    public:
+        explicit PolyglotBook(const std::filesystem::path& bookPath);
+
+        // Only legal moves are returned, so a key collision cannot produce an illegal book move.
+        void findMoves(const Position& position, std::vector<PolyglotBookMove>& moves) const;
+        std::vector<PolyglotBookMove> findMoves(const Position& position) const;
+
+        // Picks a move with probability proportional to its weight, randomValue selects the move.
+        std::optional<ChessMove> pickMove(const Position& position, u64 randomValue) const;
+
+        usize getEntryCount() const;
+    private:
+        MappedFile _file;
+    };
+}
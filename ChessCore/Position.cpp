@@ -0,0 +1,253 @@
+#include "Position.h"
+
+namespace ChessCore {
+
+    static constexpr auto CastlingRightsMaskTable = [] {
+        auto table = std::array<u8, BoardSquareCount>{};
+        table.fill(CastlingRights::All);
+
+        table[0] = static_cast<u8>(CastlingRights::All & ~CastlingRights::BlackQueenSide);
+        table[4] = static_cast<u8>(CastlingRights::All & ~(CastlingRights::BlackKingSide | CastlingRights::BlackQueenSide));
+        table[7] = static_cast<u8>(CastlingRights::All & ~CastlingRights::BlackKingSide);
+        table[56] = static_cast<u8>(CastlingRights::All & ~CastlingRights::WhiteQueenSide);
+        table[60] = static_cast<u8>(CastlingRights::All & ~(CastlingRights::WhiteKingSide | CastlingRights::WhiteQueenSide));
+        table[63] = static_cast<u8>(CastlingRights::All & ~CastlingRights::WhiteKingSide);
+
+        return table;
+    }();
+
+    static bool isPieceInDirection(const ChessBoard& board, usize squareIndex, DirectionType direction, ChessPiece piece) {
+        if (mapArrayIndexToSquaresToEdge(squareIndex, direction) == 0) {
+            return false;
+        }
+
+        const auto targetIndex = static_cast<int>(squareIndex) + mapDirectionTypeToArrayIndexOffset(direction);
+        return board[targetIndex] == piece;
+    }
+
+    static bool isEnemyPawnBeside(const ChessBoard& board, usize squareIndex, ChessPieceColorType enemyColor) {
+        const auto enemyPawn = ChessPiece{ ChessPieceType::Pawn, enemyColor };
+
+        return isPieceInDirection(board, squareIndex, DirectionType::Left, enemyPawn)
+            || isPieceInDirection(board, squareIndex, DirectionType::Right, enemyPawn);
+    }
+
+    Position Position::createStartingPosition() {
+        auto position = Position{};
+
+        position.setPiece(0, ChessPieces::RookBlack);
+        position.setPiece(1, ChessPieces::KnightBlack);
+        position.setPiece(2, ChessPieces::BishopBlack);
+        position.setPiece(3, ChessPieces::QueenBlack);
+        position.setPiece(4, ChessPieces::KingBlack);
+        position.setPiece(5, ChessPieces::BishopBlack);
+        position.setPiece(6, ChessPieces::KnightBlack);
+        position.setPiece(7, ChessPieces::RookBlack);
+
+        position.setPiece(56, ChessPieces::RookWhite);
+        position.setPiece(57, ChessPieces::KnightWhite);
+        position.setPiece(58, ChessPieces::BishopWhite);
+        position.setPiece(59, ChessPieces::QueenWhite);
+        position.setPiece(60, ChessPieces::KingWhite);
+        position.setPiece(61, ChessPieces::BishopWhite);
+        position.setPiece(62, ChessPieces::KnightWhite);
+        position.setPiece(63, ChessPieces::RookWhite);
+
+        for (auto file = 0ull; file < BoardSquareSize; file++) {
+            position.setPiece(8 + file, ChessPieces::PawnBlack);
+            position.setPiece(48 + file, ChessPieces::PawnWhite);
+        }
+
+        position.setCastlingRights(CastlingRights::All);
+
+        return position;
+    }
+
+    void Position::makeMove(const ChessMove& move) {
+        const auto movingPiece = _board[move.startingSquareIndex];
+        const auto capturedPiece = _board[move.targetSquareIndex];
+
+        _board[move.startingSquareIndex] = ChessPieces::None;
+        _board[move.targetSquareIndex] = movingPiece;
+
+        if (move.promotionType != ChessPieceType::None) {
+            _board[move.targetSquareIndex].type = move.promotionType;
+        }
+
+        _key ^= getZobristPieceKey(movingPiece, move.startingSquareIndex)
+            ^ getZobristPieceKey(capturedPiece, move.targetSquareIndex)
+            ^ getZobristPieceKey(_board[move.targetSquareIndex], move.targetSquareIndex);
+
+        if (move.isEnPassant) {
+            const auto captureDirection = _sideToMove == ChessPieceColorType::White ? DirectionType::Down : DirectionType::Up;
+            const auto capturedPawnIndex = static_cast<int>(move.targetSquareIndex) + mapDirectionTypeToArrayIndexOffset(captureDirection);
+
+            _key ^= getZobristPieceKey(_board[capturedPawnIndex], capturedPawnIndex);
+            _board[capturedPawnIndex] = ChessPieces::None;
+        }
+
+        if (move.isCastling) {
+            const auto isKingSide = move.targetSquareIndex > move.startingSquareIndex;
+
+            const auto rookStartingIndex = isKingSide ? move.startingSquareIndex + 3 : move.startingSquareIndex - 4;
+            const auto rookTargetIndex = isKingSide ? move.startingSquareIndex + 1 : move.startingSquareIndex - 1;
+
+            _board[rookTargetIndex] = _board[rookStartingIndex];
+            _board[rookStartingIndex] = ChessPieces::None;
+
+            _key ^= getZobristPieceKey(_board[rookTargetIndex], rookStartingIndex) ^ getZobristPieceKey(_board[rookTargetIndex], rookTargetIndex);
+        }
+
+        if (movingPiece.type == ChessPieceType::King) {
+            _kingSquareIndices[static_cast<usize>(movingPiece.color)] = move.targetSquareIndex;
+        }
+
+        _key ^= getZobristCastlingKey(_castlingRights) ^ getZobristEnPassantKey(_enPassantSquareIndex);
+
+        _castlingRights &= CastlingRightsMaskTable[move.startingSquareIndex] & CastlingRightsMaskTable[move.targetSquareIndex];
+        _enPassantSquareIndex = NoSquareIndex;
+
+        // The en passant square is only recorded when it can actually be used, so equal positions compare equal.
+        if (move.isDoubleMovement && isEnemyPawnBeside(_board, move.targetSquareIndex, mapColorToOpposite(_sideToMove))) {
+            _enPassantSquareIndex = static_cast<u8>((move.startingSquareIndex + move.targetSquareIndex) / 2);
+        }
+
+        _key ^= getZobristCastlingKey(_castlingRights) ^ getZobristEnPassantKey(_enPassantSquareIndex) ^ getZobristSideToMoveKey();
+
+        if (movingPiece.type == ChessPieceType::Pawn || capturedPiece != ChessPieces::None) {
+            _halfmoveClock = 0;
+        } else {
+            _halfmoveClock++;
+        }
+
+        if (_sideToMove == ChessPieceColorType::Black) {
+            _fullmoveNumber++;
+        }
+
+        _sideToMove = mapColorToOpposite(_sideToMove);
+    }
+
+    void Position::makeNullMove() {
+        _key ^= getZobristEnPassantKey(_enPassantSquareIndex) ^ getZobristSideToMoveKey();
+
+        _enPassantSquareIndex = NoSquareIndex;
+        _halfmoveClock = 0;
+
+        if (_sideToMove == ChessPieceColorType::Black) {
+            _fullmoveNumber++;
+        }
+
+        _sideToMove = mapColorToOpposite(_sideToMove);
+    }
+
+    bool Position::isSquareAttacked(usize squareIndex, ChessPieceColorType attackerColor) const {
+        using enum DirectionType;
+
+        const auto attackerPawn = ChessPiece{ ChessPieceType::Pawn, attackerColor };
+        const auto pawnLeftDirection = attackerColor == ChessPieceColorType::White ? DownLeft : UpLeft;
+        const auto pawnRightDirection = attackerColor == ChessPieceColorType::White ? DownRight : UpRight;
+
+        if (isPieceInDirection(_board, squareIndex, pawnLeftDirection, attackerPawn) || isPieceInDirection(_board, squareIndex, pawnRightDirection, attackerPawn)) {
+            return true;
+        }
+
+        const auto attackerKnight = ChessPiece{ ChessPieceType::Knight, attackerColor };
+        const auto& knightTargets = getKnightTargets(squareIndex);
+
+        for (auto targetIndex = 0; targetIndex < knightTargets.count; targetIndex++) {
+            if (_board[knightTargets.squareIndices[targetIndex]] == attackerKnight) {
+                return true;
+            }
+        }
+
+        const auto attackerKing = ChessPiece{ ChessPieceType::King, attackerColor };
+        const auto& kingTargets = getKingTargets(squareIndex);
+
+        for (auto targetIndex = 0; targetIndex < kingTargets.count; targetIndex++) {
+            if (_board[kingTargets.squareIndices[targetIndex]] == attackerKing) {
+                return true;
+            }
+        }
+
+        for (auto directionIndex = 0ull; directionIndex < DirectionTypeCount; directionIndex++) {
+            const auto direction = static_cast<DirectionType>(directionIndex);
+
+            const auto directionArrayIndexOffset = mapDirectionTypeToArrayIndexOffset(direction);
+            const auto squaresInDirection = mapArrayIndexToSquaresToEdge(squareIndex, direction);
+
+            auto targetSquareIndex = static_cast<int>(squareIndex);
+
+            for (auto directionSquareIndex = 0ull; directionSquareIndex < squaresInDirection; directionSquareIndex++) {
+                targetSquareIndex += directionArrayIndexOffset;
+
+                const auto targetSquare = _board[targetSquareIndex];
+                if (targetSquare == ChessPieces::None) {
+                    continue;
+                }
+
+                if (targetSquare.color == attackerColor && isDirectionAvailableForChessPieceType(direction, targetSquare.type) && isSlidingPiece(targetSquare.type)) {
+                    return true;
+                }
+
+                break;
+            }
+        }
+
+        return false;
+    }
+
+    bool Position::isKingUnderCheck(ChessPieceColorType kingColor) const {
+        const auto kingSquareIndex = getKingSquareIndex(kingColor);
+
+        if (kingSquareIndex == NoSquareIndex) {
+            return false;
+        }
+
+        return isSquareAttacked(kingSquareIndex, mapColorToOpposite(kingColor));
+    }
+
+    bool Position::isKingUnderCheck() const {
+        return isKingUnderCheck(_sideToMove);
+    }
+
+    void Position::setPiece(usize squareIndex, ChessPiece piece) {
+        const auto previousPiece = _board[squareIndex];
+
+        if (previousPiece.type == ChessPieceType::King && getKingSquareIndex(previousPiece.color) == squareIndex) {
+            _kingSquareIndices[static_cast<usize>(previousPiece.color)] = NoSquareIndex;
+        }
+
+        _board[squareIndex] = piece;
+        _key ^= getZobristPieceKey(previousPiece, squareIndex) ^ getZobristPieceKey(piece, squareIndex);
+
+        if (piece.type == ChessPieceType::King) {
+            _kingSquareIndices[static_cast<usize>(piece.color)] = static_cast<u8>(squareIndex);
+        }
+    }
+
+    void Position::setSideToMove(ChessPieceColorType color) {
+        if ((_sideToMove == ChessPieceColorType::Black) != (color == ChessPieceColorType::Black)) {
+            _key ^= getZobristSideToMoveKey();
+        }
+
+        _sideToMove = color;
+    }
+
+    void Position::setCastlingRights(u8 castlingRights) {
+        _key ^= getZobristCastlingKey(_castlingRights) ^ getZobristCastlingKey(castlingRights);
+        _castlingRights = castlingRights;
+    }
+
+    void Position::setEnPassantSquareIndex(u8 squareIndex) {
+        _key ^= getZobristEnPassantKey(_enPassantSquareIndex) ^ getZobristEnPassantKey(squareIndex);
+        _enPassantSquareIndex = squareIndex;
+    }
+
+    void Position::setHalfmoveClock(u32 halfmoveClock) {
+        _halfmoveClock = halfmoveClock;
+    }
+
+    void Position::setFullmoveNumber(u32 fullmoveNumber) {
+        _fullmoveNumber = fullmoveNumber;
+    }
+}
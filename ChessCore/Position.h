@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Board.h"
+#include "Move.h"
+#include "Zobrist.h"
+
+namespace ChessCore {
+
+    namespace CastlingRights {
+
+        inline constexpr u8 None = 0;
+        inline constexpr u8 WhiteKingSide = 1;
+        inline constexpr u8 WhiteQueenSide = 2;
+        inline constexpr u8 BlackKingSide = 4;
+        inline constexpr u8 BlackQueenSide = 8;
+        inline constexpr u8 All = WhiteKingSide | WhiteQueenSide | BlackKingSide | BlackQueenSide;
+    }
+
+    class Position {
+    public:
+        static Position createStartingPosition();
+
+        void makeMove(const ChessMove& move);
+
+        // Passes the turn for null move pruning. The halfmove clock restarts, so no repetition is found across it.
+        void makeNullMove();
+
+        bool isSquareAttacked(usize squareIndex, ChessPieceColorType attackerColor) const;
+        bool isKingUnderCheck(ChessPieceColorType kingColor) const;
+        bool isKingUnderCheck() const;
+
+        void setPiece(usize squareIndex, ChessPiece piece);
+        void setSideToMove(ChessPieceColorType color);
+        void setCastlingRights(u8 castlingRights);
+        void setEnPassantSquareIndex(u8 squareIndex);
+        void setHalfmoveClock(u32 halfmoveClock);
+        void setFullmoveNumber(u32 fullmoveNumber);
+
+        ChessPiece getPiece(usize squareIndex) const {
+            return _board[squareIndex];
+        }
+
+        const ChessBoard& getBoard() const {
+            return _board;
+        }
+
+        ChessPieceColorType getSideToMove() const {
+            return _sideToMove;
+        }
+
+        u8 getCastlingRights() const {
+            return _castlingRights;
+        }
+
+        u8 getEnPassantSquareIndex() const {
+            return _enPassantSquareIndex;
+        }
+
+        u32 getHalfmoveClock() const {
+            return _halfmoveClock;
+        }
+
+        u32 getFullmoveNumber() const {
+            return _fullmoveNumber;
+        }
+
+        u8 getKingSquareIndex(ChessPieceColorType color) const {
+            return _kingSquareIndices[static_cast<usize>(color)];
+        }
+
+        // Zobrist key of the pieces, side to move, castling rights and en passant file, updated incrementally.
+        u64 getKey() const {
+            return _key;
+        }
+
+        bool operator==(const Position&) const = default;
+    private:
+        ChessBoard _board{};
+        std::array<u8, ChessPieceColorTypeCount> _kingSquareIndices{ NoSquareIndex, NoSquareIndex, NoSquareIndex };
+
+        ChessPieceColorType _sideToMove = ChessPieceColorType::White;
+        u8 _castlingRights{};
+        u8 _enPassantSquareIndex = NoSquareIndex;
+
+        u32 _halfmoveClock{};
+        u32 _fullmoveNumber = 1;
+
+        u64 _key{};
+    };
+}
@@ -0,0 +1,326 @@
+#include "PositionIndex.h"
+
+#include "Pgn.h"
+
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+namespace ChessCore {
+
+    // "PIDX" followed by the format version, the game, key and block counts.
+    static constexpr u32 PositionIndexMagic = 0x58444950;
+    static constexpr u32 PositionIndexVersion = 1;
+    static constexpr usize PositionIndexHeaderSize = 32;
+
+    static constexpr usize PositionIndexBlockKeyCount = 256;
+
+    struct PositionIndexRecord {
+        u64 key{};
+        u32 gameIndex{};
+        u16 ply{};
+
+        auto operator<=>(const PositionIndexRecord&) const = default;
+    };
+
+    static u64 readLittleEndian(const u8* bytes, usize byteCount) {
+        auto value = u64{};
+
+        for (auto byteIndex = 0ull; byteIndex < byteCount; byteIndex++) {
+            value |= static_cast<u64>(bytes[byteIndex]) << (byteIndex * 8);
+        }
+
+        return value;
+    }
+
+    static void appendLittleEndian(std::vector<u8>& bytes, u64 value, usize byteCount) {
+        for (auto byteIndex = 0ull; byteIndex < byteCount; byteIndex++) {
+            bytes.push_back(static_cast<u8>(value >> (byteIndex * 8)));
+        }
+    }
+
+    // Seven bits per byte, the high bit is set on every byte but the last.
+    static void appendVarint(std::vector<u8>& bytes, u64 value) {
+        while (value >= 0x80) {
+            bytes.push_back(static_cast<u8>(value | 0x80));
+            value >>= 7;
+        }
+
+        bytes.push_back(static_cast<u8>(value));
+    }
+
+    static u64 readVarint(const u8*& bytes) {
+        auto value = u64{};
+        auto shift = 0;
+
+        while (true) {
+            const auto byte = *bytes++;
+            value |= static_cast<u64>(byte & 0x7F) << shift;
+
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+
+            shift += 7;
+        }
+    }
+
+    // The game index delta is written first; within the same game the ply is a delta as well.
+    static void appendPostings(std::vector<u8>& bytes, std::span<const PositionIndexRecord> records) {
+        auto previousGameIndex = u32{};
+        auto previousPly = u16{};
+
+        for (const auto& record : records) {
+            const auto gameDelta = record.gameIndex - previousGameIndex;
+
+            appendVarint(bytes, gameDelta);
+            appendVarint(bytes, gameDelta == 0 ? record.ply - previousPly : record.ply);
+
+            previousGameIndex = record.gameIndex;
+            previousPly = record.ply;
+        }
+    }
+
+    static void sortInParallel(std::vector<PositionIndexRecord>& records, usize threadCount) {
+        auto chunkOffsets = std::vector<usize>(threadCount + 1);
+
+        for (auto chunkIndex = 0ull; chunkIndex <= threadCount; chunkIndex++) {
+            chunkOffsets[chunkIndex] = records.size() * chunkIndex / threadCount;
+        }
+
+        {
+            auto threads = std::vector<std::jthread>{};
+            threads.reserve(threadCount);
+
+            for (auto chunkIndex = 0ull; chunkIndex < threadCount; chunkIndex++) {
+                threads.emplace_back([&records, begin = chunkOffsets[chunkIndex], end = chunkOffsets[chunkIndex + 1]] {
+                    std::sort(records.begin() + begin, records.begin() + end);
+                });
+            }
+        }
+
+        // Neighbouring chunks are merged pairwise until a single sorted run remains.
+        for (auto width = 1ull; width < threadCount; width *= 2) {
+            for (auto chunkIndex = 0ull; chunkIndex + width < threadCount; chunkIndex += width * 2) {
+                const auto middle = chunkOffsets[chunkIndex + width];
+                const auto end = chunkOffsets[std::min<usize>(chunkIndex + width * 2, threadCount)];
+
+                std::inplace_merge(records.begin() + chunkOffsets[chunkIndex], records.begin() + middle, records.begin() + end);
+            }
+        }
+    }
+
+    PositionIndexBuildStatistics buildPositionIndex(std::string_view pgnText, const std::filesystem::path& path, usize threadCount) {
+        threadCount = std::max<usize>(threadCount, 1);
+
+        auto shardRecords = std::vector<std::vector<PositionIndexRecord>>(threadCount);
+        auto shardGameOffsets = std::vector<std::vector<u64>>(threadCount);
+
+        // Games are numbered within their shard first and renumbered once the shard sizes are known.
+        const auto readStatistics = readPgnGamesInParallel(pgnText, threadCount, [&](usize shardIndex, const PgnGame& game) {
+            auto& records = shardRecords[shardIndex];
+            auto& gameOffsets = shardGameOffsets[shardIndex];
+
+            const auto gameIndex = static_cast<u32>(gameOffsets.size());
+            gameOffsets.push_back(static_cast<u64>(game.text.data() - pgnText.data()));
+
+            auto position = game.startingPosition;
+            records.push_back({ position.getKey(), gameIndex, 0 });
+
+            const auto plyCount = std::min<usize>(game.moves.size(), std::numeric_limits<u16>::max());
+
+            for (auto plyIndex = 0ull; plyIndex < plyCount; plyIndex++) {
+                position.makeMove(game.moves[plyIndex]);
+                records.push_back({ position.getKey(), gameIndex, static_cast<u16>(plyIndex + 1) });
+            }
+        });
+
+        auto records = std::vector<PositionIndexRecord>{};
+        auto gameOffsets = std::vector<u64>{};
+
+        for (auto shardIndex = 0ull; shardIndex < threadCount; shardIndex++) {
+            const auto firstGameIndex = static_cast<u32>(gameOffsets.size());
+
+            for (auto record : shardRecords[shardIndex]) {
+                record.gameIndex += firstGameIndex;
+                records.push_back(record);
+            }
+
+            gameOffsets.insert(gameOffsets.end(), shardGameOffsets[shardIndex].begin(), shardGameOffsets[shardIndex].end());
+            shardRecords[shardIndex] = {};
+        }
+
+        sortInParallel(records, threadCount);
+
+        auto blockFirstKeys = std::vector<u64>{};
+        auto blockOffsets = std::vector<u64>{};
+        auto blockBytes = std::vector<u8>{};
+        auto keyCount = 0ull;
+
+        for (auto recordIndex = 0ull; recordIndex < records.size();) {
+            const auto key = records[recordIndex].key;
+
+            auto endIndex = recordIndex;
+            while (endIndex < records.size() && records[endIndex].key == key) {
+                endIndex++;
+            }
+
+            if (keyCount % PositionIndexBlockKeyCount == 0) {
+                blockFirstKeys.push_back(key);
+                blockOffsets.push_back(blockBytes.size());
+            }
+
+            auto postings = std::vector<u8>{};
+            appendPostings(postings, std::span{ records }.subspan(recordIndex, endIndex - recordIndex));
+
+            appendLittleEndian(blockBytes, key, sizeof(u64));
+            appendVarint(blockBytes, endIndex - recordIndex);
+            appendVarint(blockBytes, postings.size());
+            blockBytes.insert(blockBytes.end(), postings.begin(), postings.end());
+
+            keyCount++;
+            recordIndex = endIndex;
+        }
+
+        blockOffsets.push_back(blockBytes.size());
+
+        const auto blockCount = blockFirstKeys.size();
+        const auto blockDataOffset = PositionIndexHeaderSize + (gameOffsets.size() + blockCount + blockOffsets.size()) * sizeof(u64);
+
+        auto bytes = std::vector<u8>{};
+        bytes.reserve(blockDataOffset);
+
+        appendLittleEndian(bytes, PositionIndexMagic, sizeof(u32));
+        appendLittleEndian(bytes, PositionIndexVersion, sizeof(u32));
+        appendLittleEndian(bytes, gameOffsets.size(), sizeof(u64));
+        appendLittleEndian(bytes, keyCount, sizeof(u64));
+        appendLittleEndian(bytes, blockCount, sizeof(u64));
+
+        for (const auto offset : gameOffsets) {
+            appendLittleEndian(bytes, offset, sizeof(u64));
+        }
+
+        for (const auto key : blockFirstKeys) {
+            appendLittleEndian(bytes, key, sizeof(u64));
+        }
+
+        // Block offsets are absolute, so a query reads its block without adding a base.
+        for (const auto offset : blockOffsets) {
+            appendLittleEndian(bytes, blockDataOffset + offset, sizeof(u64));
+        }
+
+        auto file = std::ofstream{ path, std::ios::binary | std::ios::trunc };
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        file.write(reinterpret_cast<const char*>(blockBytes.data()), static_cast<std::streamsize>(blockBytes.size()));
+
+        if (!file) {
+            throw std::runtime_error(std::format("Position index {} could not be written", path.string()));
+        }
+
+        return { readStatistics.gameCount, readStatistics.errorCount, keyCount, records.size(), bytes.size() + blockBytes.size() };
+    }
+
+    PositionIndex::PositionIndex(const std::filesystem::path& path) : _file(path, MappedFileAccessType::Random) {
+        const auto bytes = _file.getBytes();
+
+        if (bytes.size() < PositionIndexHeaderSize || readLittleEndian(bytes.data(), sizeof(u32)) != PositionIndexMagic) {
+            throw std::runtime_error(std::format("File {} is not a position index", path.string()));
+        }
+
+        if (readLittleEndian(bytes.data() + 4, sizeof(u32)) != PositionIndexVersion) {
+            throw std::runtime_error(std::format("Position index {} has an unsupported version", path.string()));
+        }
+
+        const auto gameCount = readLittleEndian(bytes.data() + 8, sizeof(u64));
+        const auto blockCount = readLittleEndian(bytes.data() + 24, sizeof(u64));
+
+        _keyCount = readLittleEndian(bytes.data() + 16, sizeof(u64));
+
+        const auto directorySize = (gameCount + blockCount * 2 + 1) * sizeof(u64);
+
+        if (bytes.size() < PositionIndexHeaderSize + directorySize) {
+            throw std::runtime_error(std::format("Position index {} is truncated", path.string()));
+        }
+
+        _gameOffsets = bytes.subspan(PositionIndexHeaderSize, gameCount * sizeof(u64));
+        _blockFirstKeys = bytes.subspan(PositionIndexHeaderSize + _gameOffsets.size(), blockCount * sizeof(u64));
+        _blockOffsets = bytes.subspan(PositionIndexHeaderSize + _gameOffsets.size() + _blockFirstKeys.size(), (blockCount + 1) * sizeof(u64));
+    }
+
+    void PositionIndex::findEntries(u64 key, std::vector<PositionIndexEntry>& entries) const {
+        entries.clear();
+
+        const auto blockCount = _blockFirstKeys.size() / sizeof(u64);
+
+        // Binary search for the last block whose first key is not greater than the key.
+        auto low = 0ull;
+        auto high = blockCount;
+
+        while (low < high) {
+            const auto middle = (low + high) / 2;
+
+            if (readLittleEndian(_blockFirstKeys.data() + middle * sizeof(u64), sizeof(u64)) <= key) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+
+        if (low == 0) {
+            return;
+        }
+
+        const auto blockIndex = low - 1;
+        const auto* bytes = _file.getBytes().data();
+        const auto* cursor = bytes + readLittleEndian(_blockOffsets.data() + blockIndex * sizeof(u64), sizeof(u64));
+        const auto* blockEnd = bytes + readLittleEndian(_blockOffsets.data() + (blockIndex + 1) * sizeof(u64), sizeof(u64));
+
+        while (cursor < blockEnd) {
+            const auto entryKey = readLittleEndian(cursor, sizeof(u64));
+            cursor += sizeof(u64);
+
+            const auto entryCount = readVarint(cursor);
+            const auto postingSize = readVarint(cursor);
+
+            if (entryKey > key) {
+                return;
+            }
+
+            if (entryKey < key) {
+                cursor += postingSize;
+                continue;
+            }
+
+            entries.reserve(entryCount);
+
+            auto gameIndex = u32{};
+            auto ply = u16{};
+
+            for (auto entryIndex = 0ull; entryIndex < entryCount; entryIndex++) {
+                const auto gameDelta = static_cast<u32>(readVarint(cursor));
+                const auto plyValue = static_cast<u16>(readVarint(cursor));
+
+                gameIndex += gameDelta;
+                ply = gameDelta == 0 ? static_cast<u16>(ply + plyValue) : plyValue;
+
+                entries.push_back({ gameIndex, ply });
+            }
+
+            return;
+        }
+    }
+
+    std::vector<PositionIndexEntry> PositionIndex::findEntries(const Position& position) const {
+        auto entries = std::vector<PositionIndexEntry>{};
+        findEntries(position.getKey(), entries);
+
+        return entries;
+    }
+
+    u64 PositionIndex::getGameOffset(usize gameIndex) const {
+        return readLittleEndian(_gameOffsets.data() + gameIndex * sizeof(u64), sizeof(u64));
+    }
+}
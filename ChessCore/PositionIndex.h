@@ -0,0 +1,60 @@
+#pragma once
+
+#include "MappedFile.h"
+#include "Position.h"
+
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace ChessCore {
+
+    // Games are numbered in the order they appear in the PGN the index was built from.
+    struct PositionIndexEntry {
+        u32 gameIndex{};
+        u16 ply{};
+
+        bool operator==(const PositionIndexEntry&) const = default;
+    };
+
+    struct PositionIndexBuildStatistics {
+        usize gameCount{};
+        usize errorCount{};
+        usize keyCount{};
+        usize entryCount{};
+        usize fileSize{};
+    };
+
+    // Reads the games in parallel and writes every position they reach, keyed by its Zobrist key. Keys are stored
+    // sorted in blocks with a directory of the first key of each block, and the game and ply lists of each key are
+    // delta and variable-length encoded.
+    PositionIndexBuildStatistics buildPositionIndex(std::string_view pgnText, const std::filesystem::path& path, usize threadCount);
+
+    class PositionIndex {
+    public:
+        explicit PositionIndex(const std::filesystem::path& path);
+
+        // Entries are sorted by game and ply.
+        void findEntries(u64 key, std::vector<PositionIndexEntry>& entries) const;
+        std::vector<PositionIndexEntry> findEntries(const Position& position) const;
+
+        usize getGameCount() const {
+            return _gameOffsets.size() / sizeof(u64);
+        }
+
+        usize getKeyCount() const {
+            return _keyCount;
+        }
+
+        // Byte offset of the game in the PGN text the index was built from.
+        u64 getGameOffset(usize gameIndex) const;
+    private:
+        MappedFile _file;
+        usize _keyCount{};
+
+        std::span<const u8> _gameOffsets{};
+        std::span<const u8> _blockFirstKeys{};
+        std::span<const u8> _blockOffsets{};
+    };
+}
@@ -0,0 +1,130 @@
+#include "Review.h"
+
+#include "Search.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace ChessCore {
+
+    // Beyond this a position is lost or won either way, so a slower mate or a smaller winning margin is not a mistake.
+    static constexpr i32 ReviewScoreLimit = 1000;
+
+    static i32 clampReviewScore(i32 score) {
+        return std::clamp(score, -ReviewScoreLimit, ReviewScoreLimit);
+    }
+
+    std::vector<ReviewedMove> reviewGame(const Position& startingPosition, std::span<const ChessMove> moves, const ReviewSettings& settings,
+        std::stop_token stopToken) {
+        auto positions = std::vector<Position>{ startingPosition };
+        auto keys = std::vector<u64>{};
+
+        for (const auto& move : moves) {
+            keys.push_back(positions.back().getKey());
+            positions.push_back(positions.back());
+            positions.back().makeMove(move);
+        }
+
+        auto results = std::vector<SearchResult>(positions.size());
+        auto transpositionTable = TranspositionTable{ settings.hashSize };
+        auto nextPositionCount = std::atomic<usize>{};
+
+        const auto limits = SearchLimits{ settings.depth };
+        const auto threadCount = std::clamp<usize>(settings.threadCount, 1, positions.size());
+
+        {
+            auto threads = std::vector<std::jthread>{};
+            threads.reserve(threadCount);
+
+            for (auto threadIndex = 0ull; threadIndex < threadCount; threadIndex++) {
+                threads.emplace_back([&] {
+                    auto searcher = Searcher{ transpositionTable };
+                    const auto stopCallback = std::stop_callback{ stopToken, [&searcher] { searcher.stop(); } };
+
+                    // A search clears earlier stop requests when it starts, so one that arrives just then is caught
+                    // after the next iteration.
+                    const auto iterationCallback = SearchIterationCallback{ [&searcher, &stopToken](const SearchResult&) {
+                        if (stopToken.stop_requested()) {
+                            searcher.stop();
+                        }
+                    } };
+
+                    // The last positions are searched first, so their table entries are there when the searches of
+                    // earlier positions reach them.
+                    while (!stopToken.stop_requested()) {
+                        const auto positionCount = nextPositionCount++;
+
+                        if (positionCount >= positions.size()) {
+                            break;
+                        }
+
+                        const auto positionIndex = positions.size() - 1 - positionCount;
+                        results[positionIndex] = searcher.search(positions[positionIndex], limits, std::span{ keys }.first(positionIndex), iterationCallback);
+                    }
+                });
+            }
+        }
+
+        if (stopToken.stop_requested()) {
+            return {};
+        }
+
+        auto reviewedMoves = std::vector<ReviewedMove>{};
+        reviewedMoves.reserve(moves.size());
+
+        for (auto moveIndex = 0ull; moveIndex < moves.size(); moveIndex++) {
+            const auto& before = results[moveIndex];
+            const auto& after = results[moveIndex + 1];
+
+            auto reviewedMove = ReviewedMove{ moves[moveIndex] };
+            reviewedMove.bestMove = before.bestMove.value_or(moves[moveIndex]);
+            reviewedMove.bestScore = before.score;
+            reviewedMove.playedScore = -after.score;
+
+            if (reviewedMove.bestMove != reviewedMove.move) {
+                reviewedMove.scoreLoss = std::max(0, clampReviewScore(reviewedMove.bestScore) - clampReviewScore(reviewedMove.playedScore));
+                reviewedMove.classification = classifyScoreLoss(reviewedMove.scoreLoss);
+            }
+
+            reviewedMoves.push_back(reviewedMove);
+        }
+
+        return reviewedMoves;
+    }
+
+    MoveClassificationType classifyScoreLoss(i32 scoreLoss) {
+        using enum MoveClassificationType;
+
+        if (scoreLoss <= 10) {
+            return Best;
+        }
+
+        if (scoreLoss <= 50) {
+            return Good;
+        }
+
+        if (scoreLoss <= 100) {
+            return Inaccuracy;
+        }
+
+        return scoreLoss <= 250 ? Mistake : Blunder;
+    }
+
+    std::string_view mapMoveClassificationTypeToString(MoveClassificationType type) {
+        switch (type) {
+        case MoveClassificationType::Best:
+            return "best";
+        case MoveClassificationType::Good:
+            return "good";
+        case MoveClassificationType::Inaccuracy:
+            return "inaccuracy";
+        case MoveClassificationType::Mistake:
+            return "mistake";
+        case MoveClassificationType::Blunder:
+            return "blunder";
+        default:
+            return "unknown";
+        }
+    }
+}
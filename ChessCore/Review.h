@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Position.h"
+
+#include <span>
+#include <stop_token>
+#include <string_view>
+#include <vector>
+
+namespace ChessCore {
+
+    enum class MoveClassificationType : i16 {
+        Best,
+        Good,
+        Inaccuracy,
+        Mistake,
+        Blunder,
+    };
+
+    inline constexpr usize MoveClassificationTypeCount = 5;
+
+    // Scores are in centipawns from the point of view of the player who made the move.
+    struct ReviewedMove {
+        ChessMove move{};
+        ChessMove bestMove{};
+        i32 bestScore{};
+        i32 playedScore{};
+        i32 scoreLoss{};
+        MoveClassificationType classification{};
+    };
+
+    struct ReviewSettings {
+        u32 depth = 6;
+        usize threadCount = 1;
+        usize hashSize = 64;
+    };
+
+    // Searches every position of the game to a fixed depth on a pool of threads that share one transposition table,
+    // then compares the score of each played move with the best score of the position before it. A stop request
+    // stops the running searches and returns no moves.
+    std::vector<ReviewedMove> reviewGame(const Position& startingPosition, std::span<const ChessMove> moves, const ReviewSettings& settings,
+        std::stop_token stopToken = {});
+
+    MoveClassificationType classifyScoreLoss(i32 scoreLoss);
+
+    std::string_view mapMoveClassificationTypeToString(MoveClassificationType type);
+}
@@ -0,0 +1,340 @@
+#include "San.h"
+#include "MoveGen.h"
+
+#include <format>
+#include <stdexcept>
+
+namespace ChessCore {
+
+    static constexpr std::string_view SanPieceCharacters = " QRBNPK";
+
+    static ChessPieceType mapSanCharacterToChessPieceType(char character) {
+        switch (character) {
+        case 'Q':
+            return ChessPieceType::Queen;
+        case 'R':
+            return ChessPieceType::Rook;
+        case 'B':
+            return ChessPieceType::Bishop;
+        case 'N':
+            return ChessPieceType::Knight;
+        case 'K':
+            return ChessPieceType::King;
+        default:
+            return ChessPieceType::None;
+        }
+    }
+
+    static bool isSanFile(char character) {
+        return character >= 'a' && character <= 'h';
+    }
+
+    static bool isSanRank(char character) {
+        return character >= '1' && character <= '8';
+    }
+
+    static bool isSanSuffix(char character) {
+        return character == '+' || character == '#' || character == '!' || character == '?';
+    }
+
+    static bool parseSanCastling(const Position& position, std::string_view san, ChessMove& move) {
+        const auto isQueenSide = san == "O-O-O" || san == "0-0-0";
+        const auto isKingSide = san == "O-O" || san == "0-0";
+
+        if (!isQueenSide && !isKingSide) {
+            return false;
+        }
+
+        auto moves = MoveList{};
+        computePseudoLegalMoves(position, moves);
+
+        for (const auto& candidate : moves) {
+            if (!candidate.isCastling || (candidate.targetSquareIndex > candidate.startingSquareIndex) != isKingSide) {
+                continue;
+            }
+
+            if (isMoveLegal(position, candidate)) {
+                move = candidate;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // SAN names the target square, so candidates are found by walking back from the target to the pieces
+    // that can reach it instead of generating every move in the position.
+    static void computePieceSanCandidates(const Position& position, usize targetSquareIndex, ChessPieceType pieceType, MoveList& candidates) {
+        const auto piece = ChessPiece{ pieceType, position.getSideToMove() };
+        const auto targetIndex = static_cast<u8>(targetSquareIndex);
+
+        if (pieceType == ChessPieceType::Knight || pieceType == ChessPieceType::King) {
+            const auto& targets = pieceType == ChessPieceType::Knight ? getKnightTargets(targetSquareIndex) : getKingTargets(targetSquareIndex);
+
+            for (auto index = 0; index < targets.count; index++) {
+                if (position.getPiece(targets.squareIndices[index]) == piece) {
+                    candidates.push({ targets.squareIndices[index], targetIndex });
+                }
+            }
+
+            return;
+        }
+
+        for (auto directionIndex = 0ull; directionIndex < DirectionTypeCount; directionIndex++) {
+            const auto direction = static_cast<DirectionType>(directionIndex);
+
+            if (!isDirectionAvailableForChessPieceType(direction, pieceType)) {
+                continue;
+            }
+
+            const auto directionArrayIndexOffset = mapDirectionTypeToArrayIndexOffset(direction);
+            const auto squaresInDirection = mapArrayIndexToSquaresToEdge(targetSquareIndex, direction);
+
+            auto squareIndex = static_cast<int>(targetSquareIndex);
+
+            for (auto directionSquareIndex = 0ull; directionSquareIndex < squaresInDirection; directionSquareIndex++) {
+                squareIndex += directionArrayIndexOffset;
+
+                const auto squarePiece = position.getPiece(squareIndex);
+                if (squarePiece == ChessPieces::None) {
+                    continue;
+                }
+
+                if (squarePiece == piece) {
+                    candidates.push({ static_cast<u8>(squareIndex), targetIndex });
+                }
+
+                break;
+            }
+        }
+    }
+
+    static void computePawnSanCandidates(const Position& position, usize targetSquareIndex, usize startingFile, ChessPieceType promotionType, MoveList& candidates) {
+        const auto color = position.getSideToMove();
+        const auto pawn = ChessPiece{ ChessPieceType::Pawn, color };
+        const auto targetRank = getSquareRank(targetSquareIndex);
+        const auto promotionRank = color == ChessPieceColorType::White ? BoardSquareSize - 1 : 0ull;
+
+        if ((targetRank == promotionRank) != (promotionType != ChessPieceType::None)) {
+            return;
+        }
+
+        const auto backwardOffset = color == ChessPieceColorType::White ? static_cast<int>(BoardSquareSize) : -static_cast<int>(BoardSquareSize);
+        const auto targetFile = getSquareFile(targetSquareIndex);
+        const auto targetIndex = static_cast<u8>(targetSquareIndex);
+
+        const auto isTargetRankReachable = color == ChessPieceColorType::White ? targetRank >= 2 : targetRank + 2 < BoardSquareSize;
+
+        if (!isTargetRankReachable) {
+            return;
+        }
+
+        if (startingFile == BoardSquareSize || startingFile == targetFile) {
+            if (position.getPiece(targetSquareIndex) != ChessPieces::None) {
+                return;
+            }
+
+            const auto singleMoveIndex = static_cast<usize>(static_cast<int>(targetSquareIndex) + backwardOffset);
+            const auto doubleMoveRank = color == ChessPieceColorType::White ? 3ull : BoardSquareSize - 4;
+
+            if (position.getPiece(singleMoveIndex) == pawn) {
+                candidates.push({ static_cast<u8>(singleMoveIndex), targetIndex, promotionType });
+            } else if (targetRank == doubleMoveRank && position.getPiece(singleMoveIndex) == ChessPieces::None) {
+                const auto doubleMoveIndex = static_cast<usize>(static_cast<int>(singleMoveIndex) + backwardOffset);
+
+                if (position.getPiece(doubleMoveIndex) == pawn) {
+                    candidates.push({ static_cast<u8>(doubleMoveIndex), targetIndex, ChessPieceType::None, false, false, true });
+                }
+            }
+
+            return;
+        }
+
+        if (startingFile + 1 != targetFile && targetFile + 1 != startingFile) {
+            return;
+        }
+
+        const auto startingSquareIndex = static_cast<usize>(static_cast<int>(targetSquareIndex) + backwardOffset) - targetFile + startingFile;
+
+        if (position.getPiece(startingSquareIndex) != pawn) {
+            return;
+        }
+
+        if (position.getPiece(targetSquareIndex).color == mapColorToOpposite(color)) {
+            candidates.push({ static_cast<u8>(startingSquareIndex), targetIndex, promotionType });
+        } else if (targetSquareIndex == position.getEnPassantSquareIndex()) {
+            candidates.push({ static_cast<u8>(startingSquareIndex), targetIndex, ChessPieceType::None, false, true });
+        }
+    }
+
+    bool parseSan(const Position& position, std::string_view san, ChessMove& move) {
+        while (!san.empty() && isSanSuffix(san.back())) {
+            san.remove_suffix(1);
+        }
+
+        if (san.size() < 2) {
+            return false;
+        }
+
+        if (san[0] == 'O' || san[0] == '0') {
+            return parseSanCastling(position, san, move);
+        }
+
+        auto pieceType = mapSanCharacterToChessPieceType(san[0]);
+
+        if (pieceType == ChessPieceType::None) {
+            pieceType = ChessPieceType::Pawn;
+        } else {
+            san.remove_prefix(1);
+        }
+
+        auto promotionType = ChessPieceType::None;
+        const auto promotionCharacterType = mapSanCharacterToChessPieceType(san.back());
+
+        if (promotionCharacterType != ChessPieceType::None && pieceType == ChessPieceType::Pawn) {
+            // Pawns only promote to a queen, rook, bishop or knight; 'P' is no piece character, so it fails below.
+            if (promotionCharacterType == ChessPieceType::King) {
+                return false;
+            }
+
+            promotionType = promotionCharacterType;
+            san.remove_suffix(1);
+
+            if (!san.empty() && san.back() == '=') {
+                san.remove_suffix(1);
+            }
+        }
+
+        if (san.size() < 2 || !isSanFile(san[san.size() - 2]) || !isSanRank(san.back())) {
+            return false;
+        }
+
+        const auto targetSquareIndex = mapFileAndRankToSquareIndex(san[san.size() - 2] - 'a', san.back() - '1');
+        san.remove_suffix(2);
+
+        auto startingFile = BoardSquareSize;
+        auto startingRank = BoardSquareSize;
+
+        for (const auto character : san) {
+            if (isSanFile(character)) {
+                startingFile = character - 'a';
+            } else if (isSanRank(character)) {
+                startingRank = character - '1';
+            } else if (character != 'x' && character != ':' && character != '-') {
+                return false;
+            }
+        }
+
+        if (position.getPiece(targetSquareIndex).color == position.getSideToMove()) {
+            return false;
+        }
+
+        auto candidates = MoveList{};
+
+        if (pieceType == ChessPieceType::Pawn) {
+            computePawnSanCandidates(position, targetSquareIndex, startingFile, promotionType, candidates);
+        } else if (promotionType == ChessPieceType::None) {
+            computePieceSanCandidates(position, targetSquareIndex, pieceType, candidates);
+        }
+
+        auto matchCount = 0;
+
+        for (const auto& candidate : candidates) {
+            if (startingFile != BoardSquareSize && getSquareFile(candidate.startingSquareIndex) != startingFile) {
+                continue;
+            }
+
+            if (startingRank != BoardSquareSize && getSquareRank(candidate.startingSquareIndex) != startingRank) {
+                continue;
+            }
+
+            if (isMoveLegal(position, candidate)) {
+                move = candidate;
+                matchCount++;
+            }
+        }
+
+        return matchCount == 1;
+    }
+
+    ChessMove createMoveFromSan(const Position& position, std::string_view san) {
+        auto move = ChessMove{};
+
+        if (!parseSan(position, san, move)) {
+            throw std::runtime_error(std::format("Invalid or illegal move '{}'", san));
+        }
+
+        return move;
+    }
+
+    std::string_view writeSan(const Position& position, const ChessMove& move, SanBuffer& buffer) {
+        auto* output = buffer.data();
+
+        const auto piece = position.getPiece(move.startingSquareIndex);
+        const auto isCapture = move.isEnPassant || position.getPiece(move.targetSquareIndex) != ChessPieces::None;
+
+        if (move.isCastling) {
+            const auto castling = move.targetSquareIndex > move.startingSquareIndex ? std::string_view{ "O-O" } : std::string_view{ "O-O-O" };
+            output = std::copy(castling.begin(), castling.end(), output);
+        } else if (piece.type == ChessPieceType::Pawn) {
+            if (isCapture) {
+                *output++ = static_cast<char>('a' + getSquareFile(move.startingSquareIndex));
+                *output++ = 'x';
+            }
+        } else {
+            *output++ = SanPieceCharacters[static_cast<usize>(piece.type)];
+
+            auto moves = MoveList{};
+            computeLegalMoves(position, moves);
+
+            auto isAmbiguous = false;
+            auto isFileShared = false;
+            auto isRankShared = false;
+
+            for (const auto& other : moves) {
+                if (other.targetSquareIndex != move.targetSquareIndex || other.startingSquareIndex == move.startingSquareIndex) {
+                    continue;
+                }
+
+                if (position.getPiece(other.startingSquareIndex) != piece) {
+                    continue;
+                }
+
+                isAmbiguous = true;
+                isFileShared |= getSquareFile(other.startingSquareIndex) == getSquareFile(move.startingSquareIndex);
+                isRankShared |= getSquareRank(other.startingSquareIndex) == getSquareRank(move.startingSquareIndex);
+            }
+
+            if (isAmbiguous && (!isFileShared || isRankShared)) {
+                *output++ = static_cast<char>('a' + getSquareFile(move.startingSquareIndex));
+            }
+
+            if (isAmbiguous && isFileShared) {
+                *output++ = static_cast<char>('1' + getSquareRank(move.startingSquareIndex));
+            }
+
+            if (isCapture) {
+                *output++ = 'x';
+            }
+        }
+
+        if (!move.isCastling) {
+            *output++ = static_cast<char>('a' + getSquareFile(move.targetSquareIndex));
+            *output++ = static_cast<char>('1' + getSquareRank(move.targetSquareIndex));
+        }
+
+        if (move.promotionType != ChessPieceType::None) {
+            *output++ = '=';
+            *output++ = SanPieceCharacters[static_cast<usize>(move.promotionType)];
+        }
+
+        auto nextPosition = position;
+        nextPosition.makeMove(move);
+
+        if (nextPosition.isKingUnderCheck()) {
+            *output++ = hasLegalMoves(nextPosition) ? '+' : '#';
+        }
+
+        return { buffer.data(), static_cast<usize>(output - buffer.data()) };
+    }
+}
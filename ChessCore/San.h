@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Position.h"
+
+#include <array>
+#include <string_view>
+
+namespace ChessCore {
+
+    // Longest SAN is a disambiguated capture with promotion and check marker, for example "exd8=Q+".
+    inline constexpr usize MaximumSanLength = 16;
+
+    using SanBuffer = std::array<char, MaximumSanLength>;
+
+    // Resolves standard algebraic notation against the legal moves of the position. Check, mate and
+    // annotation suffixes are ignored. Returns false when the move is malformed, illegal or ambiguous.
+    bool parseSan(const Position& position, std::string_view san, ChessMove& move);
+
+    ChessMove createMoveFromSan(const Position& position, std::string_view san);
+
+    std::string_view writeSan(const Position& position, const ChessMove& move, SanBuffer& buffer);
+}
@@ -0,0 +1,783 @@
+#include "Search.h"
+#include "Evaluation.h"
+#include "MoveGen.h"
+#include "Syzygy.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ChessCore {
+
+    using MoveScores = std::array<i32, MaximumMoveCount>;
+
+    static constexpr std::array<i32, ChessPieceTypeCount> MoveOrderingPieceValues = { 0, 900, 500, 330, 320, 100, 2000 };
+
+    static constexpr i32 TranspositionMoveScore = 1'000'000;
+    static constexpr i32 CaptureMoveScore = 100'000;
+    static constexpr i32 PromotionMoveScore = 90'000;
+    static constexpr std::array<i32, 2> KillerMoveScores = { 80'000, 79'000 };
+    static constexpr i32 CounterMoveScore = 78'000;
+
+    // Four history tables are added for a quiet move, which keeps their sum below the countermove score.
+    static constexpr i32 MaximumHistoryValue = 16384;
+    static constexpr i32 MaximumHistoryBonus = 1600;
+
+    static bool isCaptureMove(const Position& position, const ChessMove& move) {
+        return move.isEnPassant || position.getPiece(move.targetSquareIndex) != ChessPieces::None;
+    }
+
+    static i32 getMoveOrderingPieceValue(ChessPieceType type) {
+        return MoveOrderingPieceValues[static_cast<usize>(type)];
+    }
+
+    // Transposition table move first, then captures by most valuable victim and least valuable attacker, then promotions.
+    static void scoreMoves(const Position& position, const MoveList& moves, u16 transpositionMove, MoveScores& scores) {
+        for (auto moveIndex = 0ull; moveIndex < moves.size(); moveIndex++) {
+            const auto& move = moves[moveIndex];
+
+            auto score = 0;
+
+            if (isTranspositionMoveEqual(transpositionMove, move)) {
+                score = TranspositionMoveScore;
+            } else if (isCaptureMove(position, move)) {
+                const auto victim = move.isEnPassant ? ChessPieceType::Pawn : position.getPiece(move.targetSquareIndex).type;
+                const auto attacker = position.getPiece(move.startingSquareIndex).type;
+
+                score = CaptureMoveScore + getMoveOrderingPieceValue(victim) * 10 - getMoveOrderingPieceValue(attacker) / 10;
+            } else if (move.promotionType != ChessPieceType::None) {
+                score = PromotionMoveScore + getMoveOrderingPieceValue(move.promotionType);
+            }
+
+            scores[moveIndex] = score;
+        }
+    }
+
+    static bool isQuietMove(const Position& position, const ChessMove& move) {
+        return !isCaptureMove(position, move) && move.promotionType == ChessPieceType::None;
+    }
+
+    static u8 mapChessPieceToHistoryIndex(ChessPiece piece) {
+        return static_cast<u8>(static_cast<usize>(piece.type) + (piece.color == ChessPieceColorType::White ? 0 : ChessPieceTypeCount));
+    }
+
+    // Gravity update: the closer an entry is to the limit, the less a bonus of the same sign moves it.
+    static void updateHistoryValue(i16& value, i32 bonus) {
+        value = static_cast<i16>(value + bonus - value * std::abs(bonus) / MaximumHistoryValue);
+    }
+
+    // Moves the best scored remaining move to index, which is cheaper than sorting when a cutoff comes early.
+    static void selectNextMove(MoveList& moves, MoveScores& scores, usize index) {
+        auto bestIndex = index;
+
+        for (auto moveIndex = index + 1; moveIndex < moves.size(); moveIndex++) {
+            if (scores[moveIndex] > scores[bestIndex]) {
+                bestIndex = moveIndex;
+            }
+        }
+
+        std::swap(moves[index], moves[bestIndex]);
+        std::swap(scores[index], scores[bestIndex]);
+    }
+
+    // Without pieces other than pawns, passing is often the best move, so null move pruning would be unsound.
+    static bool hasNonPawnMaterial(const Position& position, ChessPieceColorType color) {
+        return std::ranges::any_of(position.getBoard(), [color](ChessPiece piece) {
+            return piece.color == color && piece.type != ChessPieceType::Pawn && piece.type != ChessPieceType::King;
+        });
+    }
+
+    static i16 mapSearchScoreToTransposition(i32 score, u32 ply) {
+        if (isDecisiveScore(score)) {
+            score += score > 0 ? static_cast<i32>(ply) : -static_cast<i32>(ply);
+        }
+
+        return static_cast<i16>(score);
+    }
+
+    static i32 mapTranspositionScoreToSearch(i16 score, u32 ply) {
+        auto searchScore = static_cast<i32>(score);
+
+        if (isDecisiveScore(searchScore)) {
+            searchScore -= searchScore > 0 ? static_cast<i32>(ply) : -static_cast<i32>(ply);
+        }
+
+        return searchScore;
+    }
+
+    static i32 mapSyzygyWdlTypeToScore(SyzygyWdlType type, u32 ply) {
+        switch (type) {
+        case SyzygyWdlType::Win:
+            return TablebaseWinScore - static_cast<i32>(ply);
+        case SyzygyWdlType::Loss:
+            return -TablebaseWinScore + static_cast<i32>(ply);
+        default:
+            return 0;
+        }
+    }
+
+    Searcher::Searcher(TranspositionTable& transpositionTable)
+        : _transpositionTable(transpositionTable), _continuationHistory(HistoryPieceCount * BoardSquareCount) {
+        setParameters(_parameters);
+    }
+
+    void Searcher::setTablebase(const SyzygyTablebase* tablebase) {
+        _tablebase = tablebase;
+    }
+
+    void Searcher::setPrincipalVariationCount(usize count) {
+        _principalVariationCount = std::max<usize>(count, 1);
+    }
+
+    void Searcher::setTraceBuffer(SearchTraceBuffer* buffer) {
+        _traceBuffer = buffer;
+    }
+
+    void Searcher::setParameters(const SearchParameters& parameters) {
+        _parameters = parameters;
+
+        const auto base = static_cast<f64>(parameters.lateMoveReductionBase) / 100;
+        const auto divisor = std::max(static_cast<f64>(parameters.lateMoveReductionDivisor) / 100, 0.01);
+
+        for (auto depth = 1ull; depth < MaximumSearchDepth; depth++) {
+            for (auto moveCount = 1ull; moveCount < MaximumSearchDepth; moveCount++) {
+                const auto reduction = base + std::log(static_cast<f64>(depth)) * std::log(static_cast<f64>(moveCount)) / divisor;
+                _lateMoveReductions[depth][moveCount] = static_cast<i8>(std::clamp(reduction, 0.0, static_cast<f64>(MaximumSearchDepth - 1)));
+            }
+        }
+    }
+
+    SearchResult Searcher::search(const Position& position, const SearchLimits& limits, std::span<const u64> previousKeys, const SearchIterationCallback& callback) {
+        _limits = limits;
+        _startTime = std::chrono::steady_clock::now();
+        _nodeCount = 0;
+        _isStopped = false;
+        _isStopRequested.store(false, std::memory_order_relaxed);
+        _keys.assign(previousKeys.begin(), previousKeys.end());
+        _nullMoveMinimumPly = 0;
+        _killerMoves = {};
+        _statistics = {};
+
+        // With a clock, the time manager's maximum is the hard limit and its optimum decides between iterations.
+        auto timeManager = std::optional<TimeManager>{};
+
+        if (limits.timeControl.remainingTime.count() != 0) {
+            timeManager.emplace(limits.timeControl);
+            _limits.time = _limits.time.count() != 0 ? std::min(_limits.time, timeManager->getMaximumTime()) : timeManager->getMaximumTime();
+        }
+
+        auto result = SearchResult{};
+
+        const auto legalMoves = computeLegalMoves(position);
+
+        if (legalMoves.empty()) {
+            result.score = position.isKingUnderCheck() ? -MateScore : 0;
+            return result;
+        }
+
+        // A move is always returned, even when the first iteration does not finish.
+        result.bestMove = legalMoves[0];
+
+        const auto maximumDepth = std::min(limits.depth, MaximumSearchDepth);
+        const auto lineCount = std::min(_principalVariationCount, legalMoves.size());
+
+        for (auto depth = 1u; depth <= maximumDepth; depth++) {
+            const auto iterationStartNodeCount = _nodeCount;
+
+            auto lines = std::vector<SearchLine>{};
+            auto firstLineNodeCount = u64{};
+            _excludedRootMoves.clear();
+
+            for (auto lineIndex = 0ull; lineIndex < lineCount; lineIndex++) {
+                const auto lineStartNodeCount = _nodeCount;
+                const auto score = _searchTracedNode(position, -InfiniteScore, InfiniteScore, static_cast<i32>(depth), 0, {}, SearchTraceReasonType::Root);
+
+                if (_isStopped || _principalVariationLengths[0] == 0) {
+                    break;
+                }
+
+                const auto& principalVariation = _principalVariations[0];
+
+                if (lineIndex == 0) {
+                    firstLineNodeCount = _nodeCount - lineStartNodeCount;
+                }
+
+                lines.push_back({ score, { principalVariation.begin(), principalVariation.begin() + _principalVariationLengths[0] } });
+                _excludedRootMoves.push(principalVariation[0]);
+            }
+
+            // An iteration only counts when all of its lines finished.
+            if (_isStopped) {
+                break;
+            }
+
+            std::ranges::stable_sort(lines, std::ranges::greater{}, &SearchLine::score);
+
+            if constexpr (IsSearchStatisticsEnabled) {
+                _statistics.iterationNodeCounts.push_back(_nodeCount - iterationStartNodeCount);
+            }
+
+            const auto score = lines.empty() ? result.score : lines[0].score;
+
+            if (!lines.empty()) {
+                result.bestMove = lines[0].principalVariation[0];
+                result.principalVariation = lines[0].principalVariation;
+                result.lines = std::move(lines);
+            }
+
+            result.score = score;
+            result.depth = depth;
+            result.nodeCount = _nodeCount;
+            result.elapsedTime = std::chrono::steady_clock::now() - _startTime;
+            result.statistics = _statistics;
+
+            if (callback) {
+                callback(result);
+            }
+
+            if (isMateScore(score) && static_cast<i32>(depth) >= MateScore - std::abs(score)) {
+                break;
+            }
+
+            // The next iteration takes several times longer and would most likely not finish.
+            if (limits.time.count() != 0 && result.elapsedTime * 2 > limits.time) {
+                break;
+            }
+
+            if (timeManager) {
+                const auto bestMoveNodeShare = firstLineNodeCount == 0 ? 1.0 : static_cast<f64>(_bestRootMoveNodeCount) / static_cast<f64>(firstLineNodeCount);
+
+                if (!timeManager->shouldStartIteration(*result.bestMove, score, bestMoveNodeShare, result.elapsedTime)) {
+                    break;
+                }
+            }
+        }
+
+        result.nodeCount = _nodeCount;
+        result.elapsedTime = std::chrono::steady_clock::now() - _startTime;
+        result.statistics = _statistics;
+
+        return result;
+    }
+
+    SearchResult Searcher::searchQuiescence(const Position& position) {
+        _limits = {};
+        _startTime = std::chrono::steady_clock::now();
+        _nodeCount = 0;
+        _isStopped = false;
+        _isStopRequested.store(false, std::memory_order_relaxed);
+        _keys.clear();
+        _statistics = {};
+
+        auto result = SearchResult{};
+        result.score = _searchQuiescence(position, -InfiniteScore, InfiniteScore, 0);
+
+        const auto& principalVariation = _principalVariations[0];
+        result.principalVariation.assign(principalVariation.begin(), principalVariation.begin() + _principalVariationLengths[0]);
+
+        if (!result.principalVariation.empty()) {
+            result.bestMove = result.principalVariation[0];
+        }
+
+        result.nodeCount = _nodeCount;
+        result.elapsedTime = std::chrono::steady_clock::now() - _startTime;
+        result.statistics = _statistics;
+
+        return result;
+    }
+
+    void Searcher::stop() {
+        _isStopRequested.store(true, std::memory_order_relaxed);
+    }
+
+    i32 Searcher::_searchNode(const Position& position, i32 alpha, i32 beta, i32 depth, u32 ply) {
+        _principalVariationLengths[ply] = 0;
+
+        if (depth <= 0) {
+            _setTraceExitReason(SearchTraceReasonType::Quiescence);
+            return _searchQuiescence(position, alpha, beta, ply);
+        }
+
+        _nodeCount++;
+        _countStatistic(&SearchStatistics::nodeCount);
+
+        if (_shouldStop()) {
+            _setTraceExitReason(SearchTraceReasonType::Stopped);
+            return 0;
+        }
+
+        const auto isRoot = ply == 0;
+
+        if (!isRoot) {
+            if (position.getHalfmoveClock() >= 100 || _isRepetition(position)) {
+                _setTraceExitReason(SearchTraceReasonType::Draw);
+                return 0;
+            }
+
+            if (ply >= MaximumSearchPly - 1) {
+                return evaluatePosition(position);
+            }
+
+            // No line through this node can beat a shorter mate that was already found.
+            alpha = std::max(alpha, -MateScore + static_cast<i32>(ply));
+            beta = std::min(beta, MateScore - static_cast<i32>(ply) - 1);
+
+            if (alpha >= beta) {
+                _setTraceExitReason(SearchTraceReasonType::MateDistance);
+                return alpha;
+            }
+        }
+
+        const auto key = position.getKey();
+        const auto isPrincipalVariationNode = beta - alpha > 1;
+
+        auto entry = TranspositionEntry{};
+        const auto hasEntry = _transpositionTable.probe(key, entry);
+
+        _countStatistic(&SearchStatistics::transpositionProbeCount);
+
+        if (hasEntry) {
+            _countStatistic(&SearchStatistics::transpositionHitCount);
+        }
+
+        if (hasEntry && !isPrincipalVariationNode && entry.depth >= depth) {
+            const auto score = mapTranspositionScoreToSearch(entry.score, ply);
+
+            if (entry.bound == TranspositionBoundType::Exact
+                || (entry.bound == TranspositionBoundType::Lower && score >= beta)
+                || (entry.bound == TranspositionBoundType::Upper && score <= alpha)) {
+                _countStatistic(&SearchStatistics::transpositionCutoffCount);
+                _setTraceExitReason(SearchTraceReasonType::TranspositionCutoff);
+                return score;
+            }
+        }
+
+        // Tables are only probed right after captures and pawn moves, where the 50-move counter is reset.
+        if (IsSyzygyEnabled && !isRoot && _tablebase != nullptr && position.getHalfmoveClock() == 0 && _tablebase->canProbe(position)) {
+            if (const auto wdl = _tablebase->probeWdl(position)) {
+                const auto score = mapSyzygyWdlTypeToScore(*wdl, ply);
+
+                _transpositionTable.store(key, { 0, mapSearchScoreToTransposition(score, ply), static_cast<u8>(depth), TranspositionBoundType::Exact });
+                _setTraceExitReason(SearchTraceReasonType::Tablebase);
+                return score;
+            }
+        }
+
+        const auto isInCheck = position.isKingUnderCheck();
+        const auto staticEvaluation = isInCheck ? -InfiniteScore : evaluatePosition(position);
+
+        if (!isPrincipalVariationNode && !isInCheck) {
+            // Reverse futility pruning: far enough above beta, a shallow search is not expected to fall below it.
+            if (_parameters.isReverseFutilityPruningEnabled && depth <= _parameters.reverseFutilityMaximumDepth && !isDecisiveScore(beta)
+                && staticEvaluation - _parameters.reverseFutilityMargin * depth >= beta) {
+                _setTraceExitReason(SearchTraceReasonType::ReverseFutility);
+                return staticEvaluation;
+            }
+
+            if (_parameters.isNullMovePruningEnabled && depth >= _parameters.nullMoveMinimumDepth && ply >= _nullMoveMinimumPly
+                && staticEvaluation >= beta && !isDecisiveScore(beta) && hasNonPawnMaterial(position, position.getSideToMove())) {
+                const auto nullMoveDepth = depth - 1 - _parameters.nullMoveReduction - depth / std::max(_parameters.nullMoveDepthDivisor, 1);
+
+                auto nextPosition = position;
+                nextPosition.makeNullMove();
+                _playedMoves[ply] = {};
+
+                _countStatistic(&SearchStatistics::nullMoveSearchCount);
+
+                _keys.push_back(key);
+                auto score = -_searchTracedNode(nextPosition, -beta, -beta + 1, nullMoveDepth, ply + 1, {}, SearchTraceReasonType::NullMove);
+                _keys.pop_back();
+
+                if (_isStopped) {
+                    _setTraceExitReason(SearchTraceReasonType::Stopped);
+                    return 0;
+                }
+
+                if (score >= beta) {
+                    // A mate found after passing is not proven.
+                    score = isDecisiveScore(score) ? beta : score;
+
+                    if (depth < _parameters.nullMoveVerificationDepth) {
+                        _countStatistic(&SearchStatistics::nullMoveCutoffCount);
+                        _setTraceExitReason(SearchTraceReasonType::NullMoveCutoff);
+                        return score;
+                    }
+
+                    // Null moves stay off for the first plies of the verification search, so zugzwang is searched out.
+                    const auto previousMinimumPly = _nullMoveMinimumPly;
+                    _nullMoveMinimumPly = ply + static_cast<u32>(std::max(3 * nullMoveDepth / 4, 1));
+
+                    const auto verificationScore = _searchTracedNode(position, beta - 1, beta, nullMoveDepth, ply, {}, SearchTraceReasonType::Verification);
+                    _nullMoveMinimumPly = previousMinimumPly;
+
+                    if (_isStopped) {
+                        _setTraceExitReason(SearchTraceReasonType::Stopped);
+                        return 0;
+                    }
+
+                    if (verificationScore >= beta) {
+                        _countStatistic(&SearchStatistics::nullMoveCutoffCount);
+                        _setTraceExitReason(SearchTraceReasonType::NullMoveCutoff);
+                        return score;
+                    }
+                }
+            }
+        }
+
+        // Futility pruning: quiet moves cannot bring a score this far below alpha back up at low depth.
+        const auto canPruneQuietMoves = _parameters.isFutilityPruningEnabled && !isPrincipalVariationNode && !isInCheck
+            && depth <= _parameters.futilityMaximumDepth && !isDecisiveScore(alpha)
+            && staticEvaluation + _parameters.futilityMargin * depth <= alpha;
+
+        auto moves = MoveList{};
+        computePseudoLegalMoves(position, moves);
+
+        auto moveScores = MoveScores{};
+        scoreMoves(position, moves, hasEntry ? entry.move : 0, moveScores);
+        _scoreQuietMoves(position, moves, ply, moveScores);
+
+        const auto originalAlpha = alpha;
+        const auto sideToMove = position.getSideToMove();
+
+        auto bestScore = -InfiniteScore;
+        auto bestMove = ChessMove{};
+        auto legalMoveCount = 0ull;
+        auto searchedQuietMoves = MoveList{};
+
+        _keys.push_back(key);
+
+        for (auto moveIndex = 0ull; moveIndex < moves.size(); moveIndex++) {
+            selectNextMove(moves, moveScores, moveIndex);
+
+            const auto& move = moves[moveIndex];
+
+            if (isRoot && _excludedRootMoves.contains(move)) {
+                continue;
+            }
+
+            auto nextPosition = position;
+            nextPosition.makeMove(move);
+
+            if (nextPosition.isKingUnderCheck(sideToMove)) {
+                continue;
+            }
+
+            legalMoveCount++;
+
+            const auto isQuiet = isQuietMove(position, move);
+            const auto givesCheck = nextPosition.isKingUnderCheck();
+
+            if (canPruneQuietMoves && legalMoveCount > 1 && isQuiet && !givesCheck) {
+                continue;
+            }
+
+            const auto nextDepth = depth - 1 + (_parameters.isCheckExtensionEnabled && givesCheck ? 1 : 0);
+
+            _playedMoves[ply] = { mapChessPieceToHistoryIndex(position.getPiece(move.startingSquareIndex)), move.targetSquareIndex };
+
+            const auto moveStartNodeCount = _nodeCount;
+            auto score = 0;
+
+            if (legalMoveCount == 1) {
+                score = -_searchTracedNode(nextPosition, -beta, -alpha, nextDepth, ply + 1, move, SearchTraceReasonType::FirstMove);
+            } else {
+                auto reduction = 0;
+
+                // Late moves are searched shallower first, well ordered moves rarely improve on the earlier ones.
+                if (_parameters.isLateMoveReductionEnabled && depth >= _parameters.lateMoveReductionMinimumDepth
+                    && legalMoveCount > _parameters.lateMoveReductionMoveCount && isQuiet && !givesCheck && !isInCheck) {
+                    const auto depthIndex = std::min<usize>(static_cast<usize>(depth), MaximumSearchDepth - 1);
+                    const auto moveCountIndex = std::min<usize>(legalMoveCount, MaximumSearchDepth - 1);
+
+                    reduction = _lateMoveReductions[depthIndex][moveCountIndex] - (isPrincipalVariationNode ? 1 : 0);
+                    reduction = std::clamp(reduction, 0, nextDepth - 1);
+                }
+
+                if (reduction > 0) {
+                    _countStatistic(&SearchStatistics::lateMoveReductionCount);
+                }
+
+                const auto traceReason = reduction > 0 ? SearchTraceReasonType::Reduced : SearchTraceReasonType::ZeroWindow;
+                score = -_searchTracedNode(nextPosition, -alpha - 1, -alpha, nextDepth - reduction, ply + 1, move, traceReason);
+
+                if (reduction > 0 && score > alpha) {
+                    _countStatistic(&SearchStatistics::lateMoveResearchCount);
+                    score = -_searchTracedNode(nextPosition, -alpha - 1, -alpha, nextDepth, ply + 1, move, SearchTraceReasonType::ReducedResearch);
+                }
+
+                if (score > alpha && score < beta) {
+                    score = -_searchTracedNode(nextPosition, -beta, -alpha, nextDepth, ply + 1, move, SearchTraceReasonType::WindowResearch);
+                }
+            }
+
+            if (_isStopped) {
+                _keys.pop_back();
+                _setTraceExitReason(SearchTraceReasonType::Stopped);
+                return 0;
+            }
+
+            if (isQuiet) {
+                searchedQuietMoves.push(move);
+            }
+
+            if (score <= bestScore) {
+                continue;
+            }
+
+            bestScore = score;
+            bestMove = move;
+
+            if (isRoot && _excludedRootMoves.empty()) {
+                _bestRootMoveNodeCount = _nodeCount - moveStartNodeCount;
+            }
+
+            if (score > alpha) {
+                alpha = score;
+                _updatePrincipalVariation(ply, move);
+
+                if (alpha >= beta) {
+                    _countStatistic(&SearchStatistics::betaCutoffCount);
+
+                    if (legalMoveCount == 1) {
+                        _countStatistic(&SearchStatistics::firstMoveBetaCutoffCount);
+                    }
+
+                    break;
+                }
+            }
+        }
+
+        _keys.pop_back();
+
+        if (legalMoveCount == 0) {
+            _setTraceExitReason(SearchTraceReasonType::NoMoves);
+            return position.isKingUnderCheck() ? -MateScore + static_cast<i32>(ply) : 0;
+        }
+
+        if (bestScore >= beta && isQuietMove(position, bestMove)) {
+            _updateQuietMoveHistory(position, bestMove, searchedQuietMoves, depth, ply);
+        }
+
+        _setTraceExitReason(bestScore >= beta ? SearchTraceReasonType::BetaCutoff : bestScore > originalAlpha ? SearchTraceReasonType::Exact : SearchTraceReasonType::FailLow);
+
+        // With root moves excluded the result is not the value of the root position.
+        if (isRoot && !_excludedRootMoves.empty()) {
+            return bestScore;
+        }
+
+        const auto bound = bestScore >= beta ? TranspositionBoundType::Lower
+            : bestScore > originalAlpha ? TranspositionBoundType::Exact
+            : TranspositionBoundType::Upper;
+
+        _transpositionTable.store(key, { encodeTranspositionMove(bestMove), mapSearchScoreToTransposition(bestScore, ply), static_cast<u8>(depth), bound });
+
+        return bestScore;
+    }
+
+    // Records the entry and exit of the node when tracing is compiled in and the searcher has a buffer.
+    i32 Searcher::_searchTracedNode(const Position& position, i32 alpha, i32 beta, i32 depth, u32 ply, const ChessMove& move, SearchTraceReasonType reason) {
+        if constexpr (IsSearchTraceEnabled) {
+            if (_traceBuffer != nullptr) {
+                auto event = SearchTraceEvent{ encodeTranspositionMove(move), static_cast<u8>(ply), SearchTraceEventType::Enter, reason,
+                    static_cast<i8>(std::clamp(depth, -128, 127)), static_cast<i16>(alpha), static_cast<i16>(beta), 0, static_cast<u32>(_nodeCount) };
+                _traceBuffer->record(event);
+
+                _traceExitReason = SearchTraceReasonType::None;
+                const auto score = _searchNode(position, alpha, beta, depth, ply);
+
+                event.type = SearchTraceEventType::Exit;
+                event.reason = _traceExitReason;
+                event.score = static_cast<i16>(score);
+                event.nodeCount = static_cast<u32>(_nodeCount);
+                _traceBuffer->record(event);
+
+                return score;
+            }
+        }
+
+        return _searchNode(position, alpha, beta, depth, ply);
+    }
+
+    i32 Searcher::_searchQuiescence(const Position& position, i32 alpha, i32 beta, u32 ply) {
+        _principalVariationLengths[ply] = 0;
+        _nodeCount++;
+        _countStatistic(&SearchStatistics::quiescenceNodeCount);
+
+        if (_shouldStop()) {
+            return 0;
+        }
+
+        const auto standPatScore = evaluatePosition(position);
+
+        if (ply >= MaximumSearchPly - 1 || standPatScore >= beta) {
+            return standPatScore;
+        }
+
+        alpha = std::max(alpha, standPatScore);
+
+        auto moves = MoveList{};
+        computePseudoLegalMoves(position, moves);
+
+        auto moveScores = MoveScores{};
+        scoreMoves(position, moves, 0, moveScores);
+
+        const auto sideToMove = position.getSideToMove();
+
+        auto bestScore = standPatScore;
+
+        for (auto moveIndex = 0ull; moveIndex < moves.size(); moveIndex++) {
+            selectNextMove(moves, moveScores, moveIndex);
+
+            const auto& move = moves[moveIndex];
+
+            // Scores are sorted, so the first quiet move ends the captures and queen promotions.
+            if (moveScores[moveIndex] < PromotionMoveScore + getMoveOrderingPieceValue(ChessPieceType::Queen)) {
+                break;
+            }
+
+            auto nextPosition = position;
+            nextPosition.makeMove(move);
+
+            if (nextPosition.isKingUnderCheck(sideToMove)) {
+                continue;
+            }
+
+            const auto score = -_searchQuiescence(nextPosition, -beta, -alpha, ply + 1);
+
+            if (_isStopped) {
+                return 0;
+            }
+
+            if (score <= bestScore) {
+                continue;
+            }
+
+            bestScore = score;
+
+            if (score > alpha) {
+                alpha = score;
+                _updatePrincipalVariation(ply, move);
+
+                if (alpha >= beta) {
+                    break;
+                }
+            }
+        }
+
+        return bestScore;
+    }
+
+    // Killers and the countermove go right after the captures, the remaining quiet moves are ordered by history.
+    void Searcher::_scoreQuietMoves(const Position& position, const MoveList& moves, u32 ply, std::span<i32> scores) const {
+        const auto& killerMoves = _killerMoves[ply];
+        const auto& previousMove = ply > 0 ? _playedMoves[ply - 1] : PlayedMove{};
+        const auto counterMove = previousMove.pieceIndex < HistoryPieceCount ? _counterMoves[previousMove.pieceIndex][previousMove.targetSquareIndex] : ChessMove{};
+
+        for (auto moveIndex = 0ull; moveIndex < moves.size(); moveIndex++) {
+            const auto& move = moves[moveIndex];
+
+            if (scores[moveIndex] != 0 || !isQuietMove(position, move)) {
+                continue;
+            }
+
+            if (move == killerMoves[0]) {
+                scores[moveIndex] = KillerMoveScores[0];
+            } else if (move == killerMoves[1]) {
+                scores[moveIndex] = KillerMoveScores[1];
+            } else if (move == counterMove) {
+                scores[moveIndex] = CounterMoveScore;
+            } else {
+                scores[moveIndex] = _getQuietMoveHistory(position, move, ply);
+            }
+        }
+    }
+
+    // Sum of the butterfly, piece and continuation histories for the moves one and two plies back.
+    i32 Searcher::_getQuietMoveHistory(const Position& position, const ChessMove& move, u32 ply) const {
+        const auto sideIndex = position.getSideToMove() == ChessPieceColorType::White ? 0 : 1;
+        const auto pieceIndex = mapChessPieceToHistoryIndex(position.getPiece(move.startingSquareIndex));
+
+        auto history = static_cast<i32>(_butterflyHistory[sideIndex][move.startingSquareIndex][move.targetSquareIndex])
+            + _pieceHistory[pieceIndex][move.targetSquareIndex];
+
+        for (auto distance = 1u; distance <= 2 && distance <= ply; distance++) {
+            const auto& previousMove = _playedMoves[ply - distance];
+
+            if (previousMove.pieceIndex < HistoryPieceCount) {
+                history += _continuationHistory[previousMove.pieceIndex * BoardSquareCount + previousMove.targetSquareIndex][pieceIndex][move.targetSquareIndex];
+            }
+        }
+
+        return history;
+    }
+
+    // The quiet move that caused a cutoff is rewarded and the quiet moves searched before it are penalized.
+    void Searcher::_updateQuietMoveHistory(const Position& position, const ChessMove& bestMove, std::span<const ChessMove> searchedMoves, i32 depth, u32 ply) {
+        auto& killerMoves = _killerMoves[ply];
+
+        if (killerMoves[0] != bestMove) {
+            killerMoves[1] = killerMoves[0];
+            killerMoves[0] = bestMove;
+        }
+
+        if (ply > 0 && _playedMoves[ply - 1].pieceIndex < HistoryPieceCount) {
+            _counterMoves[_playedMoves[ply - 1].pieceIndex][_playedMoves[ply - 1].targetSquareIndex] = bestMove;
+        }
+
+        const auto bonus = std::min(32 * depth * depth, MaximumHistoryBonus);
+        const auto sideIndex = position.getSideToMove() == ChessPieceColorType::White ? 0 : 1;
+
+        for (const auto& move : searchedMoves) {
+            const auto moveBonus = move == bestMove ? bonus : -bonus;
+            const auto pieceIndex = mapChessPieceToHistoryIndex(position.getPiece(move.startingSquareIndex));
+
+            updateHistoryValue(_butterflyHistory[sideIndex][move.startingSquareIndex][move.targetSquareIndex], moveBonus);
+            updateHistoryValue(_pieceHistory[pieceIndex][move.targetSquareIndex], moveBonus);
+
+            for (auto distance = 1u; distance <= 2 && distance <= ply; distance++) {
+                const auto& previousMove = _playedMoves[ply - distance];
+
+                if (previousMove.pieceIndex < HistoryPieceCount) {
+                    updateHistoryValue(_continuationHistory[previousMove.pieceIndex * BoardSquareCount + previousMove.targetSquareIndex][pieceIndex][move.targetSquareIndex], moveBonus);
+                }
+            }
+        }
+    }
+
+    bool Searcher::_isRepetition(const Position& position) const {
+        const auto key = position.getKey();
+        const auto lookback = std::min<usize>(position.getHalfmoveClock(), _keys.size());
+
+        for (auto distance = 2ull; distance <= lookback; distance += 2) {
+            if (_keys[_keys.size() - distance] == key) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool Searcher::_shouldStop() {
+        if (_isStopped) {
+            return true;
+        }
+
+        if (_isStopRequested.load(std::memory_order_relaxed) || (_limits.nodeCount != 0 && _nodeCount >= _limits.nodeCount)) {
+            _isStopped = true;
+        } else if (_limits.time.count() != 0 && (_nodeCount & 1023) == 0) {
+            _isStopped = std::chrono::steady_clock::now() - _startTime >= _limits.time;
+        }
+
+        return _isStopped;
+    }
+
+    void Searcher::_updatePrincipalVariation(u32 ply, const ChessMove& move) {
+        auto& principalVariation = _principalVariations[ply];
+        const auto& childPrincipalVariation = _principalVariations[ply + 1];
+        const auto childLength = _principalVariationLengths[ply + 1];
+
+        principalVariation[0] = move;
+        std::copy_n(childPrincipalVariation.begin(), childLength, principalVariation.begin() + 1);
+
+        _principalVariationLengths[ply] = childLength + 1;
+    }
+}
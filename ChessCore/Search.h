@@ -0,0 +1,191 @@
+#pragma once
+
+#include "Position.h"
+#include "SearchStatistics.h"
+#include "SearchTrace.h"
+#include "TimeManager.h"
+#include "TranspositionTable.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace ChessCore {
+
+    class SyzygyTablebase;
+
+    inline constexpr u32 MaximumSearchDepth = 64;
+    inline constexpr u32 MaximumSearchPly = 128;
+
+    inline constexpr i32 InfiniteScore = 32000;
+    inline constexpr i32 MateScore = 31000;
+    inline constexpr i32 TablebaseWinScore = 20000;
+
+    // History tables tell pieces of both colours apart.
+    inline constexpr usize HistoryPieceCount = ChessPieceTypeCount * 2;
+
+    constexpr bool isMateScore(i32 score) {
+        return score >= MateScore - static_cast<i32>(MaximumSearchPly) || score <= -MateScore + static_cast<i32>(MaximumSearchPly);
+    }
+
+    // Mate and tablebase scores depend on the distance from the root.
+    constexpr bool isDecisiveScore(i32 score) {
+        return score >= TablebaseWinScore - static_cast<i32>(MaximumSearchPly) || score <= -TablebaseWinScore + static_cast<i32>(MaximumSearchPly);
+    }
+
+    // A zero node count or time means no limit. A clock in the time control lets the time manager budget the move.
+    struct SearchLimits {
+        u32 depth = MaximumSearchDepth;
+        u64 nodeCount{};
+        std::chrono::milliseconds time{};
+        TimeControl timeControl{};
+    };
+
+    // Switches and margins of the selective search, so self-play can compare variants. Depths are in plies and
+    // margins in centipawns per ply of remaining depth.
+    struct SearchParameters {
+        bool isNullMovePruningEnabled = true;
+        i32 nullMoveMinimumDepth = 3;
+        i32 nullMoveReduction = 3;
+        i32 nullMoveDepthDivisor = 4;
+        // From this depth a null move cutoff is only taken when a reduced search without null moves confirms it.
+        i32 nullMoveVerificationDepth = 8;
+
+        bool isLateMoveReductionEnabled = true;
+        i32 lateMoveReductionMinimumDepth = 3;
+        u32 lateMoveReductionMoveCount = 3;
+        // The reduction is base + ln(depth) * ln(move count) / divisor, both given in hundredths.
+        i32 lateMoveReductionBase = 75;
+        i32 lateMoveReductionDivisor = 225;
+
+        bool isReverseFutilityPruningEnabled = true;
+        i32 reverseFutilityMaximumDepth = 6;
+        i32 reverseFutilityMargin = 80;
+
+        bool isFutilityPruningEnabled = true;
+        i32 futilityMaximumDepth = 3;
+        i32 futilityMargin = 120;
+
+        bool isCheckExtensionEnabled = true;
+    };
+
+    struct SearchLine {
+        i32 score{};
+        std::vector<ChessMove> principalVariation{};
+    };
+
+    // The best move, score and principal variation are those of the first line. Lines are sorted by score and
+    // there is one per requested principal variation, unless the position has fewer legal moves.
+    struct SearchResult {
+        std::optional<ChessMove> bestMove{};
+        i32 score{};
+        u32 depth{};
+        u64 nodeCount{};
+        std::chrono::nanoseconds elapsedTime{};
+        std::vector<ChessMove> principalVariation{};
+        std::vector<SearchLine> lines{};
+        SearchStatistics statistics{};
+    };
+
+    // Called after every completed iteration of iterative deepening.
+    using SearchIterationCallback = std::function<void(const SearchResult& result)>;
+
+    // Iterative deepening principal variation search with a quiescence search over captures. A searcher is used
+    // by one thread at a time; several searchers may share a transposition table.
+    class Searcher {
+    public:
+        explicit Searcher(TranspositionTable& transpositionTable);
+
+        void setTablebase(const SyzygyTablebase* tablebase);
+
+        // Multi-PV: every iteration searches the root again for each extra line, without the first moves of the
+        // lines found before. The later passes start from the table entries the earlier ones left.
+        void setPrincipalVariationCount(usize count);
+
+        void setParameters(const SearchParameters& parameters);
+
+        // Records node entries and exits into the buffer; only builds with CHESSCORE_SEARCH_TRACE record anything.
+        void setTraceBuffer(SearchTraceBuffer* buffer);
+
+        // Keys of the game positions played before this one are used to detect repetitions.
+        SearchResult search(const Position& position, const SearchLimits& limits, std::span<const u64> previousKeys = {}, const SearchIterationCallback& callback = {});
+
+        // Searches captures only. The principal variation leads to the quiet position the score was taken from.
+        SearchResult searchQuiescence(const Position& position);
+
+        // Stops a running search as soon as possible, can be called from any thread.
+        void stop();
+    private:
+        i32 _searchNode(const Position& position, i32 alpha, i32 beta, i32 depth, u32 ply);
+        i32 _searchQuiescence(const Position& position, i32 alpha, i32 beta, u32 ply);
+        i32 _searchTracedNode(const Position& position, i32 alpha, i32 beta, i32 depth, u32 ply, const ChessMove& move, SearchTraceReasonType reason);
+
+        // A moved piece and its target square, which is what the countermove and continuation tables are indexed by.
+        struct PlayedMove {
+            u8 pieceIndex = HistoryPieceCount;
+            u8 targetSquareIndex{};
+        };
+
+        using HistoryTable = std::array<std::array<i16, BoardSquareCount>, HistoryPieceCount>;
+
+        void _scoreQuietMoves(const Position& position, const MoveList& moves, u32 ply, std::span<i32> scores) const;
+        i32 _getQuietMoveHistory(const Position& position, const ChessMove& move, u32 ply) const;
+        void _updateQuietMoveHistory(const Position& position, const ChessMove& bestMove, std::span<const ChessMove> searchedMoves, i32 depth, u32 ply);
+
+        // Counts one event; the call compiles to nothing when statistics are disabled.
+        void _countStatistic(u64 SearchStatistics::* counter) {
+            if constexpr (IsSearchStatisticsEnabled) {
+                (_statistics.*counter)++;
+            }
+        }
+
+        void _setTraceExitReason(SearchTraceReasonType reason) {
+            if constexpr (IsSearchTraceEnabled) {
+                _traceExitReason = reason;
+            }
+        }
+
+        bool _isRepetition(const Position& position) const;
+        bool _shouldStop();
+        void _updatePrincipalVariation(u32 ply, const ChessMove& move);
+
+        TranspositionTable& _transpositionTable;
+        const SyzygyTablebase* _tablebase = nullptr;
+        usize _principalVariationCount = 1;
+
+        SearchParameters _parameters{};
+        std::array<std::array<i8, MaximumSearchDepth>, MaximumSearchDepth> _lateMoveReductions{};
+        u32 _nullMoveMinimumPly{};
+
+        std::atomic<bool> _isStopRequested{};
+        bool _isStopped{};
+
+        SearchLimits _limits{};
+        std::chrono::steady_clock::time_point _startTime{};
+        u64 _nodeCount{};
+        // Nodes spent on the current best root move of the first line, for the time manager.
+        u64 _bestRootMoveNodeCount{};
+        SearchStatistics _statistics{};
+
+        SearchTraceBuffer* _traceBuffer = nullptr;
+        SearchTraceReasonType _traceExitReason{};
+
+        std::vector<u64> _keys{};
+        MoveList _excludedRootMoves{};
+        std::array<std::array<ChessMove, MaximumSearchPly>, MaximumSearchPly> _principalVariations{};
+        std::array<u32, MaximumSearchPly> _principalVariationLengths{};
+
+        // Move ordering state of this searcher, kept between searches. Killers are per ply, the butterfly history
+        // is indexed by side, starting and target square, the others by piece and target square.
+        std::array<std::array<ChessMove, 2>, MaximumSearchPly> _killerMoves{};
+        std::array<std::array<std::array<i16, BoardSquareCount>, BoardSquareCount>, 2> _butterflyHistory{};
+        HistoryTable _pieceHistory{};
+        std::array<std::array<ChessMove, BoardSquareCount>, HistoryPieceCount> _counterMoves{};
+        std::vector<HistoryTable> _continuationHistory{};
+        std::array<PlayedMove, MaximumSearchPly> _playedMoves{};
+    };
+}
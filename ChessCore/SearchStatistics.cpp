@@ -0,0 +1,88 @@
+#include "SearchStatistics.h"
+
+#include <algorithm>
+#include <format>
+
+namespace ChessCore {
+
+    static f64 computeRatio(u64 numerator, u64 denominator) {
+        return denominator == 0 ? 0.0 : static_cast<f64>(numerator) / static_cast<f64>(denominator);
+    }
+
+    SearchStatistics& SearchStatistics::operator+=(const SearchStatistics& other) {
+        nodeCount += other.nodeCount;
+        quiescenceNodeCount += other.quiescenceNodeCount;
+        transpositionProbeCount += other.transpositionProbeCount;
+        transpositionHitCount += other.transpositionHitCount;
+        transpositionCutoffCount += other.transpositionCutoffCount;
+        betaCutoffCount += other.betaCutoffCount;
+        firstMoveBetaCutoffCount += other.firstMoveBetaCutoffCount;
+        nullMoveSearchCount += other.nullMoveSearchCount;
+        nullMoveCutoffCount += other.nullMoveCutoffCount;
+        lateMoveReductionCount += other.lateMoveReductionCount;
+        lateMoveResearchCount += other.lateMoveResearchCount;
+
+        iterationNodeCounts.resize(std::max(iterationNodeCounts.size(), other.iterationNodeCounts.size()));
+
+        for (auto iterationIndex = 0ull; iterationIndex < other.iterationNodeCounts.size(); iterationIndex++) {
+            iterationNodeCounts[iterationIndex] += other.iterationNodeCounts[iterationIndex];
+        }
+
+        return *this;
+    }
+
+    f64 computeBranchingFactor(const SearchStatistics& statistics, u32 depth) {
+        if (depth < 2 || depth > statistics.iterationNodeCounts.size()) {
+            return 0.0;
+        }
+
+        return computeRatio(statistics.iterationNodeCounts[depth - 1], statistics.iterationNodeCounts[depth - 2]);
+    }
+
+    std::string writeSearchStatisticsInfo(const SearchStatistics& statistics) {
+        auto info = std::format("info string nodes {} qnodes {} ttprobes {} tthits {} ttcutoffs {} betacutoffs {} firstmovecutoffs {} "
+            "nullmoves {} nullmovecutoffs {} reductions {} researches {}\n",
+            statistics.nodeCount, statistics.quiescenceNodeCount, statistics.transpositionProbeCount, statistics.transpositionHitCount,
+            statistics.transpositionCutoffCount, statistics.betaCutoffCount, statistics.firstMoveBetaCutoffCount, statistics.nullMoveSearchCount,
+            statistics.nullMoveCutoffCount, statistics.lateMoveReductionCount, statistics.lateMoveResearchCount);
+
+        info += std::format("info string tthitrate {:.3f} firstmovecutoffrate {:.3f} nullmovecutoffrate {:.3f} researchrate {:.3f}\n",
+            computeRatio(statistics.transpositionHitCount, statistics.transpositionProbeCount),
+            computeRatio(statistics.firstMoveBetaCutoffCount, statistics.betaCutoffCount),
+            computeRatio(statistics.nullMoveCutoffCount, statistics.nullMoveSearchCount),
+            computeRatio(statistics.lateMoveResearchCount, statistics.lateMoveReductionCount));
+
+        for (auto depth = 1u; depth <= statistics.iterationNodeCounts.size(); depth++) {
+            info += std::format("info string depth {} nodes {} ebf {:.2f}\n", depth, statistics.iterationNodeCounts[depth - 1], computeBranchingFactor(statistics, depth));
+        }
+
+        return info;
+    }
+
+    std::string writeSearchStatisticsJson(const SearchStatistics& statistics) {
+        auto json = std::string{ "{\n" };
+
+        json += std::format("  \"nodes\": {},\n", statistics.nodeCount);
+        json += std::format("  \"quiescenceNodes\": {},\n", statistics.quiescenceNodeCount);
+        json += std::format("  \"transpositionProbes\": {},\n", statistics.transpositionProbeCount);
+        json += std::format("  \"transpositionHits\": {},\n", statistics.transpositionHitCount);
+        json += std::format("  \"transpositionCutoffs\": {},\n", statistics.transpositionCutoffCount);
+        json += std::format("  \"betaCutoffs\": {},\n", statistics.betaCutoffCount);
+        json += std::format("  \"firstMoveBetaCutoffs\": {},\n", statistics.firstMoveBetaCutoffCount);
+        json += std::format("  \"nullMoveSearches\": {},\n", statistics.nullMoveSearchCount);
+        json += std::format("  \"nullMoveCutoffs\": {},\n", statistics.nullMoveCutoffCount);
+        json += std::format("  \"lateMoveReductions\": {},\n", statistics.lateMoveReductionCount);
+        json += std::format("  \"lateMoveResearches\": {},\n", statistics.lateMoveResearchCount);
+        json += "  \"iterations\": [";
+
+        for (auto depth = 1u; depth <= statistics.iterationNodeCounts.size(); depth++) {
+            json += std::format("{}\n    {{ \"depth\": {}, \"nodes\": {}, \"branchingFactor\": {:.3f} }}", depth == 1 ? "" : ",",
+                depth, statistics.iterationNodeCounts[depth - 1], computeBranchingFactor(statistics, depth));
+        }
+
+        json += statistics.iterationNodeCounts.empty() ? "]\n" : "\n  ]\n";
+        json += "}\n";
+
+        return json;
+    }
+}
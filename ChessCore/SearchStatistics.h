@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Pandora/Pandora.h"
+
+#include <string>
+#include <vector>
+
+namespace ChessCore {
+
+    // Builds that define CHESSCORE_NO_SEARCH_STATISTICS leave the counters untouched, so they cost nothing.
+#ifdef CHESSCORE_NO_SEARCH_STATISTICS
+    inline constexpr bool IsSearchStatisticsEnabled = false;
+#else
+    inline constexpr bool IsSearchStatisticsEnabled = true;
+#endif
+
+    // Counters of one searcher, so threads never share them; results of several searches are added up with +=.
+    struct SearchStatistics {
+        u64 nodeCount{};
+        u64 quiescenceNodeCount{};
+
+        u64 transpositionProbeCount{};
+        u64 transpositionHitCount{};
+        u64 transpositionCutoffCount{};
+
+        u64 betaCutoffCount{};
+        u64 firstMoveBetaCutoffCount{};
+
+        u64 nullMoveSearchCount{};
+        u64 nullMoveCutoffCount{};
+
+        u64 lateMoveReductionCount{};
+        u64 lateMoveResearchCount{};
+
+        // Nodes of both kinds spent on each iteration of iterative deepening, the first entry is depth 1.
+        std::vector<u64> iterationNodeCounts{};
+
+        SearchStatistics& operator+=(const SearchStatistics& other);
+    };
+
+    // Nodes of an iteration divided by those of the one before, zero when either is missing.
+    f64 computeBranchingFactor(const SearchStatistics& statistics, u32 depth);
+
+    // UCI "info string" lines, one with the totals and one per iteration.
+    std::string writeSearchStatisticsInfo(const SearchStatistics& statistics);
+
+    std::string writeSearchStatisticsJson(const SearchStatistics& statistics);
+}
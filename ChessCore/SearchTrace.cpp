@@ -0,0 +1,193 @@
+#include "SearchTrace.h"
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <stdexcept>
+
+namespace ChessCore {
+
+    static constexpr u32 SearchTraceMagic = 0x43525453;
+    static constexpr u32 SearchTraceVersion = 1;
+
+    static constexpr auto SearchTraceFlushInterval = std::chrono::milliseconds{ 1 };
+
+    struct SearchTraceFileHeader {
+        u32 magic{};
+        u32 version{};
+    };
+
+    SearchTraceBuffer::SearchTraceBuffer(u32 threadIndex, usize capacity)
+        : _events(std::bit_ceil(std::max<usize>(capacity, 1))), _threadIndex(threadIndex) {
+    }
+
+    SearchTraceWriter::SearchTraceWriter(const std::filesystem::path& path, usize bufferCapacity)
+        : _file{ path, std::ios::binary | std::ios::trunc }, _bufferCapacity(bufferCapacity) {
+        if (!IsSearchTraceEnabled) {
+            throw std::runtime_error("Search tracing needs a build with CHESSCORE_SEARCH_TRACE defined");
+        }
+
+        if (!_file) {
+            throw std::runtime_error(std::format("Search trace file {} could not be created", path.string()));
+        }
+
+        const auto header = SearchTraceFileHeader{ SearchTraceMagic, SearchTraceVersion };
+        _file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        _flushThread = std::jthread{ [this](std::stop_token stopToken) {
+            while (!stopToken.stop_requested()) {
+                _flush();
+                std::this_thread::sleep_for(SearchTraceFlushInterval);
+            }
+        } };
+    }
+
+    SearchTraceWriter::~SearchTraceWriter() {
+        _flushThread.request_stop();
+        _flushThread.join();
+
+        // Whatever was recorded after the last pass of the thread.
+        _flush();
+    }
+
+    SearchTraceBuffer& SearchTraceWriter::createBuffer() {
+        const auto lock = std::scoped_lock{ _mutex };
+
+        _buffers.push_back(std::make_unique<SearchTraceBuffer>(static_cast<u32>(_buffers.size()), _bufferCapacity));
+        return *_buffers.back();
+    }
+
+    // The events between tail and head are written in at most two pieces, as they may wrap around the end of the ring.
+    void SearchTraceWriter::_flush() {
+        const auto lock = std::scoped_lock{ _mutex };
+
+        for (const auto& buffer : _buffers) {
+            const auto head = buffer->_head.load(std::memory_order_acquire);
+            const auto tail = buffer->_tail.load(std::memory_order_relaxed);
+
+            if (head == tail) {
+                continue;
+            }
+
+            const auto capacity = buffer->_events.size();
+            const auto eventCount = head - tail;
+            const auto startIndex = tail & (capacity - 1);
+            const auto firstEventCount = std::min<u64>(eventCount, capacity - startIndex);
+
+            const auto chunkHeader = SearchTraceChunkHeader{ buffer->_threadIndex, static_cast<u32>(eventCount),
+                buffer->_droppedEventCount.load(std::memory_order_relaxed) };
+
+            _file.write(reinterpret_cast<const char*>(&chunkHeader), sizeof(chunkHeader));
+            _file.write(reinterpret_cast<const char*>(buffer->_events.data() + startIndex), static_cast<std::streamsize>(firstEventCount * sizeof(SearchTraceEvent)));
+            _file.write(reinterpret_cast<const char*>(buffer->_events.data()), static_cast<std::streamsize>((eventCount - firstEventCount) * sizeof(SearchTraceEvent)));
+
+            buffer->_tail.store(head, std::memory_order_release);
+        }
+
+        _file.flush();
+    }
+
+    std::vector<SearchTraceThread> readSearchTrace(const std::filesystem::path& path) {
+        const auto file = MappedFile{ path };
+        const auto bytes = file.getBytes();
+
+        auto header = SearchTraceFileHeader{};
+
+        if (bytes.size() < sizeof(header)) {
+            throw std::runtime_error(std::format("Search trace file {} is too short", path.string()));
+        }
+
+        std::memcpy(&header, bytes.data(), sizeof(header));
+
+        if (header.magic != SearchTraceMagic || header.version != SearchTraceVersion) {
+            throw std::runtime_error(std::format("{} is not a search trace file", path.string()));
+        }
+
+        auto threads = std::vector<SearchTraceThread>{};
+        auto offset = sizeof(header);
+
+        while (offset < bytes.size()) {
+            auto chunkHeader = SearchTraceChunkHeader{};
+
+            if (bytes.size() - offset < sizeof(chunkHeader)) {
+                throw std::runtime_error("Search trace chunk header is truncated");
+            }
+
+            std::memcpy(&chunkHeader, bytes.data() + offset, sizeof(chunkHeader));
+            offset += sizeof(chunkHeader);
+
+            const auto eventSize = static_cast<usize>(chunkHeader.eventCount) * sizeof(SearchTraceEvent);
+
+            if (bytes.size() - offset < eventSize) {
+                throw std::runtime_error("Search trace chunk is truncated");
+            }
+
+            if (threads.size() <= chunkHeader.threadIndex) {
+                threads.resize(chunkHeader.threadIndex + 1);
+            }
+
+            auto& thread = threads[chunkHeader.threadIndex];
+            thread.threadIndex = chunkHeader.threadIndex;
+            thread.droppedEventCount = chunkHeader.droppedEventCount;
+
+            const auto previousEventCount = thread.events.size();
+            thread.events.resize(previousEventCount + chunkHeader.eventCount);
+            std::memcpy(thread.events.data() + previousEventCount, bytes.data() + offset, eventSize);
+
+            offset += eventSize;
+        }
+
+        return threads;
+    }
+
+    std::string_view mapSearchTraceReasonTypeToString(SearchTraceReasonType type) {
+        switch (type) {
+        case SearchTraceReasonType::None:
+            return "none";
+        case SearchTraceReasonType::Root:
+            return "root";
+        case SearchTraceReasonType::FirstMove:
+            return "first move";
+        case SearchTraceReasonType::ZeroWindow:
+            return "zero window";
+        case SearchTraceReasonType::Reduced:
+            return "reduced";
+        case SearchTraceReasonType::ReducedResearch:
+            return "reduced re-search";
+        case SearchTraceReasonType::WindowResearch:
+            return "window re-search";
+        case SearchTraceReasonType::NullMove:
+            return "null move";
+        case SearchTraceReasonType::Verification:
+            return "verification";
+        case SearchTraceReasonType::Quiescence:
+            return "quiescence";
+        case SearchTraceReasonType::Draw:
+            return "draw";
+        case SearchTraceReasonType::MateDistance:
+            return "mate distance";
+        case SearchTraceReasonType::TranspositionCutoff:
+            return "table cutoff";
+        case SearchTraceReasonType::Tablebase:
+            return "tablebase";
+        case SearchTraceReasonType::ReverseFutility:
+            return "reverse futility";
+        case SearchTraceReasonType::NullMoveCutoff:
+            return "null move cutoff";
+        case SearchTraceReasonType::NoMoves:
+            return "no moves";
+        case SearchTraceReasonType::BetaCutoff:
+            return "beta cutoff";
+        case SearchTraceReasonType::Exact:
+            return "exact";
+        case SearchTraceReasonType::FailLow:
+            return "fail low";
+        case SearchTraceReasonType::Stopped:
+            return "stopped";
+        default:
+            return "unknown";
+        }
+    }
+}
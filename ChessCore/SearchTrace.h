@@ -0,0 +1,145 @@
+#pragma once
+
+#include "Pandora/Pandora.h"
+
+#include <atomic>
+#include <bit>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ChessCore {
+
+    // Tracing is compiled in only for builds that define CHESSCORE_SEARCH_TRACE; otherwise the search has no
+    // tracing code at all.
+#ifdef CHESSCORE_SEARCH_TRACE
+    inline constexpr bool IsSearchTraceEnabled = true;
+#else
+    inline constexpr bool IsSearchTraceEnabled = false;
+#endif
+
+    enum class SearchTraceEventType : u8 {
+        Enter,
+        Exit,
+    };
+
+    // Enter events record how the node was searched, exit events why it returned.
+    enum class SearchTraceReasonType : u8 {
+        None,
+        Root,
+        FirstMove,
+        ZeroWindow,
+        Reduced,
+        ReducedResearch,
+        WindowResearch,
+        NullMove,
+        Verification,
+        Quiescence,
+        Draw,
+        MateDistance,
+        TranspositionCutoff,
+        Tablebase,
+        ReverseFutility,
+        NullMoveCutoff,
+        NoMoves,
+        BetaCutoff,
+        Exact,
+        FailLow,
+        Stopped,
+    };
+
+    inline constexpr usize SearchTraceReasonTypeCount = 21;
+
+    // Moves are encoded as in the transposition table. The node count is the low half of the searcher's count,
+    // so the difference between the enter and exit events of a node is the size of its subtree, quiescence included.
+    struct SearchTraceEvent {
+        u16 move{};
+        u8 ply{};
+        SearchTraceEventType type{};
+        SearchTraceReasonType reason{};
+        i8 depth{};
+        i16 alpha{};
+        i16 beta{};
+        i16 score{};
+        u32 nodeCount{};
+    };
+
+    static_assert(sizeof(SearchTraceEvent) == 16);
+    static_assert(std::is_trivially_copyable_v<SearchTraceEvent>);
+    static_assert(std::endian::native == std::endian::little);
+
+    inline constexpr usize DefaultSearchTraceBufferCapacity = 1 << 18;
+
+    // Single-producer ring buffer: the searching thread appends, the writer's flushing thread drains. When the
+    // writer falls behind, events are dropped and counted instead of stalling the search.
+    class SearchTraceBuffer {
+    public:
+        SearchTraceBuffer(u32 threadIndex, usize capacity);
+
+        void record(const SearchTraceEvent& event) {
+            const auto head = _head.load(std::memory_order_relaxed);
+
+            if (head - _tail.load(std::memory_order_acquire) == _events.size()) {
+                _droppedEventCount.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            _events[head & (_events.size() - 1)] = event;
+            _head.store(head + 1, std::memory_order_release);
+        }
+    private:
+        friend class SearchTraceWriter;
+
+        std::vector<SearchTraceEvent> _events{};
+        u32 _threadIndex{};
+
+        alignas(64) std::atomic<u64> _head{};
+        alignas(64) std::atomic<u64> _tail{};
+        std::atomic<u64> _droppedEventCount{};
+    };
+
+    // Writes the buffers of all searching threads to one binary file from a background thread. The file is a header
+    // followed by chunks, each a SearchTraceChunkHeader and its events; the writer must outlive the searches.
+    class SearchTraceWriter {
+    public:
+        explicit SearchTraceWriter(const std::filesystem::path& path, usize bufferCapacity = DefaultSearchTraceBufferCapacity);
+        ~SearchTraceWriter();
+
+        SearchTraceWriter(const SearchTraceWriter&) = delete;
+        SearchTraceWriter& operator=(const SearchTraceWriter&) = delete;
+
+        // One buffer per searching thread; buffers live as long as the writer.
+        SearchTraceBuffer& createBuffer();
+    private:
+        void _flush();
+
+        std::ofstream _file{};
+        usize _bufferCapacity{};
+
+        std::mutex _mutex{};
+        std::vector<std::unique_ptr<SearchTraceBuffer>> _buffers{};
+
+        std::jthread _flushThread{};
+    };
+
+    struct SearchTraceChunkHeader {
+        u32 threadIndex{};
+        u32 eventCount{};
+        u64 droppedEventCount{};
+    };
+
+    struct SearchTraceThread {
+        u32 threadIndex{};
+        std::vector<SearchTraceEvent> events{};
+        u64 droppedEventCount{};
+    };
+
+    std::vector<SearchTraceThread> readSearchTrace(const std::filesystem::path& path);
+
+    std::string_view mapSearchTraceReasonTypeToString(SearchTraceReasonType type);
+}
@@ -0,0 +1,1250 @@
+// Adapted from src/syzygy/tbprobe.cpp of Stockfish, whose probing code derives from Ronald de Man's original tbprobe:
+//
+//   Stockfish, a UCI chess playing engine derived from Glaurung 2.1
+//   Copyright (C) 2004-2024 The Stockfish developers (see AUTHORS file)
+//
+//   Stockfish is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+//   Stockfish is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//   GNU General Public License for more details.
+//
+//   You should have received a copy of the GNU General Public License
+//   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// The table layout, index computation and decompression follow that file structure for structure; names and
+// integration with Position and MoveGen are this project's. See the license note in README.md.
+
+#include "Syzygy.h"
+#include "MappedFile.h"
+#include "MoveGen.h"
+
+#include <algorithm>
+#include <atomic>
+#include <format>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#ifdef CHESSCORE_SYZYGY
+
+namespace ChessCore::Implementation {
+
+    // Syzygy tables index squares from a1 = 0 to h8 = 63 and pieces as 1 to 6 (pawn to king), plus 8 for black.
+    using SyzygySquare = int;
+
+    inline constexpr usize SyzygyMaximumPieceCount = 7;
+    inline constexpr usize SyzygyMaximumLeadPawnCount = 5;
+    inline constexpr int SyzygyBlackPieceOffset = 8;
+
+    enum class SyzygyTableType : i16 {
+        Wdl,
+        Dtz,
+    };
+
+    enum class SyzygyProbeStateType : i16 {
+        Fail,
+        Ok,
+        ChangeSideToMove,
+        ZeroingBestMove,
+    };
+
+    namespace SyzygyFlags {
+
+        inline constexpr u8 SideToMove = 1;
+        inline constexpr u8 Mapped = 2;
+        inline constexpr u8 WinPlies = 4;
+        inline constexpr u8 LossPlies = 8;
+        inline constexpr u8 Wide = 16;
+        inline constexpr u8 SingleValue = 128;
+    }
+
+    // Decoding state of one Huffman-like compressed sub-table (one side to move and, with pawns, one lead pawn file).
+    struct SyzygyPairsData {
+        u8 flags{};
+        u64 blockSize{};
+        u64 span{};
+        u32 blockCount{};
+        int maximumSymbolLength{};
+        int minimumSymbolLength{};
+
+        const u8* lowestSymbols = nullptr;
+        const u8* symbolTree = nullptr;
+        const u8* blockLengths = nullptr;
+        usize blockLengthCount{};
+        const u8* sparseIndex = nullptr;
+        usize sparseIndexCount{};
+        const u8* data = nullptr;
+
+        std::vector<u64> base64{};
+        std::vector<u8> symbolLengths{};
+
+        std::array<u8, SyzygyMaximumPieceCount> pieces{};
+        std::array<u64, SyzygyMaximumPieceCount + 1> groupIndices{};
+        std::array<int, SyzygyMaximumPieceCount + 1> groupLengths{};
+        std::array<u16, 4> mapIndices{};
+    };
+
+    struct SyzygyTable {
+        SyzygyTableType type{};
+        std::filesystem::path path{};
+
+        u64 key{};
+        u64 mirroredKey{};
+        usize pieceCount{};
+        bool hasPawns{};
+        bool hasUniquePieces{};
+        std::array<u8, 2> pawnCounts{};
+
+        std::atomic<bool> isReady{};
+        std::unique_ptr<MappedFile> file{};
+        const u8* dtzMap = nullptr;
+        std::array<std::array<SyzygyPairsData, 4>, 2> items{};
+
+        SyzygyPairsData& get(usize sideToMove, usize file) {
+            return items[sideToMove % getSideCount()][hasPawns ? file : 0];
+        }
+
+        const SyzygyPairsData& get(usize sideToMove, usize file) const {
+            return items[sideToMove % getSideCount()][hasPawns ? file : 0];
+        }
+
+        usize getSideCount() const {
+            return type == SyzygyTableType::Wdl ? 2 : 1;
+        }
+    };
+
+    struct SyzygyTables {
+        std::vector<std::unique_ptr<SyzygyTable>> tables{};
+        std::unordered_map<u64, std::pair<SyzygyTable*, SyzygyTable*>> tablesByKey{};
+        usize wdlTableCount{};
+        usize maximumPieceCount{};
+        std::mutex mappingMutex{};
+    };
+
+    struct SyzygyIndexTables {
+        std::array<int, BoardSquareCount> mapPawns{};
+        std::array<int, BoardSquareCount> mapB1H1H7{};
+        std::array<int, BoardSquareCount> mapA1D1D4{};
+        std::array<std::array<int, BoardSquareCount>, 10> mapKK{};
+        std::array<std::array<u64, BoardSquareCount>, SyzygyMaximumLeadPawnCount + 1> binomial{};
+        std::array<std::array<u64, BoardSquareCount>, SyzygyMaximumLeadPawnCount + 1> leadPawnIndices{};
+        std::array<std::array<u64, 4>, SyzygyMaximumLeadPawnCount + 1> leadPawnsSizes{};
+    };
+}
+
+namespace ChessCore {
+
+    using namespace Implementation;
+
+    static constexpr u8 SyzygyWdlMagic[] = { 0x71, 0xE8, 0x23, 0x5D };
+    static constexpr u8 SyzygyDtzMagic[] = { 0xD7, 0x66, 0x0C, 0xA5 };
+
+    // Number of positions of the first group when it holds three unique pieces or the two kings.
+    static constexpr u64 SyzygyUniquePiecesIndexSize = 31332;
+    static constexpr u64 SyzygyKingsIndexSize = 462;
+
+    static constexpr std::string_view SyzygyPieceCharacters = " PNBRQK";
+
+    static int getSyzygyFile(SyzygySquare square) {
+        return square & 7;
+    }
+
+    static int getSyzygyRank(SyzygySquare square) {
+        return square >> 3;
+    }
+
+    // Negative below the a1-h8 diagonal, positive above it.
+    static int getSyzygyDiagonalOffset(SyzygySquare square) {
+        return getSyzygyRank(square) - getSyzygyFile(square);
+    }
+
+    static usize mapSyzygySquareToSquareIndex(SyzygySquare square) {
+        return mapFileAndRankToSquareIndex(getSyzygyFile(square), getSyzygyRank(square));
+    }
+
+    static int mapChessPieceTypeToSyzygyPiece(ChessPieceType type) {
+        using enum ChessPieceType;
+
+        switch (type) {
+        case Pawn:
+            return 1;
+        case Knight:
+            return 2;
+        case Bishop:
+            return 3;
+        case Rook:
+            return 4;
+        case Queen:
+            return 5;
+        case King:
+            return 6;
+        default:
+            return 0;
+        }
+    }
+
+    static int mapChessPieceToSyzygyPiece(ChessPiece piece) {
+        const auto syzygyPiece = mapChessPieceTypeToSyzygyPiece(piece.type);
+        return syzygyPiece != 0 && piece.color == ChessPieceColorType::Black ? syzygyPiece + SyzygyBlackPieceOffset : syzygyPiece;
+    }
+
+    static u64 computeMaterialKeyPart(usize colorIndex, int syzygyPiece) {
+        return 1ull << (4 * (colorIndex * 8 + syzygyPiece));
+    }
+
+    static u16 readLittleEndian16(const u8* bytes) {
+        return static_cast<u16>(bytes[0] | bytes[1] << 8);
+    }
+
+    static u32 readLittleEndian32(const u8* bytes) {
+        return static_cast<u32>(bytes[0]) | static_cast<u32>(bytes[1]) << 8 | static_cast<u32>(bytes[2]) << 16 | static_cast<u32>(bytes[3]) << 24;
+    }
+
+    static u64 readBigEndian(const u8* bytes, usize byteCount) {
+        auto value = u64{};
+
+        for (auto byteIndex = 0ull; byteIndex < byteCount; byteIndex++) {
+            value = value << 8 | bytes[byteIndex];
+        }
+
+        return value;
+    }
+
+    static const u8* alignSyzygyData(const u8* data, std::uintptr_t alignment) {
+        const auto address = reinterpret_cast<std::uintptr_t>(data);
+        return data + ((alignment - address % alignment) % alignment);
+    }
+
+    static SyzygyIndexTables createSyzygyIndexTables() {
+        auto tables = SyzygyIndexTables{};
+
+        auto code = 0;
+        for (auto square = 0; square < 64; square++) {
+            if (getSyzygyDiagonalOffset(square) < 0) {
+                tables.mapB1H1H7[square] = code++;
+            }
+        }
+
+        // The a1-d1-d4 triangle is numbered below the diagonal first, then a1, b2, c3 and d4.
+        tables.mapA1D1D4.fill(-1);
+
+        auto diagonalSquares = std::vector<SyzygySquare>{};
+        code = 0;
+
+        for (auto rank = 0; rank < 4; rank++) {
+            for (auto file = 0; file < 4; file++) {
+                const auto square = rank * 8 + file;
+
+                if (getSyzygyDiagonalOffset(square) < 0) {
+                    tables.mapA1D1D4[square] = code++;
+                } else if (getSyzygyDiagonalOffset(square) == 0) {
+                    diagonalSquares.push_back(square);
+                }
+            }
+        }
+
+        for (const auto square : diagonalSquares) {
+            tables.mapA1D1D4[square] = code++;
+        }
+
+        // Both kings: the first one in the triangle, the second one anywhere it is not adjacent to the first.
+        auto bothOnDiagonal = std::vector<std::pair<int, SyzygySquare>>{};
+        code = 0;
+
+        for (auto index = 0; index < 10; index++) {
+            for (auto firstSquare = 0; firstSquare < 64; firstSquare++) {
+                if (tables.mapA1D1D4[firstSquare] != index) {
+                    continue;
+                }
+
+                for (auto secondSquare = 0; secondSquare < 64; secondSquare++) {
+                    const auto fileDistance = std::abs(getSyzygyFile(firstSquare) - getSyzygyFile(secondSquare));
+                    const auto rankDistance = std::abs(getSyzygyRank(firstSquare) - getSyzygyRank(secondSquare));
+
+                    if (fileDistance <= 1 && rankDistance <= 1) {
+                        continue;
+                    }
+
+                    if (getSyzygyDiagonalOffset(firstSquare) == 0 && getSyzygyDiagonalOffset(secondSquare) > 0) {
+                        continue;
+                    }
+
+                    if (getSyzygyDiagonalOffset(firstSquare) == 0 && getSyzygyDiagonalOffset(secondSquare) == 0) {
+                        bothOnDiagonal.emplace_back(index, secondSquare);
+                    } else {
+                        tables.mapKK[index][secondSquare] = code++;
+                    }
+                }
+            }
+        }
+
+        for (const auto& [index, square] : bothOnDiagonal) {
+            tables.mapKK[index][square] = code++;
+        }
+
+        tables.binomial[0][0] = 1;
+
+        for (auto n = 1ull; n < 64; n++) {
+            for (auto k = 0ull; k <= SyzygyMaximumLeadPawnCount && k <= n; k++) {
+                tables.binomial[k][n] = (k > 0 ? tables.binomial[k - 1][n - 1] : 0) + (k < n ? tables.binomial[k][n - 1] : 0);
+            }
+        }
+
+        // Pawn squares a2-h7 are numbered 47 down to 0 from the edge files towards the centre.
+        auto availableSquares = 47;
+
+        for (auto leadPawnCount = 1ull; leadPawnCount <= SyzygyMaximumLeadPawnCount; leadPawnCount++) {
+            for (auto file = 0; file < 4; file++) {
+                auto index = u64{};
+
+                for (auto rank = 1; rank < 7; rank++) {
+                    const auto square = rank * 8 + file;
+
+                    if (leadPawnCount == 1) {
+                        tables.mapPawns[square] = availableSquares--;
+                        tables.mapPawns[square ^ 7] = availableSquares--;
+                    }
+
+                    tables.leadPawnIndices[leadPawnCount][square] = index;
+                    index += tables.binomial[leadPawnCount - 1][tables.mapPawns[square]];
+                }
+
+                tables.leadPawnsSizes[leadPawnCount][file] = index;
+            }
+        }
+
+        return tables;
+    }
+
+    static const SyzygyIndexTables& getSyzygyIndexTables() {
+        static const auto tables = createSyzygyIndexTables();
+        return tables;
+    }
+
+    static u16 getLeftSymbol(const SyzygyPairsData& data, u16 symbol) {
+        const auto* entry = data.symbolTree + 3 * symbol;
+        return static_cast<u16>((entry[1] & 0xF) << 8 | entry[0]);
+    }
+
+    static u16 getRightSymbol(const SyzygyPairsData& data, u16 symbol) {
+        const auto* entry = data.symbolTree + 3 * symbol;
+        return static_cast<u16>(entry[2] << 4 | entry[1] >> 4);
+    }
+
+    static u16 getBlockLength(const SyzygyPairsData& data, u32 block) {
+        return readLittleEndian16(data.blockLengths + 2 * block);
+    }
+
+    static u8 computeSymbolLength(SyzygyPairsData& data, u16 symbol, std::vector<bool>& visited) {
+        visited[symbol] = true;
+
+        const auto rightSymbol = getRightSymbol(data, symbol);
+
+        if (rightSymbol == 0xFFF) {
+            return 0;
+        }
+
+        const auto leftSymbol = getLeftSymbol(data, symbol);
+
+        if (!visited[leftSymbol]) {
+            data.symbolLengths[leftSymbol] = computeSymbolLength(data, leftSymbol, visited);
+        }
+
+        if (!visited[rightSymbol]) {
+            data.symbolLengths[rightSymbol] = computeSymbolLength(data, rightSymbol, visited);
+        }
+
+        return static_cast<u8>(data.symbolLengths[leftSymbol] + data.symbolLengths[rightSymbol] + 1);
+    }
+
+    // Splits the pieces into groups of equal pieces and computes the index multiplier of each group.
+    static void computeGroups(const SyzygyTable& table, SyzygyPairsData& data, const std::array<int, 2>& order, usize file) {
+        const auto& indexTables = getSyzygyIndexTables();
+
+        auto groupCount = 0;
+        auto firstGroupLength = table.hasPawns ? 0 : table.hasUniquePieces ? 3 : 2;
+
+        data.groupLengths[groupCount] = 1;
+
+        for (auto pieceIndex = 1ull; pieceIndex < table.pieceCount; pieceIndex++) {
+            if (--firstGroupLength > 0 || data.pieces[pieceIndex] == data.pieces[pieceIndex - 1]) {
+                data.groupLengths[groupCount]++;
+            } else {
+                data.groupLengths[++groupCount] = 1;
+            }
+        }
+
+        data.groupLengths[++groupCount] = 0;
+
+        const auto hasPawnsOnBothSides = table.hasPawns && table.pawnCounts[1] != 0;
+
+        auto nextGroup = hasPawnsOnBothSides ? 2 : 1;
+        auto freeSquares = 64 - data.groupLengths[0] - (hasPawnsOnBothSides ? data.groupLengths[1] : 0);
+        auto index = u64{ 1 };
+
+        for (auto orderIndex = 0; nextGroup < groupCount || orderIndex == order[0] || orderIndex == order[1]; orderIndex++) {
+            if (orderIndex == order[0]) {
+                data.groupIndices[0] = index;
+                index *= table.hasPawns ? indexTables.leadPawnsSizes[data.groupLengths[0]][file]
+                    : table.hasUniquePieces ? SyzygyUniquePiecesIndexSize : SyzygyKingsIndexSize;
+            } else if (orderIndex == order[1]) {
+                data.groupIndices[1] = index;
+                index *= indexTables.binomial[data.groupLengths[1]][48 - data.groupLengths[0]];
+            } else {
+                data.groupIndices[nextGroup] = index;
+                index *= indexTables.binomial[data.groupLengths[nextGroup]][freeSquares];
+                freeSquares -= data.groupLengths[nextGroup++];
+            }
+        }
+
+        data.groupIndices[groupCount] = index;
+    }
+
+    static const u8* readPairsDataSizes(SyzygyPairsData& data, const u8* bytes) {
+        data.flags = *bytes++;
+
+        // Single value tables store their value in place of the minimum symbol length.
+        if ((data.flags & SyzygyFlags::SingleValue) != 0) {
+            data.minimumSymbolLength = *bytes++;
+            return bytes;
+        }
+
+        const auto lastGroup = std::find(data.groupLengths.begin(), data.groupLengths.end(), 0) - data.groupLengths.begin();
+        const auto tableSize = data.groupIndices[lastGroup];
+
+        data.blockSize = 1ull << *bytes++;
+        data.span = 1ull << *bytes++;
+        data.sparseIndexCount = static_cast<usize>((tableSize + data.span - 1) / data.span);
+
+        const auto padding = *bytes++;
+
+        data.blockCount = readLittleEndian32(bytes);
+        bytes += 4;
+
+        data.blockLengthCount = data.blockCount + padding;
+        data.maximumSymbolLength = *bytes++;
+        data.minimumSymbolLength = *bytes++;
+        data.lowestSymbols = bytes;
+        data.base64.resize(data.maximumSymbolLength - data.minimumSymbolLength + 1);
+
+        // Canonical Huffman codes: base64[length] is the smallest code of that length, left-aligned to 64 bits.
+        for (auto lengthIndex = static_cast<int>(data.base64.size()) - 2; lengthIndex >= 0; lengthIndex--) {
+            const auto lowestSymbol = readLittleEndian16(data.lowestSymbols + 2 * lengthIndex);
+            const auto nextLowestSymbol = readLittleEndian16(data.lowestSymbols + 2 * (lengthIndex + 1));
+
+            data.base64[lengthIndex] = (data.base64[lengthIndex + 1] + lowestSymbol - nextLowestSymbol) / 2;
+        }
+
+        for (auto lengthIndex = 0ull; lengthIndex < data.base64.size(); lengthIndex++) {
+            data.base64[lengthIndex] <<= 64 - lengthIndex - data.minimumSymbolLength;
+        }
+
+        bytes += data.base64.size() * 2;
+
+        data.symbolLengths.resize(readLittleEndian16(bytes));
+        bytes += 2;
+
+        data.symbolTree = bytes;
+
+        auto visited = std::vector<bool>(data.symbolLengths.size());
+
+        for (auto symbol = 0ull; symbol < data.symbolLengths.size(); symbol++) {
+            if (!visited[symbol]) {
+                data.symbolLengths[symbol] = computeSymbolLength(data, static_cast<u16>(symbol), visited);
+            }
+        }
+
+        return bytes + data.symbolLengths.size() * 3 + (data.symbolLengths.size() & 1);
+    }
+
+    static const u8* readDtzMap(SyzygyTable& table, const u8* bytes, usize maximumFile) {
+        table.dtzMap = bytes;
+
+        for (auto file = 0ull; file <= maximumFile; file++) {
+            auto& data = table.get(0, file);
+
+            if ((data.flags & SyzygyFlags::Mapped) == 0) {
+                continue;
+            }
+
+            if ((data.flags & SyzygyFlags::Wide) != 0) {
+                bytes = alignSyzygyData(bytes, 2);
+
+                for (auto& mapIndex : data.mapIndices) {
+                    mapIndex = static_cast<u16>((bytes - table.dtzMap) / 2 + 1);
+                    bytes += 2 * readLittleEndian16(bytes) + 2;
+                }
+            } else {
+                for (auto& mapIndex : data.mapIndices) {
+                    mapIndex = static_cast<u16>(bytes - table.dtzMap + 1);
+                    bytes += *bytes + 1;
+                }
+            }
+        }
+
+        return alignSyzygyData(bytes, 2);
+    }
+
+    static void readTable(SyzygyTable& table, const u8* bytes) {
+        // The first byte holds flags already known from the table name.
+        bytes++;
+
+        const auto sideCount = table.type == SyzygyTableType::Wdl && table.key != table.mirroredKey ? 2ull : 1ull;
+        const auto maximumFile = table.hasPawns ? 3ull : 0ull;
+        const auto hasPawnsOnBothSides = table.hasPawns && table.pawnCounts[1] != 0;
+
+        for (auto file = 0ull; file <= maximumFile; file++) {
+            const auto orders = std::array{
+                std::array{ bytes[0] & 0xF, hasPawnsOnBothSides ? bytes[1] & 0xF : 0xF },
+                std::array{ bytes[0] >> 4, hasPawnsOnBothSides ? bytes[1] >> 4 : 0xF },
+            };
+
+            bytes += hasPawnsOnBothSides ? 2 : 1;
+
+            for (auto pieceIndex = 0ull; pieceIndex < table.pieceCount; pieceIndex++, bytes++) {
+                for (auto side = 0ull; side < sideCount; side++) {
+                    table.get(side, file).pieces[pieceIndex] = static_cast<u8>(side != 0 ? *bytes >> 4 : *bytes & 0xF);
+                }
+            }
+
+            for (auto side = 0ull; side < sideCount; side++) {
+                computeGroups(table, table.get(side, file), orders[side], file);
+            }
+        }
+
+        bytes = alignSyzygyData(bytes, 2);
+
+        for (auto file = 0ull; file <= maximumFile; file++) {
+            for (auto side = 0ull; side < sideCount; side++) {
+                bytes = readPairsDataSizes(table.get(side, file), bytes);
+            }
+        }
+
+        if (table.type == SyzygyTableType::Dtz) {
+            bytes = readDtzMap(table, bytes, maximumFile);
+        }
+
+        for (auto file = 0ull; file <= maximumFile; file++) {
+            for (auto side = 0ull; side < sideCount; side++) {
+                auto& data = table.get(side, file);
+                data.sparseIndex = bytes;
+                bytes += data.sparseIndexCount * 6;
+            }
+        }
+
+        for (auto file = 0ull; file <= maximumFile; file++) {
+            for (auto side = 0ull; side < sideCount; side++) {
+                auto& data = table.get(side, file);
+                data.blockLengths = bytes;
+                bytes += data.blockLengthCount * 2;
+            }
+        }
+
+        for (auto file = 0ull; file <= maximumFile; file++) {
+            for (auto side = 0ull; side < sideCount; side++) {
+                auto& data = table.get(side, file);
+                bytes = alignSyzygyData(bytes, 64);
+                data.data = bytes;
+                bytes += data.blockCount * data.blockSize;
+            }
+        }
+    }
+
+    static bool mapTable(SyzygyTables& tables, SyzygyTable& table) {
+        if (table.isReady.load(std::memory_order_acquire)) {
+            return table.file != nullptr;
+        }
+
+        const auto lock = std::scoped_lock{ tables.mappingMutex };
+
+        if (table.isReady.load(std::memory_order_relaxed)) {
+            return table.file != nullptr;
+        }
+
+        // A missing or corrupt file only makes probes of this table fail.
+        try {
+            table.file = std::make_unique<MappedFile>(table.path, MappedFileAccessType::Random);
+        } catch (const std::runtime_error&) {
+            table.file = nullptr;
+        }
+
+        if (table.file) {
+            const auto bytes = table.file->getBytes();
+            const auto& magic = table.type == SyzygyTableType::Wdl ? SyzygyWdlMagic : SyzygyDtzMagic;
+            const auto hasPawnsFlag = bytes.size() > std::size(magic) && (bytes[std::size(magic)] & 2) != 0;
+
+            if (bytes.size() <= std::size(magic) || !std::equal(std::begin(magic), std::end(magic), bytes.begin()) || hasPawnsFlag != table.hasPawns) {
+                table.file = nullptr;
+            } else {
+                readTable(table, bytes.data() + std::size(magic));
+            }
+        }
+
+        table.isReady.store(true, std::memory_order_release);
+
+        return table.file != nullptr;
+    }
+
+    static int decompressPairs(const SyzygyPairsData& data, u64 index) {
+        if ((data.flags & SyzygyFlags::SingleValue) != 0) {
+            return data.minimumSymbolLength;
+        }
+
+        // The sparse index points into the block holding the middle of the span that contains the index.
+        const auto* sparseEntry = data.sparseIndex + 6 * (index / data.span);
+
+        auto block = readLittleEndian32(sparseEntry);
+        auto offset = static_cast<i64>(readLittleEndian16(sparseEntry + 4));
+
+        offset += static_cast<i64>(index % data.span) - static_cast<i64>(data.span / 2);
+
+        while (offset < 0) {
+            offset += getBlockLength(data, --block) + 1;
+        }
+
+        while (offset > getBlockLength(data, block)) {
+            offset -= getBlockLength(data, block++) + 1;
+        }
+
+        const auto* bytes = data.data + block * data.blockSize;
+
+        auto buffer = readBigEndian(bytes, 8);
+        auto bufferSize = 64;
+        auto symbol = u16{};
+
+        bytes += 8;
+
+        while (true) {
+            auto length = 0;
+
+            while (buffer < data.base64[length]) {
+                length++;
+            }
+
+            symbol = static_cast<u16>((buffer - data.base64[length]) >> (64 - length - data.minimumSymbolLength));
+            symbol += readLittleEndian16(data.lowestSymbols + 2 * length);
+
+            if (offset < data.symbolLengths[symbol] + 1) {
+                break;
+            }
+
+            offset -= data.symbolLengths[symbol] + 1;
+            length += data.minimumSymbolLength;
+            buffer <<= length;
+            bufferSize -= length;
+
+            if (bufferSize <= 32) {
+                bufferSize += 32;
+                buffer |= readBigEndian(bytes, 4) << (64 - bufferSize);
+                bytes += 4;
+            }
+        }
+
+        // Walk down the pair tree to the value at the offset inside the symbol.
+        while (data.symbolLengths[symbol] != 0) {
+            const auto leftSymbol = getLeftSymbol(data, symbol);
+
+            if (offset < data.symbolLengths[leftSymbol] + 1) {
+                symbol = leftSymbol;
+            } else {
+                offset -= data.symbolLengths[leftSymbol] + 1;
+                symbol = getRightSymbol(data, symbol);
+            }
+        }
+
+        return getLeftSymbol(data, symbol);
+    }
+
+    static int mapSyzygyValueToScore(const SyzygyTable& table, usize file, int value, int wdl) {
+        if (table.type == SyzygyTableType::Wdl) {
+            return value - 2;
+        }
+
+        static constexpr int WdlToMapIndex[] = { 1, 3, 0, 2, 0 };
+
+        const auto& data = table.get(0, file);
+
+        if ((data.flags & SyzygyFlags::Mapped) != 0) {
+            const auto mapIndex = data.mapIndices[WdlToMapIndex[wdl + 2]];
+
+            if ((data.flags & SyzygyFlags::Wide) != 0) {
+                value = readLittleEndian16(table.dtzMap + 2 * (mapIndex + value));
+            } else {
+                value = table.dtzMap[mapIndex + value];
+            }
+        }
+
+        const auto isStoredInMoves = (wdl == 2 && (data.flags & SyzygyFlags::WinPlies) == 0)
+            || (wdl == -2 && (data.flags & SyzygyFlags::LossPlies) == 0)
+            || wdl == 1
+            || wdl == -1;
+
+        if (isStoredInMoves) {
+            value *= 2;
+        }
+
+        return value + 1;
+    }
+
+    static u64 computeMaterialKey(const Position& position, usize& pieceCount) {
+        auto key = u64{};
+        pieceCount = 0;
+
+        for (const auto piece : position.getBoard()) {
+            if (piece == ChessPieces::None) {
+                continue;
+            }
+
+            key += computeMaterialKeyPart(piece.color == ChessPieceColorType::White ? 0 : 1, mapChessPieceTypeToSyzygyPiece(piece.type));
+            pieceCount++;
+        }
+
+        return key;
+    }
+
+    static int probeMappedTable(const SyzygyTable& table, const Position& position, u64 materialKey, int wdl, SyzygyProbeStateType& state) {
+        const auto& indexTables = getSyzygyIndexTables();
+
+        auto boardPieces = std::array<int, BoardSquareCount>{};
+
+        for (auto square = 0; square < 64; square++) {
+            boardPieces[square] = mapChessPieceToSyzygyPiece(position.getPiece(mapSyzygySquareToSquareIndex(square)));
+        }
+
+        // Tables are stored with the stronger side as white, so the board is mirrored when black is stronger.
+        const auto isBlackToMove = position.getSideToMove() == ChessPieceColorType::Black;
+        const auto isSymmetricBlackToMove = table.key == table.mirroredKey && isBlackToMove;
+        const auto isBlackStronger = materialKey != table.key;
+        const auto isFlipped = isSymmetricBlackToMove || isBlackStronger;
+
+        const auto flipColor = isFlipped ? SyzygyBlackPieceOffset : 0;
+        const auto flipSquares = isFlipped ? 56 : 0;
+        const auto sideToMove = static_cast<usize>(isFlipped != isBlackToMove ? 1 : 0);
+
+        auto squares = std::array<SyzygySquare, SyzygyMaximumPieceCount>{};
+        auto pieces = std::array<int, SyzygyMaximumPieceCount>{};
+        auto size = 0ull;
+        auto leadPawnCount = 0ull;
+        auto leadPawn = 0;
+        auto file = 0ull;
+
+        const auto compareMappedPawns = [&indexTables](SyzygySquare first, SyzygySquare second) {
+            return indexTables.mapPawns[first] < indexTables.mapPawns[second];
+        };
+
+        if (table.hasPawns) {
+            leadPawn = table.get(0, 0).pieces[0] ^ flipColor;
+
+            for (auto square = 0; square < 64; square++) {
+                if (boardPieces[square] == leadPawn) {
+                    squares[size++] = square ^ flipSquares;
+                }
+            }
+
+            leadPawnCount = size;
+
+            std::swap(squares[0], *std::max_element(squares.begin(), squares.begin() + leadPawnCount, compareMappedPawns));
+
+            const auto leadFile = getSyzygyFile(squares[0]);
+            file = static_cast<usize>(std::min(leadFile, 7 - leadFile));
+        }
+
+        if (table.type == SyzygyTableType::Dtz) {
+            const auto flags = table.get(sideToMove, file).flags;
+            const auto isStoredSideToMove = (flags & SyzygyFlags::SideToMove) == sideToMove;
+
+            if (!isStoredSideToMove && (table.key != table.mirroredKey || table.hasPawns)) {
+                state = SyzygyProbeStateType::ChangeSideToMove;
+                return 0;
+            }
+        }
+
+        for (auto square = 0; square < 64; square++) {
+            const auto piece = boardPieces[square];
+
+            if (piece == 0 || (table.hasPawns && piece == leadPawn)) {
+                continue;
+            }
+
+            squares[size] = square ^ flipSquares;
+            pieces[size++] = piece ^ flipColor;
+        }
+
+        const auto& data = table.get(sideToMove, file);
+
+        // Order the pieces the way the table stores them.
+        for (auto pieceIndex = leadPawnCount; pieceIndex + 1 < size; pieceIndex++) {
+            for (auto otherIndex = pieceIndex + 1; otherIndex < size; otherIndex++) {
+                if (data.pieces[pieceIndex] == pieces[otherIndex]) {
+                    std::swap(pieces[pieceIndex], pieces[otherIndex]);
+                    std::swap(squares[pieceIndex], squares[otherIndex]);
+                    break;
+                }
+            }
+        }
+
+        // Mirror so the leading piece stands on files a-d.
+        if (getSyzygyFile(squares[0]) > 3) {
+            for (auto pieceIndex = 0ull; pieceIndex < size; pieceIndex++) {
+                squares[pieceIndex] ^= 7;
+            }
+        }
+
+        auto index = u64{};
+
+        if (table.hasPawns) {
+            index = indexTables.leadPawnIndices[leadPawnCount][squares[0]];
+
+            std::stable_sort(squares.begin() + 1, squares.begin() + leadPawnCount, compareMappedPawns);
+
+            for (auto pieceIndex = 1ull; pieceIndex < leadPawnCount; pieceIndex++) {
+                index += indexTables.binomial[pieceIndex][indexTables.mapPawns[squares[pieceIndex]]];
+            }
+        } else {
+            // Without pawns the board is further mirrored into the a1-d1-d4 triangle.
+            if (getSyzygyRank(squares[0]) > 3) {
+                for (auto pieceIndex = 0ull; pieceIndex < size; pieceIndex++) {
+                    squares[pieceIndex] ^= 56;
+                }
+            }
+
+            for (auto pieceIndex = 0; pieceIndex < data.groupLengths[0]; pieceIndex++) {
+                const auto diagonalOffset = getSyzygyDiagonalOffset(squares[pieceIndex]);
+
+                if (diagonalOffset == 0) {
+                    continue;
+                }
+
+                if (diagonalOffset > 0) {
+                    for (auto otherIndex = static_cast<usize>(pieceIndex); otherIndex < size; otherIndex++) {
+                        squares[otherIndex] = ((squares[otherIndex] >> 3) | (squares[otherIndex] << 3)) & 63;
+                    }
+                }
+
+                break;
+            }
+
+            if (table.hasUniquePieces) {
+                const auto adjustment1 = squares[1] > squares[0] ? 1 : 0;
+                const auto adjustment2 = (squares[2] > squares[0] ? 1 : 0) + (squares[2] > squares[1] ? 1 : 0);
+
+                if (getSyzygyDiagonalOffset(squares[0]) != 0) {
+                    index = static_cast<u64>((indexTables.mapA1D1D4[squares[0]] * 63 + (squares[1] - adjustment1)) * 62 + squares[2] - adjustment2);
+                } else if (getSyzygyDiagonalOffset(squares[1]) != 0) {
+                    index = static_cast<u64>((6 * 63 + getSyzygyRank(squares[0]) * 28 + indexTables.mapB1H1H7[squares[1]]) * 62 + squares[2] - adjustment2);
+                } else if (getSyzygyDiagonalOffset(squares[2]) != 0) {
+                    index = static_cast<u64>(6 * 63 * 62 + 4 * 28 * 62 + getSyzygyRank(squares[0]) * 7 * 28
+                        + (getSyzygyRank(squares[1]) - adjustment1) * 28 + indexTables.mapB1H1H7[squares[2]]);
+                } else {
+                    index = static_cast<u64>(6 * 63 * 62 + 4 * 28 * 62 + 4 * 7 * 28 + getSyzygyRank(squares[0]) * 7 * 6
+                        + (getSyzygyRank(squares[1]) - adjustment1) * 6 + (getSyzygyRank(squares[2]) - adjustment2));
+                }
+            } else {
+                index = static_cast<u64>(indexTables.mapKK[indexTables.mapA1D1D4[squares[0]]][squares[1]]);
+            }
+        }
+
+        index *= data.groupIndices[0];
+
+        // Every remaining group of equal pieces is a combination of the squares not taken by earlier groups.
+        auto* groupSquares = squares.data() + data.groupLengths[0];
+        auto hasRemainingPawns = table.hasPawns && table.pawnCounts[1] != 0;
+
+        for (auto group = 1; data.groupLengths[group] != 0; group++) {
+            std::stable_sort(groupSquares, groupSquares + data.groupLengths[group]);
+
+            auto groupIndex = u64{};
+
+            for (auto pieceIndex = 0; pieceIndex < data.groupLengths[group]; pieceIndex++) {
+                const auto square = groupSquares[pieceIndex];
+                const auto adjustment = std::count_if(squares.data(), groupSquares, [square](SyzygySquare other) {
+                    return square > other;
+                });
+
+                groupIndex += indexTables.binomial[pieceIndex + 1][square - adjustment - (hasRemainingPawns ? 8 : 0)];
+            }
+
+            hasRemainingPawns = false;
+            index += groupIndex * data.groupIndices[group];
+            groupSquares += data.groupLengths[group];
+        }
+
+        return mapSyzygyValueToScore(table, file, decompressPairs(data, index), wdl);
+    }
+
+    static int probeTable(SyzygyTables& tables, SyzygyTableType type, const Position& position, int wdl, SyzygyProbeStateType& state) {
+        auto pieceCount = usize{};
+        const auto materialKey = computeMaterialKey(position, pieceCount);
+
+        // Two bare kings are a draw and have no table.
+        if (pieceCount == 2) {
+            return 0;
+        }
+
+        const auto tableIterator = tables.tablesByKey.find(materialKey);
+
+        if (tableIterator == tables.tablesByKey.end()) {
+            state = SyzygyProbeStateType::Fail;
+            return 0;
+        }
+
+        auto* table = type == SyzygyTableType::Wdl ? tableIterator->second.first : tableIterator->second.second;
+
+        if (!mapTable(tables, *table)) {
+            state = SyzygyProbeStateType::Fail;
+            return 0;
+        }
+
+        return probeMappedTable(*table, position, materialKey, wdl, state);
+    }
+
+    static bool isZeroingMove(const Position& position, const ChessMove& move) {
+        return move.isEnPassant
+            || position.getPiece(move.targetSquareIndex) != ChessPieces::None
+            || position.getPiece(move.startingSquareIndex).type == ChessPieceType::Pawn;
+    }
+
+    static bool isCaptureMove(const Position& position, const ChessMove& move) {
+        return move.isEnPassant || position.getPiece(move.targetSquareIndex) != ChessPieces::None;
+    }
+
+    // Tables assume captures are never the best move, so they are searched first. With checkZeroingMoves
+    // pawn moves are searched too, which tells whether the best move resets the 50-move counter.
+    static int searchWdl(SyzygyTables& tables, const Position& position, bool checkZeroingMoves, SyzygyProbeStateType& state) {
+        const auto moves = computeLegalMoves(position);
+
+        auto bestValue = -2;
+        auto searchedMoveCount = 0ull;
+
+        for (const auto& move : moves) {
+            const auto isSearched = checkZeroingMoves ? isZeroingMove(position, move) : isCaptureMove(position, move);
+
+            if (!isSearched) {
+                continue;
+            }
+
+            searchedMoveCount++;
+
+            auto nextPosition = position;
+            nextPosition.makeMove(move);
+
+            const auto value = -searchWdl(tables, nextPosition, false, state);
+
+            if (state == SyzygyProbeStateType::Fail) {
+                return 0;
+            }
+
+            if (value > bestValue) {
+                bestValue = value;
+
+                if (value >= 2) {
+                    state = SyzygyProbeStateType::ZeroingBestMove;
+                    return value;
+                }
+            }
+        }
+
+        const auto areAllMovesSearched = searchedMoveCount != 0 && searchedMoveCount == moves.size();
+
+        auto value = bestValue;
+
+        if (!areAllMovesSearched) {
+            value = probeTable(tables, SyzygyTableType::Wdl, position, 0, state);
+
+            if (state == SyzygyProbeStateType::Fail) {
+                return 0;
+            }
+        }
+
+        if (bestValue >= value) {
+            state = bestValue > 0 || areAllMovesSearched ? SyzygyProbeStateType::ZeroingBestMove : SyzygyProbeStateType::Ok;
+            return bestValue;
+        }
+
+        state = SyzygyProbeStateType::Ok;
+        return value;
+    }
+
+    static int mapWdlToDtzBeforeZeroing(int wdl) {
+        switch (wdl) {
+        case 2:
+            return 1;
+        case 1:
+            return 101;
+        case -1:
+            return -101;
+        case -2:
+            return -1;
+        default:
+            return 0;
+        }
+    }
+
+    static int getSign(int value) {
+        return (value > 0) - (value < 0);
+    }
+
+    static int probeDtzValue(SyzygyTables& tables, const Position& position, SyzygyProbeStateType& state) {
+        state = SyzygyProbeStateType::Ok;
+
+        const auto wdl = searchWdl(tables, position, true, state);
+
+        if (state == SyzygyProbeStateType::Fail || wdl == 0) {
+            return 0;
+        }
+
+        if (state == SyzygyProbeStateType::ZeroingBestMove) {
+            return mapWdlToDtzBeforeZeroing(wdl);
+        }
+
+        const auto dtz = probeTable(tables, SyzygyTableType::Dtz, position, wdl, state);
+
+        if (state == SyzygyProbeStateType::Fail) {
+            return 0;
+        }
+
+        if (state != SyzygyProbeStateType::ChangeSideToMove) {
+            return (dtz + (wdl == -1 || wdl == 1 ? 100 : 0)) * getSign(wdl);
+        }
+
+        // The table only stores the other side to move, so do a 1-ply search.
+        auto minimumDtz = 0xFFFF;
+
+        for (const auto& move : computeLegalMoves(position)) {
+            const auto isZeroing = isZeroingMove(position, move);
+
+            auto nextPosition = position;
+            nextPosition.makeMove(move);
+
+            auto moveDtz = isZeroing
+                ? -mapWdlToDtzBeforeZeroing(searchWdl(tables, nextPosition, false, state))
+                : -probeDtzValue(tables, nextPosition, state);
+
+            if (moveDtz == 1 && nextPosition.isKingUnderCheck() && !hasLegalMoves(nextPosition)) {
+                minimumDtz = 1;
+            }
+
+            if (!isZeroing) {
+                moveDtz += getSign(moveDtz);
+            }
+
+            if (moveDtz < minimumDtz && getSign(moveDtz) == getSign(wdl)) {
+                minimumDtz = moveDtz;
+            }
+
+            if (state == SyzygyProbeStateType::Fail) {
+                return 0;
+            }
+        }
+
+        return minimumDtz == 0xFFFF ? -1 : minimumDtz;
+    }
+
+    static bool parseSyzygyTableName(std::string_view name, SyzygyTable& table) {
+        const auto separatorIndex = name.find('v');
+
+        if (separatorIndex == std::string_view::npos || name.size() - 1 > SyzygyMaximumPieceCount) {
+            return false;
+        }
+
+        const auto sides = std::array{ name.substr(0, separatorIndex), name.substr(separatorIndex + 1) };
+        auto pieceCounts = std::array<std::array<u8, 7>, 2>{};
+
+        for (auto side = 0ull; side < sides.size(); side++) {
+            if (!sides[side].starts_with('K')) {
+                return false;
+            }
+
+            for (const auto character : sides[side]) {
+                const auto piece = SyzygyPieceCharacters.find(character);
+
+                if (piece == std::string_view::npos || piece == 0) {
+                    return false;
+                }
+
+                pieceCounts[side][piece]++;
+            }
+
+            if (pieceCounts[side][6] != 1) {
+                return false;
+            }
+        }
+
+        for (auto side = 0ull; side < sides.size(); side++) {
+            for (auto piece = 1; piece <= 6; piece++) {
+                table.key += pieceCounts[side][piece] * computeMaterialKeyPart(side, piece);
+                table.mirroredKey += pieceCounts[side][piece] * computeMaterialKeyPart(1 - side, piece);
+
+                if (piece != 6 && pieceCounts[side][piece] == 1) {
+                    table.hasUniquePieces = true;
+                }
+            }
+        }
+
+        const auto whitePawnCount = pieceCounts[0][1];
+        const auto blackPawnCount = pieceCounts[1][1];
+
+        // The lead pawns belong to the side with fewer pawns, or white when both have the same number.
+        const auto isWhiteLeading = blackPawnCount == 0 || (whitePawnCount != 0 && blackPawnCount >= whitePawnCount);
+
+        table.pieceCount = name.size() - 1;
+        table.hasPawns = whitePawnCount + blackPawnCount != 0;
+        table.pawnCounts = isWhiteLeading ? std::array{ whitePawnCount, blackPawnCount } : std::array{ blackPawnCount, whitePawnCount };
+
+        return true;
+    }
+
+    SyzygyTablebase::SyzygyTablebase(const std::filesystem::path& directory)
+        : _tables(std::make_unique<SyzygyTables>()) {
+        if (!std::filesystem::is_directory(directory)) {
+            throw std::runtime_error(std::format("Directory {} does not exist", directory.string()));
+        }
+
+        for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+            if (!entry.is_regular_file() || entry.path().extension() != ".rtbw") {
+                continue;
+            }
+
+            auto wdlTable = std::make_unique<SyzygyTable>();
+
+            if (!parseSyzygyTableName(entry.path().stem().string(), *wdlTable) || _tables->tablesByKey.contains(wdlTable->key)) {
+                continue;
+            }
+
+            // DTZ tables are optional, a missing file only makes DTZ probes of that material fail.
+            auto dtzTable = std::make_unique<SyzygyTable>();
+            parseSyzygyTableName(entry.path().stem().string(), *dtzTable);
+
+            wdlTable->type = SyzygyTableType::Wdl;
+            wdlTable->path = entry.path();
+            dtzTable->type = SyzygyTableType::Dtz;
+            dtzTable->path = std::filesystem::path{ entry.path() }.replace_extension(".rtbz");
+
+            _tables->tablesByKey[wdlTable->key] = { wdlTable.get(), dtzTable.get() };
+            _tables->tablesByKey[wdlTable->mirroredKey] = { wdlTable.get(), dtzTable.get() };
+            _tables->maximumPieceCount = std::max(_tables->maximumPieceCount, wdlTable->pieceCount);
+            _tables->wdlTableCount++;
+
+            _tables->tables.push_back(std::move(wdlTable));
+            _tables->tables.push_back(std::move(dtzTable));
+        }
+    }
+
+    SyzygyTablebase::~SyzygyTablebase() = default;
+
+    usize SyzygyTablebase::getTableCount() const {
+        return _tables->wdlTableCount;
+    }
+
+    usize SyzygyTablebase::getMaximumPieceCount() const {
+        return _tables->maximumPieceCount;
+    }
+
+    bool SyzygyTablebase::canProbe(const Position& position) const {
+        if (position.getCastlingRights() != CastlingRights::None) {
+            return false;
+        }
+
+        const auto pieceCount = std::count_if(position.getBoard().begin(), position.getBoard().end(), [](ChessPiece piece) {
+            return piece != ChessPieces::None;
+        });
+
+        return static_cast<usize>(pieceCount) <= _tables->maximumPieceCount;
+    }
+
+    std::optional<SyzygyWdlType> SyzygyTablebase::probeWdl(const Position& position) const {
+        if (!canProbe(position)) {
+            return std::nullopt;
+        }
+
+        auto state = SyzygyProbeStateType::Ok;
+        const auto wdl = searchWdl(*_tables, position, false, state);
+
+        if (state == SyzygyProbeStateType::Fail) {
+            return std::nullopt;
+        }
+
+        return static_cast<SyzygyWdlType>(wdl);
+    }
+
+    std::optional<i32> SyzygyTablebase::probeDtz(const Position& position) const {
+        if (!canProbe(position)) {
+            return std::nullopt;
+        }
+
+        auto state = SyzygyProbeStateType::Ok;
+        const auto dtz = probeDtzValue(*_tables, position, state);
+
+        if (state == SyzygyProbeStateType::Fail) {
+            return std::nullopt;
+        }
+
+        return dtz;
+    }
+}
+
+#else
+
+namespace ChessCore::Implementation {
+
+    struct SyzygyTables {};
+}
+
+namespace ChessCore {
+
+    SyzygyTablebase::SyzygyTablebase(const std::filesystem::path&) {
+        throw std::runtime_error("Syzygy tablebases need a build with CHESSCORE_SYZYGY defined");
+    }
+
+    SyzygyTablebase::~SyzygyTablebase() = default;
+
+    usize SyzygyTablebase::getTableCount() const {
+        return 0;
+    }
+
+    usize SyzygyTablebase::getMaximumPieceCount() const {
+        return 0;
+    }
+
+    bool SyzygyTablebase::canProbe(const Position&) const {
+        return false;
+    }
+
+    std::optional<SyzygyWdlType> SyzygyTablebase::probeWdl(const Position&) const {
+        return std::nullopt;
+    }
+
+    std::optional<i32> SyzygyTablebase::probeDtz(const Position&) const {
+        return std::nullopt;
+    }
+}
+
+#endif
+
+namespace ChessCore {
+
+    std::string_view mapSyzygyWdlTypeToString(SyzygyWdlType type) {
+        using enum SyzygyWdlType;
+
+        switch (type) {
+        case Loss:
+            return "Loss";
+        case BlessedLoss:
+            return "Blessed loss";
+        case Draw:
+            return "Draw";
+        case CursedWin:
+            return "Cursed win";
+        case Win:
+            return "Win";
+        default:
+            throw std::runtime_error("Unreachable");
+        }
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Position.h"
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+
+namespace ChessCore::Implementation {
+    struct SyzygyTables;
+}
+
+namespace ChessCore {
+
+    // The prober is adapted from Stockfish under GPLv3 and has not been checked against real tables here, so it is
+    // compiled in only for builds that define CHESSCORE_SYZYGY; otherwise constructing a tablebase throws and the
+    // search never probes.
+#ifdef CHESSCORE_SYZYGY
+    inline constexpr bool IsSyzygyEnabled = true;
+#else
+    inline constexpr bool IsSyzygyEnabled = false;
+#endif
+
+    enum class SyzygyWdlType : i16 {
+        Loss = -2,
+        BlessedLoss = -1,
+        Draw = 0,
+        CursedWin = 1,
+        Win = 2,
+    };
+
+    // Probes Syzygy WDL (.rtbw) and DTZ (.rtbz) tables found in a local directory. Only file names are read
+    // on construction; a table is memory-mapped on its first probe and decompressed one block at a time.
+    // Probing is thread safe.
+    class SyzygyTablebase {
+    public:
+        explicit SyzygyTablebase(const std::filesystem::path& directory);
+        ~SyzygyTablebase();
+
+        SyzygyTablebase(const SyzygyTablebase&) = delete;
+        SyzygyTablebase& operator=(const SyzygyTablebase&) = delete;
+
+        usize getTableCount() const;
+        usize getMaximumPieceCount() const;
+
+        // Tables do not store castling rights, so positions with them are never probed.
+        bool canProbe(const Position& position) const;
+
+        // Win, draw or loss for the side to move, where cursed wins and blessed losses are draws under the 50-move rule.
+        std::optional<SyzygyWdlType> probeWdl(const Position& position) const;
+
+        // Plies to the next capture or pawn move with optimal play, positive when the side to move wins.
+        // Values beyond 100 in magnitude are cursed wins or blessed losses, and the result can be one ply too long.
+        std::optional<i32> probeDtz(const Position& position) const;
+    private:
+        std::unique_ptr<Implementation::SyzygyTables> _tables;
+    };
+
+    std::string_view mapSyzygyWdlTypeToString(SyzygyWdlType type);
+}
@@ -0,0 +1,49 @@
+#include "TimeManager.h"
+
+#include <algorithm>
+
+namespace ChessCore {
+
+    // Without moves to go the game is assumed to last this many more moves, and no more than this many are planned for.
+    static constexpr u32 DefaultMovesToGo = 30;
+    static constexpr u32 MaximumMovesToGo = 50;
+
+    static constexpr i64 MaximumTimeScale = 5;
+    static constexpr f64 MaximumRemainingTimeShare = 0.8;
+
+    // Score drops are measured in centipawns and count fully up to this size.
+    static constexpr f64 MaximumScoreDrop = 200.0;
+
+    TimeManager::TimeManager(const TimeControl& timeControl) {
+        using namespace std::chrono;
+
+        const auto movesToGo = timeControl.movesToGo != 0 ? std::min(timeControl.movesToGo, MaximumMovesToGo) : DefaultMovesToGo;
+        const auto remainingTime = timeControl.remainingTime;
+
+        // The increments of the coming moves are spent as they arrive, the overhead is held back for each of them.
+        const auto plannedTime = remainingTime + timeControl.increment * (movesToGo - 1) - timeControl.moveOverhead * movesToGo;
+        const auto safeTime = duration_cast<milliseconds>(remainingTime * MaximumRemainingTimeShare) - timeControl.moveOverhead;
+
+        _maximumTime = std::max(std::min(plannedTime / movesToGo * MaximumTimeScale, safeTime), milliseconds{ 1 });
+        _optimumTime = std::clamp(plannedTime / movesToGo, milliseconds{ 1 }, _maximumTime);
+    }
+
+    bool TimeManager::shouldStartIteration(const ChessMove& bestMove, i32 score, f64 bestMoveNodeShare, std::chrono::nanoseconds elapsedTime) {
+        const auto hasPreviousIteration = _previousBestMove.has_value();
+
+        _stableIterationCount = hasPreviousIteration && *_previousBestMove == bestMove ? _stableIterationCount + 1 : 0;
+
+        const auto scoreDrop = hasPreviousIteration ? std::clamp(static_cast<f64>(_previousScore - score), 0.0, MaximumScoreDrop) : 0.0;
+
+        _previousBestMove = bestMove;
+        _previousScore = score;
+
+        const auto stabilityScale = std::clamp(1.3 - 0.1 * _stableIterationCount, 0.7, 1.3);
+        const auto scoreDropScale = 1.0 + 0.5 * scoreDrop / MaximumScoreDrop;
+        const auto nodeShareScale = std::clamp(2.0 * (1.0 - bestMoveNodeShare) + 0.5, 0.5, 1.5);
+
+        const auto softTime = std::chrono::duration<f64, std::milli>(_optimumTime) * stabilityScale * scoreDropScale * nodeShareScale;
+
+        return elapsedTime < std::min(softTime, std::chrono::duration<f64, std::milli>(_maximumTime));
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Move.h"
+
+#include <chrono>
+#include <optional>
+
+namespace ChessCore {
+
+    // Clock of the side to move as a UCI "go" command gives it. A zero remaining time means no clock, zero moves to
+    // go means the rest of the game has to be played in the remaining time.
+    struct TimeControl {
+        std::chrono::milliseconds remainingTime{};
+        std::chrono::milliseconds increment{};
+        u32 movesToGo{};
+        // Kept back per move for communication and the time between the search ending and the move being played.
+        std::chrono::milliseconds moveOverhead{ 20 };
+    };
+
+    // Splits the clock into an optimum time, the budget of a typical move, and a maximum time, which the search never
+    // exceeds. Between iterations the optimum is scaled: a best move that keeps changing, a falling score or a best
+    // move that needed few of the nodes all ask for more time, a stable and clear best move for less.
+    class TimeManager {
+    public:
+        explicit TimeManager(const TimeControl& timeControl);
+
+        std::chrono::milliseconds getOptimumTime() const {
+            return _optimumTime;
+        }
+
+        std::chrono::milliseconds getMaximumTime() const {
+            return _maximumTime;
+        }
+
+        // Called after every completed iteration; returns whether the next one should be started. The node share is
+        // the part of the iteration's nodes that was spent on the best move.
+        bool shouldStartIteration(const ChessMove& bestMove, i32 score, f64 bestMoveNodeShare, std::chrono::nanoseconds elapsedTime);
+    private:
+        std::chrono::milliseconds _optimumTime{};
+        std::chrono::milliseconds _maximumTime{};
+
+        std::optional<ChessMove> _previousBestMove{};
+        i32 _previousScore{};
+        u32 _stableIterationCount{};
+    };
+}
@@ -0,0 +1,134 @@
+#include "TrainingData.h"
+
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <stdexcept>
+
+namespace ChessCore {
+
+    // Bit 0 is set when black is to move, bits 1 to 4 hold the castling rights.
+    static constexpr u8 BlackToMoveFlag = 1;
+    static constexpr u8 CastlingRightsShift = 1;
+
+    static constexpr u8 BlackPieceCodeFlag = 8;
+
+    static u8 mapChessPieceToCode(ChessPiece piece) {
+        const auto code = static_cast<u8>(piece.type);
+        return piece.color == ChessPieceColorType::Black ? code | BlackPieceCodeFlag : code;
+    }
+
+    static ChessPiece mapCodeToChessPiece(u8 code) {
+        const auto type = static_cast<ChessPieceType>(code & ~BlackPieceCodeFlag);
+
+        if (type == ChessPieceType::None || static_cast<usize>(type) >= ChessPieceTypeCount) {
+            throw std::runtime_error(std::format("Invalid training record piece code {}", code));
+        }
+
+        return { type, (code & BlackPieceCodeFlag) != 0 ? ChessPieceColorType::Black : ChessPieceColorType::White };
+    }
+
+    TrainingRecord packTrainingRecord(const Position& position, i16 score, i8 result, u16 ply) {
+        auto record = TrainingRecord{};
+        auto pieceIndex = 0ull;
+
+        for (auto squareIndex = 0ull; squareIndex < BoardSquareCount; squareIndex++) {
+            const auto piece = position.getPiece(squareIndex);
+
+            if (piece.type == ChessPieceType::None) {
+                continue;
+            }
+
+            if (pieceIndex == record.pieces.size() * 2) {
+                throw std::runtime_error("Training records hold at most 32 pieces");
+            }
+
+            record.occupancy |= 1ull << squareIndex;
+            record.pieces[pieceIndex / 2] |= mapChessPieceToCode(piece) << (pieceIndex % 2 * 4);
+            pieceIndex++;
+        }
+
+        record.score = score;
+        record.ply = ply;
+        record.result = result;
+        record.flags = static_cast<u8>(position.getCastlingRights() << CastlingRightsShift);
+        record.enPassantSquareIndex = position.getEnPassantSquareIndex();
+        record.halfmoveClock = static_cast<u8>(std::min<u32>(position.getHalfmoveClock(), 255));
+
+        if (position.getSideToMove() == ChessPieceColorType::Black) {
+            record.flags |= BlackToMoveFlag;
+        }
+
+        return record;
+    }
+
+    Position unpackTrainingRecord(const TrainingRecord& record) {
+        auto position = Position{};
+        auto occupancy = record.occupancy;
+        auto pieceIndex = 0ull;
+
+        while (occupancy != 0) {
+            const auto squareIndex = static_cast<usize>(std::countr_zero(occupancy));
+            const auto code = static_cast<u8>(record.pieces[pieceIndex / 2] >> (pieceIndex % 2 * 4) & 0xF);
+
+            position.setPiece(squareIndex, mapCodeToChessPiece(code));
+
+            occupancy &= occupancy - 1;
+            pieceIndex++;
+        }
+
+        position.setSideToMove((record.flags & BlackToMoveFlag) != 0 ? ChessPieceColorType::Black : ChessPieceColorType::White);
+        position.setCastlingRights(static_cast<u8>(record.flags >> CastlingRightsShift & CastlingRights::All));
+        position.setEnPassantSquareIndex(record.enPassantSquareIndex);
+        position.setHalfmoveClock(record.halfmoveClock);
+        position.setFullmoveNumber(record.ply / 2 + 1);
+
+        return position;
+    }
+
+    TrainingDataWriter::TrainingDataWriter(const std::filesystem::path& path)
+        : _file{ path, std::ios::binary | std::ios::trunc } {
+        if (!_file) {
+            throw std::runtime_error(std::format("Training data file {} could not be created", path.string()));
+        }
+    }
+
+    void TrainingDataWriter::write(std::span<const TrainingRecord> records) {
+        const auto lock = std::scoped_lock{ _mutex };
+
+        _file.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(records.size_bytes()));
+
+        if (!_file) {
+            throw std::runtime_error("Training data could not be written");
+        }
+
+        _recordCount += records.size();
+    }
+
+    usize TrainingDataWriter::getRecordCount() const {
+        const auto lock = std::scoped_lock{ _mutex };
+        return _recordCount;
+    }
+
+    TrainingDataReader::TrainingDataReader(const std::filesystem::path& path)
+        : _file{ path, MappedFileAccessType::Random } {
+        if (_file.getSize() % TrainingRecordSize != 0) {
+            throw std::runtime_error(std::format("Training data file {} is not a whole number of records", path.string()));
+        }
+
+        if (_file.getSize() == 0) {
+            throw std::runtime_error(std::format("Training data file {} contains no records", path.string()));
+        }
+    }
+
+    TrainingRecord TrainingDataReader::getRecord(usize index) const {
+        auto record = TrainingRecord{};
+        std::memcpy(&record, _file.getBytes().data() + index * TrainingRecordSize, TrainingRecordSize);
+
+        return record;
+    }
+
+    TrainingRecord TrainingDataReader::sampleRecord(u64 randomValue) const {
+        return getRecord(randomValue % getRecordCount());
+    }
+}
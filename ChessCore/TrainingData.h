@@ -0,0 +1,69 @@
+#pragma once
+
+#include "MappedFile.h"
+#include "Position.h"
+
+#include <array>
+#include <bit>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <span>
+#include <type_traits>
+
+namespace ChessCore {
+
+    // Pieces are stored as 4-bit codes in square order for every set occupancy bit, so 32 pieces fit in 16 bytes.
+    struct TrainingRecord {
+        u64 occupancy{};
+        std::array<u8, 16> pieces{};
+        i16 score{};
+        u16 ply{};
+        i8 result{};
+        u8 flags{};
+        u8 enPassantSquareIndex = NoSquareIndex;
+        u8 halfmoveClock{};
+    };
+
+    // Records are written in native little-endian layout, so files can be mapped and read in place.
+    inline constexpr usize TrainingRecordSize = 32;
+
+    static_assert(sizeof(TrainingRecord) == TrainingRecordSize);
+    static_assert(std::is_trivially_copyable_v<TrainingRecord>);
+    static_assert(std::endian::native == std::endian::little);
+
+    // The score is from the side to move's view, the result is 1, 0 or -1 from white's view.
+    TrainingRecord packTrainingRecord(const Position& position, i16 score, i8 result, u16 ply);
+
+    Position unpackTrainingRecord(const TrainingRecord& record);
+
+    // Appends records to a file, several threads may write their buffers concurrently.
+    class TrainingDataWriter {
+    public:
+        explicit TrainingDataWriter(const std::filesystem::path& path);
+
+        void write(std::span<const TrainingRecord> records);
+
+        usize getRecordCount() const;
+    private:
+        mutable std::mutex _mutex{};
+        std::ofstream _file{};
+        usize _recordCount{};
+    };
+
+    class TrainingDataReader {
+    public:
+        explicit TrainingDataReader(const std::filesystem::path& path);
+
+        usize getRecordCount() const {
+            return _file.getSize() / TrainingRecordSize;
+        }
+
+        TrainingRecord getRecord(usize index) const;
+
+        // randomValue selects the record, so callers control the random number generator.
+        TrainingRecord sampleRecord(u64 randomValue) const;
+    private:
+        MappedFile _file;
+    };
+}
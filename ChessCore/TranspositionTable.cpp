@@ -0,0 +1,77 @@
+#include "TranspositionTable.h"
+
+#include <bit>
+
+namespace ChessCore {
+
+    static u64 packTranspositionEntry(const TranspositionEntry& entry) {
+        return static_cast<u64>(entry.move)
+            | static_cast<u64>(static_cast<u16>(entry.score)) << 16
+            | static_cast<u64>(entry.depth) << 32
+            | static_cast<u64>(entry.bound) << 40;
+    }
+
+    static TranspositionEntry unpackTranspositionEntry(u64 data) {
+        return {
+            static_cast<u16>(data),
+            static_cast<i16>(static_cast<u16>(data >> 16)),
+            static_cast<u8>(data >> 32),
+            static_cast<TranspositionBoundType>(static_cast<u8>(data >> 40)),
+        };
+    }
+
+    TranspositionTable::TranspositionTable(usize sizeInMegabytes) {
+        const auto requestedSlotCount = std::max<usize>(sizeInMegabytes * 1024 * 1024 / sizeof(Slot), 1);
+
+        _slotCount = std::bit_floor(requestedSlotCount);
+        _slots = std::make_unique<Slot[]>(_slotCount);
+    }
+
+    void TranspositionTable::clear() {
+        for (auto slotIndex = 0ull; slotIndex < _slotCount; slotIndex++) {
+            _slots[slotIndex].check.store(0, std::memory_order_relaxed);
+            _slots[slotIndex].data.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    bool TranspositionTable::probe(u64 key, TranspositionEntry& entry) const {
+        const auto& slot = _slots[key & (_slotCount - 1)];
+
+        const auto data = slot.data.load(std::memory_order_relaxed);
+        const auto check = slot.check.load(std::memory_order_relaxed);
+
+        if ((check ^ data) != key || data == 0) {
+            return false;
+        }
+
+        entry = unpackTranspositionEntry(data);
+        return true;
+    }
+
+    void TranspositionTable::store(u64 key, const TranspositionEntry& entry) {
+        auto& slot = _slots[key & (_slotCount - 1)];
+
+        const auto previousData = slot.data.load(std::memory_order_relaxed);
+        const auto previousCheck = slot.check.load(std::memory_order_relaxed);
+
+        // Keep a deeper result of the same position unless the new one is exact.
+        if ((previousCheck ^ previousData) == key && entry.bound != TranspositionBoundType::Exact) {
+            const auto previousEntry = unpackTranspositionEntry(previousData);
+
+            if (previousEntry.depth > entry.depth + 2) {
+                return;
+            }
+        }
+
+        auto newEntry = entry;
+
+        if (newEntry.move == 0 && (previousCheck ^ previousData) == key) {
+            newEntry.move = unpackTranspositionEntry(previousData).move;
+        }
+
+        const auto data = packTranspositionEntry(newEntry);
+
+        slot.check.store(key ^ data, std::memory_order_relaxed);
+        slot.data.store(data, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Move.h"
+
+#include <atomic>
+#include <memory>
+
+namespace ChessCore {
+
+    enum class TranspositionBoundType : u8 {
+        None,
+        Exact,
+        Lower,
+        Upper,
+    };
+
+    struct TranspositionEntry {
+        u16 move{};
+        i16 score{};
+        u8 depth{};
+        TranspositionBoundType bound{};
+    };
+
+    // Moves are stored as starting square, target square and promotion type; flags are recovered by
+    // matching against generated moves.
+    constexpr u16 encodeTranspositionMove(const ChessMove& move) {
+        return static_cast<u16>(move.startingSquareIndex | move.targetSquareIndex << 6 | static_cast<u16>(move.promotionType) << 12);
+    }
+
+    constexpr bool isTranspositionMoveEqual(u16 encodedMove, const ChessMove& move) {
+        return encodedMove != 0 && encodedMove == encodeTranspositionMove(move);
+    }
+
+    // Fixed-size hash table of search results. Each slot stores the key xor-ed with its data, so a slot torn by
+    // a concurrent write fails verification instead of returning mixed data, and the table can be shared by threads.
+    class TranspositionTable {
+    public:
+        explicit TranspositionTable(usize sizeInMegabytes);
+
+        void clear();
+
+        bool probe(u64 key, TranspositionEntry& entry) const;
+        void store(u64 key, const TranspositionEntry& entry);
+
+        usize getSlotCount() const {
+            return _slotCount;
+        }
+    private:
+        struct Slot {
+            std::atomic<u64> check{};
+            std::atomic<u64> data{};
+        };
+
+        std::unique_ptr<Slot[]> _slots{};
+        usize _slotCount{};
+    };
+}
@@ -0,0 +1,353 @@
+#include "Tuner.h"
+
+#include "Search.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <thread>
+
+namespace ChessCore {
+
+    // Each phase has a value and 64 piece-square weights per piece type.
+    static constexpr usize TunerPieceWeightCount = BoardSquareCount + 1;
+    static constexpr usize TunerPhaseWeightCount = ChessPieceTypeCount * TunerPieceWeightCount;
+    static constexpr usize TunerWeightCount = GamePhaseTypeCount * TunerPhaseWeightCount;
+
+    // Piece codes hold the type and mirrored square as type * 64 + square, with the top bit set for black pieces.
+    static constexpr u16 BlackPieceCodeFlag = 0x8000;
+
+    static constexpr f64 Log10 = 2.302585092994046;
+
+    static usize getWeightIndex(usize phase, usize type, usize squareIndex) {
+        return phase * TunerPhaseWeightCount + type * TunerPieceWeightCount + squareIndex;
+    }
+
+    static usize getValueWeightIndex(usize phase, usize type) {
+        return getWeightIndex(phase, type, BoardSquareCount);
+    }
+
+    static f64 computeSigmoid(f64 score, f64 scalingConstant) {
+        return 1.0 / (1.0 + std::pow(10.0, -scalingConstant * score / 400.0));
+    }
+
+    // Splits the range evenly over the threads and calls function(threadIndex, begin, end) on each of them, even
+    // when its part of the range is empty.
+    template <typename Function>
+    static void runInParallel(usize threadCount, usize itemCount, const Function& function) {
+        threadCount = std::max<usize>(threadCount, 1);
+
+        auto threads = std::vector<std::jthread>{};
+        threads.reserve(threadCount);
+
+        for (auto threadIndex = 0ull; threadIndex < threadCount; threadIndex++) {
+            const auto begin = itemCount * threadIndex / threadCount;
+            const auto end = itemCount * (threadIndex + 1) / threadCount;
+
+            threads.emplace_back([&function, threadIndex, begin, end] { function(threadIndex, begin, end); });
+        }
+    }
+
+    EvaluationTuner::EvaluationTuner(const EvaluationParameters& parameters) : _weights(TunerWeightCount) {
+        for (auto phase = 0ull; phase < GamePhaseTypeCount; phase++) {
+            for (auto type = 0ull; type < ChessPieceTypeCount; type++) {
+                _weights[getValueWeightIndex(phase, type)] = parameters.pieceValues[phase][type];
+
+                for (auto squareIndex = 0ull; squareIndex < BoardSquareCount; squareIndex++) {
+                    _weights[getWeightIndex(phase, type, squareIndex)] = parameters.pieceSquareValues[phase][type][squareIndex];
+                }
+            }
+        }
+    }
+
+    void EvaluationTuner::loadPositions(const TrainingDataReader& reader, usize positionCount, usize threadCount) {
+        positionCount = positionCount == 0 ? reader.getRecordCount() : std::min(positionCount, reader.getRecordCount());
+        threadCount = std::clamp<usize>(threadCount, 1, std::max<usize>(positionCount, 1));
+
+        auto threadPieceCodes = std::vector<std::vector<u16>>(threadCount);
+        auto threadPieceCounts = std::vector<std::vector<u8>>(threadCount);
+
+        runInParallel(threadCount, positionCount, [&](usize threadIndex, usize begin, usize end) {
+            // The quiescence search does not use the table, so a minimal one is enough.
+            auto transpositionTable = TranspositionTable{ 1 };
+            auto searcher = Searcher{ transpositionTable };
+
+            auto& pieceCodes = threadPieceCodes[threadIndex];
+            auto& pieceCounts = threadPieceCounts[threadIndex];
+
+            pieceCounts.reserve(end - begin);
+
+            for (auto recordIndex = begin; recordIndex < end; recordIndex++) {
+                auto position = unpackTrainingRecord(reader.getRecord(recordIndex));
+
+                for (const auto& move : searcher.searchQuiescence(position).principalVariation) {
+                    position.makeMove(move);
+                }
+
+                auto pieceCount = u8{};
+
+                for (auto squareIndex = 0ull; squareIndex < BoardSquareCount; squareIndex++) {
+                    const auto piece = position.getPiece(squareIndex);
+
+                    if (piece.type == ChessPieceType::None) {
+                        continue;
+                    }
+
+                    const auto isWhite = piece.color == ChessPieceColorType::White;
+                    const auto tableIndex = isWhite ? squareIndex : squareIndex ^ 56;
+                    const auto code = static_cast<u16>(static_cast<usize>(piece.type) * BoardSquareCount + tableIndex);
+
+                    pieceCodes.push_back(isWhite ? code : code | BlackPieceCodeFlag);
+                    pieceCount++;
+                }
+
+                pieceCounts.push_back(pieceCount);
+            }
+        });
+
+        _pieceCodes.clear();
+        _pieceOffsets.assign(1, 0);
+        _results.clear();
+
+        _pieceOffsets.reserve(positionCount + 1);
+        _results.reserve(positionCount);
+
+        for (auto threadIndex = 0ull; threadIndex < threadCount; threadIndex++) {
+            _pieceCodes.insert(_pieceCodes.end(), threadPieceCodes[threadIndex].begin(), threadPieceCodes[threadIndex].end());
+
+            for (const auto pieceCount : threadPieceCounts[threadIndex]) {
+                _pieceOffsets.push_back(_pieceOffsets.back() + pieceCount);
+            }
+
+            threadPieceCodes[threadIndex] = {};
+        }
+
+        for (auto recordIndex = 0ull; recordIndex < positionCount; recordIndex++) {
+            _results.push_back(static_cast<f32>(reader.getRecord(recordIndex).result + 1) / 2.0f);
+        }
+    }
+
+    f64 EvaluationTuner::fitScalingConstant(usize threadCount) {
+        constexpr auto InverseGoldenRatio = 0.6180339887498949;
+
+        auto lower = 0.0;
+        auto upper = 4.0;
+
+        auto first = upper - InverseGoldenRatio * (upper - lower);
+        auto second = lower + InverseGoldenRatio * (upper - lower);
+        auto firstLoss = _computeLoss(first, threadCount);
+        auto secondLoss = _computeLoss(second, threadCount);
+
+        while (upper - lower > 1e-4) {
+            if (firstLoss < secondLoss) {
+                upper = second;
+                second = first;
+                secondLoss = firstLoss;
+                first = upper - InverseGoldenRatio * (upper - lower);
+                firstLoss = _computeLoss(first, threadCount);
+            } else {
+                lower = first;
+                first = second;
+                firstLoss = secondLoss;
+                second = lower + InverseGoldenRatio * (upper - lower);
+                secondLoss = _computeLoss(second, threadCount);
+            }
+        }
+
+        _scalingConstant = (lower + upper) / 2.0;
+
+        return _scalingConstant;
+    }
+
+    f64 EvaluationTuner::computeLoss(usize threadCount) const {
+        return _computeLoss(_scalingConstant, threadCount);
+    }
+
+    void EvaluationTuner::tune(const TunerSettings& settings, const TunerEpochCallback& callback) {
+        constexpr auto FirstMomentDecay = 0.9;
+        constexpr auto SecondMomentDecay = 0.999;
+        constexpr auto Epsilon = 1e-8;
+
+        const auto positionCount = getPositionCount();
+        const auto batchSize = std::max<usize>(settings.batchSize, 1);
+        const auto threadCount = std::clamp<usize>(settings.threadCount, 1, batchSize);
+
+        auto random = std::mt19937_64{ settings.seed };
+        auto order = std::vector<u32>(positionCount);
+
+        auto firstMoments = std::vector<f64>(TunerWeightCount);
+        auto secondMoments = std::vector<f64>(TunerWeightCount);
+        auto stepCount = 0ull;
+
+        auto threadGradients = std::vector<std::vector<f64>>(threadCount, std::vector<f64>(TunerWeightCount));
+        auto threadLosses = std::vector<f64>(threadCount);
+
+        for (auto epochIndex = 0ull; epochIndex < settings.epochCount; epochIndex++) {
+            std::iota(order.begin(), order.end(), 0u);
+            std::shuffle(order.begin(), order.end(), random);
+
+            auto epochLoss = 0.0;
+
+            for (auto batchBegin = 0ull; batchBegin < positionCount; batchBegin += batchSize) {
+                const auto batchEnd = std::min<usize>(batchBegin + batchSize, positionCount);
+
+                runInParallel(threadCount, batchEnd - batchBegin, [&](usize threadIndex, usize begin, usize end) {
+                    auto& gradient = threadGradients[threadIndex];
+                    auto loss = 0.0;
+
+                    std::ranges::fill(gradient, 0.0);
+
+                    for (auto orderIndex = batchBegin + begin; orderIndex < batchBegin + end; orderIndex++) {
+                        loss += _accumulateGradient(order[orderIndex], gradient);
+                    }
+
+                    threadLosses[threadIndex] = loss;
+                });
+
+                const auto batchPositionCount = static_cast<f64>(batchEnd - batchBegin);
+                stepCount++;
+
+                for (auto weightIndex = 0ull; weightIndex < TunerWeightCount; weightIndex++) {
+                    auto gradient = 0.0;
+
+                    for (const auto& threadGradient : threadGradients) {
+                        gradient += threadGradient[weightIndex];
+                    }
+
+                    gradient /= batchPositionCount;
+
+                    if (settings.optimizer == TunerOptimizerType::GradientDescent) {
+                        _weights[weightIndex] -= settings.learningRate * gradient;
+                        continue;
+                    }
+
+                    auto& firstMoment = firstMoments[weightIndex];
+                    auto& secondMoment = secondMoments[weightIndex];
+
+                    firstMoment = FirstMomentDecay * firstMoment + (1.0 - FirstMomentDecay) * gradient;
+                    secondMoment = SecondMomentDecay * secondMoment + (1.0 - SecondMomentDecay) * gradient * gradient;
+
+                    const auto correctedFirstMoment = firstMoment / (1.0 - std::pow(FirstMomentDecay, static_cast<f64>(stepCount)));
+                    const auto correctedSecondMoment = secondMoment / (1.0 - std::pow(SecondMomentDecay, static_cast<f64>(stepCount)));
+
+                    _weights[weightIndex] -= settings.learningRate * correctedFirstMoment / (std::sqrt(correctedSecondMoment) + Epsilon);
+                }
+
+                epochLoss += std::accumulate(threadLosses.begin(), threadLosses.end(), 0.0);
+            }
+
+            if (callback) {
+                callback(epochIndex, positionCount != 0 ? epochLoss / static_cast<f64>(positionCount) : 0.0);
+            }
+        }
+    }
+
+    EvaluationParameters EvaluationTuner::getParameters() const {
+        auto parameters = EvaluationParameters{};
+
+        for (auto phase = 0ull; phase < GamePhaseTypeCount; phase++) {
+            for (auto type = 0ull; type < ChessPieceTypeCount; type++) {
+                parameters.pieceValues[phase][type] = static_cast<i32>(std::lround(_weights[getValueWeightIndex(phase, type)]));
+
+                for (auto squareIndex = 0ull; squareIndex < BoardSquareCount; squareIndex++) {
+                    parameters.pieceSquareValues[phase][type][squareIndex] = static_cast<i32>(std::lround(_weights[getWeightIndex(phase, type, squareIndex)]));
+                }
+            }
+        }
+
+        return parameters;
+    }
+
+    f64 EvaluationTuner::_computeLoss(f64 scalingConstant, usize threadCount) const {
+        const auto positionCount = getPositionCount();
+
+        threadCount = std::clamp<usize>(threadCount, 1, std::max<usize>(positionCount, 1));
+
+        auto threadLosses = std::vector<f64>(threadCount);
+
+        runInParallel(threadCount, positionCount, [&](usize threadIndex, usize begin, usize end) {
+            auto loss = 0.0;
+
+            for (auto positionIndex = begin; positionIndex < end; positionIndex++) {
+                const auto error = computeSigmoid(_evaluatePosition(positionIndex), scalingConstant) - _results[positionIndex];
+                loss += error * error;
+            }
+
+            threadLosses[threadIndex] = loss;
+        });
+
+        return positionCount != 0 ? std::accumulate(threadLosses.begin(), threadLosses.end(), 0.0) / static_cast<f64>(positionCount) : 0.0;
+    }
+
+    // Same tapered sum as evaluatePosition, from white's point of view and without rounding.
+    f64 EvaluationTuner::_evaluatePosition(usize positionIndex) const {
+        constexpr auto middlegame = static_cast<usize>(GamePhaseType::Middlegame);
+        constexpr auto endgame = static_cast<usize>(GamePhaseType::Endgame);
+
+        auto middlegameScore = 0.0;
+        auto endgameScore = 0.0;
+        auto phase = 0;
+
+        for (auto codeIndex = _pieceOffsets[positionIndex]; codeIndex < _pieceOffsets[positionIndex + 1]; codeIndex++) {
+            const auto code = _pieceCodes[codeIndex];
+            const auto type = (code & ~BlackPieceCodeFlag) / BoardSquareCount;
+            const auto squareIndex = (code & ~BlackPieceCodeFlag) % BoardSquareCount;
+            const auto sign = (code & BlackPieceCodeFlag) != 0 ? -1.0 : 1.0;
+
+            middlegameScore += sign * (_weights[getValueWeightIndex(middlegame, type)] + _weights[getWeightIndex(middlegame, type, squareIndex)]);
+            endgameScore += sign * (_weights[getValueWeightIndex(endgame, type)] + _weights[getWeightIndex(endgame, type, squareIndex)]);
+            phase += GamePhaseWeights[type];
+        }
+
+        const auto phaseFraction = static_cast<f64>(std::min(phase, MaximumGamePhase)) / MaximumGamePhase;
+
+        return middlegameScore * phaseFraction + endgameScore * (1.0 - phaseFraction);
+    }
+
+    // Adds the derivative of the squared error to the gradient and returns the squared error.
+    f64 EvaluationTuner::_accumulateGradient(usize positionIndex, std::vector<f64>& gradient) const {
+        constexpr auto middlegame = static_cast<usize>(GamePhaseType::Middlegame);
+        constexpr auto endgame = static_cast<usize>(GamePhaseType::Endgame);
+
+        const auto begin = _pieceOffsets[positionIndex];
+        const auto end = _pieceOffsets[positionIndex + 1];
+
+        auto phase = 0;
+
+        for (auto codeIndex = begin; codeIndex < end; codeIndex++) {
+            phase += GamePhaseWeights[(_pieceCodes[codeIndex] & ~BlackPieceCodeFlag) / BoardSquareCount];
+        }
+
+        const auto phaseFraction = static_cast<f64>(std::min(phase, MaximumGamePhase)) / MaximumGamePhase;
+
+        const auto sigmoid = computeSigmoid(_evaluatePosition(positionIndex), _scalingConstant);
+        const auto error = sigmoid - _results[positionIndex];
+        const auto scoreGradient = 2.0 * error * sigmoid * (1.0 - sigmoid) * _scalingConstant * Log10 / 400.0;
+
+        for (auto codeIndex = begin; codeIndex < end; codeIndex++) {
+            const auto code = _pieceCodes[codeIndex];
+            const auto type = (code & ~BlackPieceCodeFlag) / BoardSquareCount;
+            const auto squareIndex = (code & ~BlackPieceCodeFlag) % BoardSquareCount;
+            const auto signedGradient = (code & BlackPieceCodeFlag) != 0 ? -scoreGradient : scoreGradient;
+
+            gradient[getValueWeightIndex(middlegame, type)] += signedGradient * phaseFraction;
+            gradient[getWeightIndex(middlegame, type, squareIndex)] += signedGradient * phaseFraction;
+            gradient[getValueWeightIndex(endgame, type)] += signedGradient * (1.0 - phaseFraction);
+            gradient[getWeightIndex(endgame, type, squareIndex)] += signedGradient * (1.0 - phaseFraction);
+        }
+
+        return error * error;
+    }
+
+    std::string_view mapTunerOptimizerTypeToString(TunerOptimizerType type) {
+        switch (type) {
+        case TunerOptimizerType::Adam:
+            return "Adam";
+        case TunerOptimizerType::GradientDescent:
+            return "gradient descent";
+        default:
+            return "unknown";
+        }
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Evaluation.h"
+#include "TrainingData.h"
+
+#include <functional>
+#include <string_view>
+#include <vector>
+
+namespace ChessCore {
+
+    enum class TunerOptimizerType : i16 {
+        Adam,
+        GradientDescent,
+    };
+
+    struct TunerSettings {
+        TunerOptimizerType optimizer = TunerOptimizerType::Adam;
+        usize threadCount = 1;
+        usize batchSize = 16384;
+        usize epochCount = 10;
+        f64 learningRate = 1.0;
+        u64 seed = 1;
+    };
+
+    // Called after every epoch with the mean loss over the batches of that epoch.
+    using TunerEpochCallback = std::function<void(usize epochIndex, f64 loss)>;
+
+    // Texel tuning: fits the material and piece-square values so that a sigmoid of the evaluation predicts the game
+    // results, minimising the mean squared error over the position set.
+    class EvaluationTuner {
+    public:
+        explicit EvaluationTuner(const EvaluationParameters& parameters);
+
+        // Each record is resolved with a quiescence search and the pieces of the quiet position are kept, two bytes
+        // per piece. A position count of zero loads every record.
+        void loadPositions(const TrainingDataReader& reader, usize positionCount, usize threadCount);
+
+        usize getPositionCount() const {
+            return _results.size();
+        }
+
+        // Golden section search for the constant that scales centipawns in the sigmoid.
+        f64 fitScalingConstant(usize threadCount);
+
+        void setScalingConstant(f64 scalingConstant) {
+            _scalingConstant = scalingConstant;
+        }
+
+        f64 getScalingConstant() const {
+            return _scalingConstant;
+        }
+
+        f64 computeLoss(usize threadCount) const;
+
+        void tune(const TunerSettings& settings, const TunerEpochCallback& callback = {});
+
+        // Weights are rounded to whole centipawns.
+        EvaluationParameters getParameters() const;
+    private:
+        f64 _computeLoss(f64 scalingConstant, usize threadCount) const;
+        f64 _evaluatePosition(usize positionIndex) const;
+        f64 _accumulateGradient(usize positionIndex, std::vector<f64>& gradient) const;
+
+        std::vector<f64> _weights{};
+        f64 _scalingConstant = 1.0;
+
+        std::vector<u16> _pieceCodes{};
+        std::vector<u32> _pieceOffsets{};
+        std::vector<f32> _results{};
+    };
+
+    std::string_view mapTunerOptimizerTypeToString(TunerOptimizerType type);
+}
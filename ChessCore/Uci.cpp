@@ -0,0 +1,67 @@
+#include "Uci.h"
+#include "MoveGen.h"
+
+namespace ChessCore {
+
+    static constexpr std::string_view UciPromotionCharacters = " qrbn";
+
+    static bool parseUciSquare(std::string_view text, u8& squareIndex) {
+        if (text[0] < 'a' || text[0] > 'h' || text[1] < '1' || text[1] > '8') {
+            return false;
+        }
+
+        squareIndex = static_cast<u8>(mapFileAndRankToSquareIndex(static_cast<usize>(text[0] - 'a'), static_cast<usize>(text[1] - '1')));
+        return true;
+    }
+
+    static void writeUciSquare(usize squareIndex, char* characters) {
+        characters[0] = static_cast<char>('a' + getSquareFile(squareIndex));
+        characters[1] = static_cast<char>('1' + getSquareRank(squareIndex));
+    }
+
+    bool parseUciMove(const Position& position, std::string_view text, ChessMove& move) {
+        if (text.size() != 4 && text.size() != 5) {
+            return false;
+        }
+
+        auto startingSquareIndex = u8{};
+        auto targetSquareIndex = u8{};
+
+        if (!parseUciSquare(text.substr(0, 2), startingSquareIndex) || !parseUciSquare(text.substr(2, 2), targetSquareIndex)) {
+            return false;
+        }
+
+        auto promotionType = ChessPieceType::None;
+
+        if (text.size() == 5) {
+            const auto promotionIndex = UciPromotionCharacters.find(text[4], 1);
+
+            if (promotionIndex == std::string_view::npos) {
+                return false;
+            }
+
+            promotionType = static_cast<ChessPieceType>(promotionIndex);
+        }
+
+        for (const auto& candidate : computeLegalMoves(position)) {
+            if (candidate.startingSquareIndex == startingSquareIndex && candidate.targetSquareIndex == targetSquareIndex && candidate.promotionType == promotionType) {
+                move = candidate;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    std::string_view writeUciMove(const ChessMove& move, UciMoveBuffer& buffer) {
+        writeUciSquare(move.startingSquareIndex, buffer.data());
+        writeUciSquare(move.targetSquareIndex, buffer.data() + 2);
+
+        if (move.promotionType == ChessPieceType::None) {
+            return { buffer.data(), 4 };
+        }
+
+        buffer[4] = UciPromotionCharacters[static_cast<usize>(move.promotionType)];
+        return { buffer.data(), 5 };
+    }
+}
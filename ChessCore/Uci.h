@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Position.h"
+
+#include <array>
+#include <string_view>
+
+namespace ChessCore {
+
+    // Starting square, target square and an optional promotion letter, for example "e7e8q".
+    inline constexpr usize MaximumUciMoveLength = 5;
+
+    using UciMoveBuffer = std::array<char, MaximumUciMoveLength>;
+
+    // Resolves coordinate notation against the legal moves of the position, castling is written as the king move.
+    // Returns false when the move is malformed or illegal.
+    bool parseUciMove(const Position& position, std::string_view text, ChessMove& move);
+
+    std::string_view writeUciMove(const ChessMove& move, UciMoveBuffer& buffer);
+}
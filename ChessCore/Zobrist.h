@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Board.h"
+
+#include <array>
+
+namespace ChessCore {
+
+    namespace Implementation {
+
+        struct ZobristKeys {
+            std::array<std::array<u64, BoardSquareCount>, ChessPieceTypeCount * ChessPieceColorTypeCount> pieceKeys{};
+            std::array<u64, 16> castlingKeys{};
+            std::array<u64, BoardSquareSize> enPassantKeys{};
+            u64 sideToMoveKey{};
+        };
+
+        constexpr u64 computeSplitMix64(u64& state) {
+            state += 0x9E3779B97F4A7C15ull;
+
+            auto value = state;
+            value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+            value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+
+            return value ^ (value >> 31);
+        }
+
+        inline constexpr auto ZobristKeysTable = [] {
+            auto keys = ZobristKeys{};
+            auto state = u64{ 0x2545F4914F6CDD1Dull };
+
+            // Empty squares keep zero keys so they never change a position key.
+            for (auto type = 1ull; type < ChessPieceTypeCount; type++) {
+                for (auto color = 1ull; color < ChessPieceColorTypeCount; color++) {
+                    for (auto& key : keys.pieceKeys[type * ChessPieceColorTypeCount + color]) {
+                        key = computeSplitMix64(state);
+                    }
+                }
+            }
+
+            for (auto rights = 1ull; rights < keys.castlingKeys.size(); rights++) {
+                keys.castlingKeys[rights] = computeSplitMix64(state);
+            }
+
+            for (auto& key : keys.enPassantKeys) {
+                key = computeSplitMix64(state);
+            }
+
+            keys.sideToMoveKey = computeSplitMix64(state);
+
+            return keys;
+        }();
+    }
+
+    constexpr u64 getZobristPieceKey(ChessPiece piece, usize squareIndex) {
+        const auto pieceIndex = static_cast<usize>(piece.type) * ChessPieceColorTypeCount + static_cast<usize>(piece.color);
+        return Implementation::ZobristKeysTable.pieceKeys[pieceIndex][squareIndex];
+    }
+
+    constexpr u64 getZobristCastlingKey(u8 castlingRights) {
+        return Implementation::ZobristKeysTable.castlingKeys[castlingRights];
+    }
+
+    constexpr u64 getZobristEnPassantKey(u8 enPassantSquareIndex) {
+        return enPassantSquareIndex == NoSquareIndex ? 0 : Implementation::ZobristKeysTable.enPassantKeys[getSquareFile(enPassantSquareIndex)];
+    }
+
+    // Included in the key when black is to move.
+    constexpr u64 getZobristSideToMoveKey() {
+        return Implementation::ZobristKeysTable.sideToMoveKey;
+    }
+}
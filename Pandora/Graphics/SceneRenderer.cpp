@@ -65,14 +65,8 @@ namespace Pandora {
         }
     }
 
-    struct SpriteDrawCommand {
-        u32 indexCount{};
-        u32 quadOffset{};
-        u32 textureId{};
-    };
-
-    static std::vector<SpriteDrawCommand> mapSpritesToDrawCommands(
-        std::vector<Implementation::Vertex>& vertices,
+    std::vector<Implementation::SpriteDrawCommand> Implementation::mapSpritesToDrawCommands(
+        std::vector<Vertex>& vertices,
         std::vector<u32>& indices,
         std::vector<Sprite>& sprites
     ) {
@@ -155,7 +149,7 @@ namespace Pandora {
         }
 
         const auto& frame = _frameData[device.getCurrentFrameIndex()];
-        const auto drawCommands = mapSpritesToDrawCommands(_spriteVertices, _spriteIndices, scene.sprites);
+        const auto drawCommands = Implementation::mapSpritesToDrawCommands(_spriteVertices, _spriteIndices, scene.sprites);
 
         auto vertexData = std::as_bytes(std::span{ _spriteVertices });
         auto indexData = std::as_bytes(std::span{ _spriteIndices });
@@ -9,6 +9,11 @@
 #include <array>
 #include <vector>
 
+namespace Pandora {
+
+    struct Sprite;
+}
+
 namespace Pandora::Implementation {
 
     struct SceneFrameData {
@@ -24,6 +29,18 @@ namespace Pandora::Implementation {
         Vector2f position{};
         Vector2f texturePosition{};
     };
+
+    struct SpriteDrawCommand {
+        u32 indexCount{};
+        u32 quadOffset{};
+        u32 textureId{};
+    };
+
+    std::vector<SpriteDrawCommand> mapSpritesToDrawCommands(
+        std::vector<Vertex>& vertices,
+        std::vector<u32>& indices,
+        std::vector<Sprite>& sprites
+    );
 }
 
 namespace Pandora {
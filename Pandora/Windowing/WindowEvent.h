@@ -10,6 +10,8 @@ namespace Pandora {
         S,
         D,
         W,
+        R,
+        M,
         Esc,
         Space,
         Unknown
@@ -63,6 +63,8 @@ namespace Pandora::Implementation {
         case 0x44: return KeyboardKeyType::D;
         case 0x53: return KeyboardKeyType::S;
         case 0x57: return KeyboardKeyType::W;
+        case 0x52: return KeyboardKeyType::R;
+        case 0x4D: return KeyboardKeyType::M;
         case 0x20: return KeyboardKeyType::Space;
         default: return KeyboardKeyType::Unknown;
         }
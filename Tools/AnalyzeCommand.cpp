@@ -0,0 +1,67 @@
+#include "Commands.h"
+
+#include "ChessCore/Fen.h"
+#include "ChessCore/San.h"
+#include "ChessCore/Search.h"
+
+#include <chrono>
+#include <optional>
+#include <print>
+#include <string>
+
+using namespace ChessCore;
+
+static std::string writeSanLine(Position position, const std::vector<ChessMove>& moves) {
+    auto line = std::string{};
+
+    for (const auto& move : moves) {
+        auto buffer = SanBuffer{};
+
+        if (!line.empty()) {
+            line += ' ';
+        }
+
+        line += writeSan(position, move, buffer);
+        position.makeMove(move);
+    }
+
+    return line;
+}
+
+int runAnalyzeCommand(const CommandLine& commandLine) {
+    const auto position = createPositionFromFen(commandLine.getOption("fen", StartingPositionFen));
+
+    auto limits = SearchLimits{};
+    limits.depth = static_cast<u32>(commandLine.getCount("depth", 6));
+    limits.time = std::chrono::milliseconds{ commandLine.getCount("time", 0) };
+
+    auto transpositionTable = TranspositionTable{ commandLine.getCount("hash", 64) };
+    auto searcher = Searcher{ transpositionTable };
+    searcher.setPrincipalVariationCount(commandLine.getCount("lines", 3));
+
+    auto traceWriter = std::optional<SearchTraceWriter>{};
+
+    if (commandLine.hasOption("trace")) {
+        traceWriter.emplace(commandLine.getOption("trace", {}));
+        searcher.setTraceBuffer(&traceWriter->createBuffer());
+    }
+
+    const auto result = searcher.search(position, limits, {}, [&](const SearchResult& iteration) {
+        const auto elapsedMilliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(iteration.elapsedTime).count();
+
+        std::println("depth {} nodes {} time {} ms", iteration.depth, iteration.nodeCount, elapsedMilliseconds);
+
+        for (auto lineIndex = 0ull; lineIndex < iteration.lines.size(); lineIndex++) {
+            const auto& line = iteration.lines[lineIndex];
+            std::println("  {}. {:>6}  {}", lineIndex + 1, line.score, writeSanLine(position, line.principalVariation));
+        }
+    });
+
+    std::println("{} lines to depth {} in {} nodes", result.lines.size(), result.depth, result.nodeCount);
+
+    if (commandLine.getCount("stats", 0) != 0) {
+        std::print("{}", writeSearchStatisticsInfo(result.statistics));
+    }
+
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include "Commands.h"
+
+#include "ChessCore/BatchMoveGen.h"
+#include "ChessCore/Fen.h"
+#include "ChessCore/MoveGen.h"
+#include "ChessCore/TrainingData.h"
+
+#include <algorithm>
+#include <chrono>
+#include <print>
+#include <vector>
+
+using namespace ChessCore;
+
+// Counts the legal moves of training positions with the scalar generator in a loop and with the batch generator,
+// checks that both agree and reports the throughput of each. Positions are converted to bitboards before timing.
+int runBatchMoveGenCommand(const CommandLine& commandLine) {
+    const auto reader = TrainingDataReader{ commandLine.getPositional(0) };
+    const auto positionCount = std::min(commandLine.getCount("positions", reader.getRecordCount()), reader.getRecordCount());
+    const auto roundCount = std::max<usize>(commandLine.getCount("rounds", 10), 1);
+
+    auto positions = std::vector<Position>{};
+    auto bitboardPositions = std::vector<BitboardPosition>{};
+
+    for (auto recordIndex = 0ull; recordIndex < positionCount; recordIndex++) {
+        positions.push_back(unpackTrainingRecord(reader.getRecord(recordIndex)));
+        bitboardPositions.push_back(mapPositionToBitboardPosition(positions.back()));
+    }
+
+    auto scalarMoveCounts = std::vector<u32>(positionCount);
+    auto summaries = std::vector<BitboardMoveSummary>(positionCount);
+
+    const auto scalarStartTime = std::chrono::steady_clock::now();
+
+    for (auto roundIndex = 0ull; roundIndex < roundCount; roundIndex++) {
+        auto moves = MoveList{};
+
+        for (auto positionIndex = 0ull; positionIndex < positionCount; positionIndex++) {
+            moves.clear();
+            computeLegalMoves(positions[positionIndex], moves);
+            scalarMoveCounts[positionIndex] = static_cast<u32>(moves.size());
+        }
+    }
+
+    const auto scalarSeconds = std::chrono::duration<f64>(std::chrono::steady_clock::now() - scalarStartTime).count();
+    const auto batchStartTime = std::chrono::steady_clock::now();
+
+    for (auto roundIndex = 0ull; roundIndex < roundCount; roundIndex++) {
+        computeBitboardMoveSummaries(bitboardPositions, summaries);
+    }
+
+    const auto batchSeconds = std::chrono::duration<f64>(std::chrono::steady_clock::now() - batchStartTime).count();
+    const auto summarizedCount = static_cast<f64>(positionCount * roundCount);
+
+    std::println("Scalar: {} positions x {} rounds in {:.3f} s ({:.0f} positions/s)", positionCount, roundCount, scalarSeconds, summarizedCount / std::max(scalarSeconds, 1e-9));
+    std::println("Batch:  {} positions x {} rounds in {:.3f} s ({:.0f} positions/s), attacks included, {} lanes", positionCount, roundCount, batchSeconds,
+        summarizedCount / std::max(batchSeconds, 1e-9), isBatchMoveGenUsingAvx2() ? "AVX2" : "portable");
+    std::println("Speedup: {:.2f}x", scalarSeconds / std::max(batchSeconds, 1e-9));
+
+    for (auto positionIndex = 0ull; positionIndex < positionCount; positionIndex++) {
+        if (summaries[positionIndex].legalMoveCount != scalarMoveCounts[positionIndex]) {
+            std::println(stderr, "Move counts differ in {}: {} and {}", convertPositionToFen(positions[positionIndex]),
+                scalarMoveCounts[positionIndex], summaries[positionIndex].legalMoveCount);
+            return 1;
+        }
+    }
+
+    return 0;
+}
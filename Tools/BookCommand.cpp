@@ -0,0 +1,32 @@
+#include "Commands.h"
+
+#include "ChessCore/Fen.h"
+#include "ChessCore/PolyglotBook.h"
+#include "ChessCore/San.h"
+
+#include <print>
+
+using namespace ChessCore;
+
+int runBookProbeCommand(const CommandLine& commandLine) {
+    const auto book = PolyglotBook{ commandLine.getPositional(0) };
+    const auto position = createPositionFromFen(commandLine.getOption("fen", StartingPositionFen));
+
+    const auto moves = book.findMoves(position);
+
+    auto totalWeight = 0ull;
+    for (const auto& bookMove : moves) {
+        totalWeight += bookMove.weight;
+    }
+
+    std::println("Key {:016x}, {} book moves out of {} entries", computePolyglotKey(position), moves.size(), book.getEntryCount());
+
+    for (const auto& bookMove : moves) {
+        auto buffer = SanBuffer{};
+        const auto share = totalWeight != 0 ? 100.0 * bookMove.weight / totalWeight : 0.0;
+
+        std::println("  {:8} weight {:5} ({:.1f}%)", writeSan(position, bookMove.move, buffer), bookMove.weight, share);
+    }
+
+    return 0;
+}
@@ -0,0 +1,75 @@
+#include "CommandLine.h"
+
+#include <algorithm>
+#include <charconv>
+#include <format>
+#include <stdexcept>
+#include <thread>
+
+CommandLine::CommandLine(std::span<char*> arguments) {
+    for (auto argumentIndex = 0ull; argumentIndex < arguments.size(); argumentIndex++) {
+        const auto argument = std::string_view{ arguments[argumentIndex] };
+
+        if (!argument.starts_with("--")) {
+            _positionals.push_back(argument);
+            continue;
+        }
+
+        if (argumentIndex + 1 >= arguments.size()) {
+            throw std::runtime_error(std::format("Missing value for option {}", argument));
+        }
+
+        _options.emplace_back(argument.substr(2), std::string_view{ arguments[++argumentIndex] });
+    }
+}
+
+std::string_view CommandLine::getPositional(usize index) const {
+    if (index >= _positionals.size()) {
+        throw std::runtime_error(std::format("Missing argument {}", index + 1));
+    }
+
+    return _positionals[index];
+}
+
+bool CommandLine::hasOption(std::string_view name) const {
+    return std::ranges::find(_options, name, &std::pair<std::string_view, std::string_view>::first) != _options.end();
+}
+
+std::string_view CommandLine::getOption(std::string_view name, std::string_view defaultValue) const {
+    const auto option = std::ranges::find(_options, name, &std::pair<std::string_view, std::string_view>::first);
+    return option != _options.end() ? option->second : defaultValue;
+}
+
+usize CommandLine::getCount(std::string_view name, usize defaultValue) const {
+    return hasOption(name) ? parseCount(getOption(name, {})) : defaultValue;
+}
+
+f64 CommandLine::getNumber(std::string_view name, f64 defaultValue) const {
+    return hasOption(name) ? parseNumber(getOption(name, {})) : defaultValue;
+}
+
+usize parseCount(std::string_view value) {
+    auto count = usize{};
+
+    const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), count);
+    if (error != std::errc{} || end != value.data() + value.size()) {
+        throw std::runtime_error(std::format("Expected a number but got '{}'", value));
+    }
+
+    return count;
+}
+
+f64 parseNumber(std::string_view value) {
+    auto number = f64{};
+
+    const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), number);
+    if (error != std::errc{} || end != value.data() + value.size()) {
+        throw std::runtime_error(std::format("Expected a number but got '{}'", value));
+    }
+
+    return number;
+}
+
+usize getDefaultThreadCount() {
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Pandora/Pandora.h"
+
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Positional arguments and "--name value" options that follow the tool command name.
+class CommandLine {
+public:
+    explicit CommandLine(std::span<char*> arguments);
+
+    std::string_view getPositional(usize index) const;
+
+    usize getPositionalCount() const {
+        return _positionals.size();
+    }
+
+    bool hasOption(std::string_view name) const;
+
+    std::string_view getOption(std::string_view name, std::string_view defaultValue) const;
+    usize getCount(std::string_view name, usize defaultValue) const;
+    f64 getNumber(std::string_view name, f64 defaultValue) const;
+private:
+    std::vector<std::string_view> _positionals{};
+    std::vector<std::pair<std::string_view, std::string_view>> _options{};
+};
+
+usize parseCount(std::string_view value);
+
+f64 parseNumber(std::string_view value);
+
+usize getDefaultThreadCount();
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "CommandLine.h"
+
+int runPgnStatsCommand(const CommandLine& commandLine);
+
+int runBookProbeCommand(const CommandLine& commandLine);
+
+int runSyzygyProbeCommand(const CommandLine& commandLine);
+
+int runSyzygyVerifyCommand(const CommandLine& commandLine);
+
+int runEpdSuiteCommand(const CommandLine& commandLine);
+
+int runSelfPlayCommand(const CommandLine& commandLine);
+
+int runGenerateDataCommand(const CommandLine& commandLine);
+
+int runSampleDataCommand(const CommandLine& commandLine);
+
+int runTuneCommand(const CommandLine& commandLine);
+
+int runPositionIndexCommand(const CommandLine& commandLine);
+
+int runPositionQueryCommand(const CommandLine& commandLine);
+
+int runCompactGamesCommand(const CommandLine& commandLine);
+
+int runCompactReplayCommand(const CommandLine& commandLine);
+
+int runReviewCommand(const CommandLine& commandLine);
+
+int runGameServerCommand(const CommandLine& commandLine);
+
+int runGameLoadCommand(const CommandLine& commandLine);
+
+int runAnalyzeCommand(const CommandLine& commandLine);
+
+int runMateCommand(const CommandLine& commandLine);
+
+int runPerftCommand(const CommandLine& commandLine);
+
+int runTraceSummaryCommand(const CommandLine& commandLine);
+
+int runBatchMoveGenCommand(const CommandLine& commandLine);
+
+int runSelfTestCommand(const CommandLine& commandLine);
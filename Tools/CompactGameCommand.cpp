@@ -0,0 +1,105 @@
+#include "Commands.h"
+
+#include "ChessCore/CompactGame.h"
+#include "ChessCore/MappedFile.h"
+#include "ChessCore/Pgn.h"
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <optional>
+#include <print>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace ChessCore;
+
+static CompactGameEncodingType parseCompactGameEncodingType(std::string_view name) {
+    if (name == "index") {
+        return CompactGameEncodingType::MoveIndex;
+    }
+
+    if (name == "huffman") {
+        return CompactGameEncodingType::Huffman;
+    }
+
+    throw std::runtime_error(std::format("Unknown encoding '{}', expected index or huffman", name));
+}
+
+int runCompactGamesCommand(const CommandLine& commandLine) {
+    const auto file = MappedFile{ commandLine.getPositional(0) };
+    const auto threadCount = commandLine.getCount("threads", getDefaultThreadCount());
+    const auto encoding = parseCompactGameEncodingType(commandLine.getOption("encoding", "index"));
+
+    const auto startTime = std::chrono::steady_clock::now();
+
+    auto shardWriters = std::vector<CompactGameWriter>(threadCount);
+
+    readPgnGamesInParallel(file.getContents(), threadCount, [&shardWriters](usize shardIndex, const PgnGame& game) {
+        shardWriters[shardIndex].addGame(game.tags, game.startingPosition, game.moves, game.result);
+    });
+
+    auto writer = CompactGameWriter{};
+
+    for (const auto& shardWriter : shardWriters) {
+        writer.append(shardWriter);
+    }
+
+    const auto bytes = writer.encode(encoding);
+    writeCompactGameFile(commandLine.getPositional(1), bytes);
+
+    const auto elapsedSeconds = std::chrono::duration<f64>(std::chrono::steady_clock::now() - startTime).count();
+
+    std::println("{} games, {} moves, {} encoding", writer.getGameCount(), writer.getMoveCount(), mapCompactGameEncodingTypeToString(encoding));
+    std::println("{:.1f} MB PGN to {:.1f} MB, {:.1f}x smaller, {:.2f} bits per move, {:.3f} s on {} threads",
+        file.getSize() / 1e6, bytes.size() / 1e6, static_cast<f64>(file.getSize()) / std::max<usize>(bytes.size(), 1),
+        writer.getMoveCount() != 0 ? 8.0 * bytes.size() / writer.getMoveCount() : 0.0, elapsedSeconds, threadCount);
+
+    return 0;
+}
+
+int runCompactReplayCommand(const CommandLine& commandLine) {
+    const auto file = MappedFile{ commandLine.getPositional(0), MappedFileAccessType::Sequential };
+
+    auto reader = CompactGameReader{ file.getBytes() };
+
+    // Writing the games back to PGN checks that the encoding round-trips.
+    auto pgnFile = std::optional<std::ofstream>{};
+    if (commandLine.hasOption("pgn")) {
+        pgnFile.emplace(std::string{ commandLine.getOption("pgn", {}) });
+    }
+
+    const auto startTime = std::chrono::steady_clock::now();
+
+    auto game = CompactGame{};
+    auto pgnGame = PgnGame{};
+    auto text = std::string{};
+    auto moveCount = 0ull;
+
+    while (reader.readGame(game)) {
+        moveCount += game.moves.size();
+
+        if (!pgnFile) {
+            continue;
+        }
+
+        pgnGame.startingPosition = game.startingPosition;
+        pgnGame.moves = game.moves;
+        pgnGame.result = game.result;
+        pgnGame.tags = game.tags;
+
+        text.clear();
+        writePgnGame(pgnGame, text);
+
+        *pgnFile << text;
+    }
+
+    const auto elapsedSeconds = std::chrono::duration<f64>(std::chrono::steady_clock::now() - startTime).count();
+
+    std::println("Replayed {} games and {} moves ({} encoding) in {:.3f} s, {:.0f} games/s, {:.0f} moves/s", reader.getGameCount(), moveCount,
+        mapCompactGameEncodingTypeToString(reader.getEncodingType()), elapsedSeconds, reader.getGameCount() / elapsedSeconds, moveCount / elapsedSeconds);
+
+    return 0;
+}
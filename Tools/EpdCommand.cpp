@@ -0,0 +1,241 @@
+#include "Commands.h"
+
+#include "ChessCore/Epd.h"
+#include "ChessCore/MappedFile.h"
+#include "ChessCore/San.h"
+#include "ChessCore/Search.h"
+#include "ChessCore/Syzygy.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <print>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ChessCore;
+using namespace std::chrono_literals;
+
+struct EpdSuiteEntry {
+    std::string id{};
+    std::string expectation{};
+    std::vector<ChessMove> bestMoves{};
+    std::vector<ChessMove> avoidMoves{};
+};
+
+struct EpdSuiteResult {
+    std::optional<ChessMove> playedMove{};
+    std::optional<std::chrono::nanoseconds> solutionTime{};
+    u64 nodeCount{};
+    std::chrono::nanoseconds searchTime{};
+    SearchStatistics statistics{};
+};
+
+struct SolutionTimeBucket {
+    std::chrono::milliseconds limit{};
+    std::string_view label{};
+};
+
+static constexpr SolutionTimeBucket SolutionTimeBuckets[] = {
+    { 10ms, "< 10 ms" },
+    { 100ms, "< 100 ms" },
+    { 1000ms, "< 1 s" },
+    { 10000ms, "< 10 s" },
+    { std::chrono::milliseconds::max(), ">= 10 s" },
+};
+
+static std::string joinEpdOperands(const EpdOperation& operation) {
+    auto text = operation.opcode;
+
+    for (const auto& operand : operation.operands) {
+        text += ' ';
+        text += operand;
+    }
+
+    return text;
+}
+
+static void printSearchStatistics(std::string_view format, const SearchStatistics& statistics) {
+    if (format == "info") {
+        std::print("{}", writeSearchStatisticsInfo(statistics));
+        return;
+    }
+
+    if (format == "json") {
+        std::print("{}", writeSearchStatisticsJson(statistics));
+        return;
+    }
+
+    throw std::runtime_error(std::format("Unknown statistics format '{}', expected info or json", format));
+}
+
+static EpdSuiteEntry createEpdSuiteEntry(const EpdRecord& record, usize recordIndex) {
+    auto entry = EpdSuiteEntry{};
+
+    const auto* idOperation = record.findOperation("id");
+    entry.id = idOperation != nullptr && !idOperation->operands.empty() ? idOperation->operands.front() : std::format("#{}", recordIndex + 1);
+
+    for (const auto opcode : { "bm", "am" }) {
+        if (const auto* operation = record.findOperation(opcode)) {
+            entry.expectation += entry.expectation.empty() ? "" : ", ";
+            entry.expectation += joinEpdOperands(*operation);
+        }
+    }
+
+    entry.bestMoves = record.getMoves("bm");
+    entry.avoidMoves = record.getMoves("am");
+
+    return entry;
+}
+
+static bool isEpdSuiteMoveCorrect(const EpdSuiteEntry& entry, const ChessMove& move) {
+    const auto isBestMove = entry.bestMoves.empty() || std::ranges::find(entry.bestMoves, move) != entry.bestMoves.end();
+    const auto isAvoidMove = std::ranges::find(entry.avoidMoves, move) != entry.avoidMoves.end();
+
+    return isBestMove && !isAvoidMove;
+}
+
+static EpdSuiteResult runEpdSuitePosition(Searcher& searcher, const Position& position, const EpdSuiteEntry& entry, const SearchLimits& limits) {
+    auto suiteResult = EpdSuiteResult{};
+
+    // The solution time is the first iteration after which every later iteration kept a correct move.
+    const auto searchResult = searcher.search(position, limits, {}, [&entry, &suiteResult](const SearchResult& result) {
+        if (!result.bestMove || !isEpdSuiteMoveCorrect(entry, *result.bestMove)) {
+            suiteResult.solutionTime.reset();
+        } else if (!suiteResult.solutionTime) {
+            suiteResult.solutionTime = result.elapsedTime;
+        }
+    });
+
+    suiteResult.playedMove = searchResult.bestMove;
+    suiteResult.nodeCount = searchResult.nodeCount;
+    suiteResult.searchTime = searchResult.elapsedTime;
+    suiteResult.statistics = searchResult.statistics;
+
+    if (!searchResult.bestMove || !isEpdSuiteMoveCorrect(entry, *searchResult.bestMove)) {
+        suiteResult.solutionTime.reset();
+    }
+
+    return suiteResult;
+}
+
+int runEpdSuiteCommand(const CommandLine& commandLine) {
+    const auto file = MappedFile{ commandLine.getPositional(0) };
+    const auto records = parseEpdRecords(file.getContents());
+
+    auto entries = std::vector<EpdSuiteEntry>{};
+    entries.reserve(records.size());
+
+    for (auto recordIndex = 0ull; recordIndex < records.size(); recordIndex++) {
+        entries.push_back(createEpdSuiteEntry(records[recordIndex], recordIndex));
+    }
+
+    auto limits = SearchLimits{};
+    limits.depth = static_cast<u32>(commandLine.getCount("depth", MaximumSearchDepth));
+    limits.nodeCount = commandLine.getCount("nodes", 0);
+    limits.time = std::chrono::milliseconds{ commandLine.getCount("time", 0) };
+
+    if (!commandLine.hasOption("depth") && !commandLine.hasOption("nodes") && !commandLine.hasOption("time")) {
+        limits.time = 1000ms;
+    }
+
+    const auto threadCount = std::clamp<usize>(commandLine.getCount("threads", getDefaultThreadCount()), 1, std::max<usize>(records.size(), 1));
+    const auto hashSize = commandLine.getCount("hash", 16);
+
+    auto tablebase = std::unique_ptr<SyzygyTablebase>{};
+    if (commandLine.hasOption("syzygy")) {
+        tablebase = std::make_unique<SyzygyTablebase>(commandLine.getOption("syzygy", {}));
+    }
+
+    auto traceWriter = std::optional<SearchTraceWriter>{};
+    if (commandLine.hasOption("trace")) {
+        traceWriter.emplace(commandLine.getOption("trace", {}));
+    }
+
+    auto results = std::vector<EpdSuiteResult>(records.size());
+    auto nextRecordIndex = std::atomic<usize>{};
+
+    const auto startTime = std::chrono::steady_clock::now();
+
+    {
+        auto threads = std::vector<std::jthread>{};
+        threads.reserve(threadCount);
+
+        // Each worker owns its table, so positions never see each other's results.
+        for (auto threadIndex = 0ull; threadIndex < threadCount; threadIndex++) {
+            threads.emplace_back([&, hashSize] {
+                auto transpositionTable = TranspositionTable{ hashSize };
+                auto searcher = Searcher{ transpositionTable };
+                searcher.setTablebase(tablebase.get());
+
+                if (traceWriter) {
+                    searcher.setTraceBuffer(&traceWriter->createBuffer());
+                }
+
+                for (auto recordIndex = nextRecordIndex++; recordIndex < records.size(); recordIndex = nextRecordIndex++) {
+                    transpositionTable.clear();
+                    results[recordIndex] = runEpdSuitePosition(searcher, records[recordIndex].position, entries[recordIndex], limits);
+                }
+            });
+        }
+    }
+
+    const auto wallSeconds = std::chrono::duration<f64>(std::chrono::steady_clock::now() - startTime).count();
+
+    auto solvedCount = 0ull;
+    auto nodeCount = u64{};
+    auto searchSeconds = 0.0;
+    auto bucketCounts = std::array<usize, std::size(SolutionTimeBuckets)>{};
+    auto statistics = SearchStatistics{};
+
+    for (auto recordIndex = 0ull; recordIndex < records.size(); recordIndex++) {
+        const auto& result = results[recordIndex];
+
+        nodeCount += result.nodeCount;
+        statistics += result.statistics;
+        searchSeconds += std::chrono::duration<f64>(result.searchTime).count();
+
+        if (!result.solutionTime) {
+            auto buffer = SanBuffer{};
+            const auto playedMove = result.playedMove ? writeSan(records[recordIndex].position, *result.playedMove, buffer) : "none";
+
+            std::println("Unsolved {}: expected {}, played {}", entries[recordIndex].id, entries[recordIndex].expectation, playedMove);
+            continue;
+        }
+
+        solvedCount++;
+
+        const auto bucket = std::ranges::find_if(SolutionTimeBuckets, [&result](const SolutionTimeBucket& bucket) {
+            return *result.solutionTime < bucket.limit;
+        });
+
+        bucketCounts[bucket - std::begin(SolutionTimeBuckets)]++;
+    }
+
+    const auto solvedPercentage = records.empty() ? 0.0 : 100.0 * solvedCount / records.size();
+
+    std::println("Solved {}/{} ({:.1f}%) on {} threads", solvedCount, records.size(), solvedPercentage, threadCount);
+    std::println("Time to solution:");
+
+    const auto maximumBucketCount = std::max<usize>(*std::ranges::max_element(bucketCounts), 1);
+
+    for (auto bucketIndex = 0ull; bucketIndex < bucketCounts.size(); bucketIndex++) {
+        const auto barLength = bucketCounts[bucketIndex] * 40 / maximumBucketCount;
+        std::println("  {:>9} {:6} {}", SolutionTimeBuckets[bucketIndex].label, bucketCounts[bucketIndex], std::string(barLength, '#'));
+    }
+
+    const auto threadNodesPerSecond = searchSeconds > 0.0 ? nodeCount / searchSeconds : 0.0;
+    const auto totalNodesPerSecond = wallSeconds > 0.0 ? nodeCount / wallSeconds : 0.0;
+
+    std::println("Nodes: {}, {:.0f} nodes/s per thread, {:.0f} nodes/s total in {:.2f} s", nodeCount, threadNodesPerSecond, totalNodesPerSecond, wallSeconds);
+
+    if (commandLine.hasOption("stats")) {
+        printSearchStatistics(commandLine.getOption("stats", {}), statistics);
+    }
+
+    return 0;
+}
@@ -0,0 +1,664 @@
+#include "Commands.h"
+
+#include "ChessCore/GameServer.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <exception>
+#include <format>
+#include <optional>
+#include <print>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <WinSock2.h>
+#include <WS2tcpip.h>
+#pragma comment(lib, "Ws2_32.lib")
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace ChessCore;
+
+#ifdef _WIN32
+using SocketHandle = SOCKET;
+
+static constexpr SocketHandle InvalidSocket = INVALID_SOCKET;
+static constexpr int SendFlags = 0;
+#else
+using SocketHandle = int;
+
+static constexpr SocketHandle InvalidSocket = -1;
+static constexpr int SendFlags = MSG_NOSIGNAL;
+#endif
+
+static constexpr usize SocketReadSize = 16384;
+// Commands are short, so a client that sends more than this without a newline is dropped.
+static constexpr usize MaximumCommandLineSize = 4096;
+// A client that leaves this much of its responses unread is not read from until it catches up.
+static constexpr usize MaximumPendingOutputSize = 1024 * 1024;
+// How long the server stops accepting after running out of descriptors, unless a connection closes first.
+static constexpr auto AcceptRetryInterval = std::chrono::milliseconds{ 100 };
+
+// Winsock has to be started before the first socket call, other platforms need no setup.
+struct SocketLibrary {
+    SocketLibrary() {
+#ifdef _WIN32
+        auto data = WSADATA{};
+
+        if (WSAStartup(MAKEWORD(2, 2), &data) != 0) {
+            throw std::runtime_error("Winsock could not be started");
+        }
+#endif
+    }
+
+    ~SocketLibrary() {
+#ifdef _WIN32
+        WSACleanup();
+#endif
+    }
+
+    SocketLibrary(const SocketLibrary&) = delete;
+    SocketLibrary& operator=(const SocketLibrary&) = delete;
+};
+
+static void closeSocket(SocketHandle socket) {
+#ifdef _WIN32
+    closesocket(socket);
+#else
+    close(socket);
+#endif
+}
+
+// Owns a socket and closes it when it goes out of scope, also when an exception leaves the scope.
+class ScopedSocket {
+public:
+    explicit ScopedSocket(SocketHandle socket) : _socket(socket) {}
+
+    ~ScopedSocket() {
+        if (_socket != InvalidSocket) {
+            closeSocket(_socket);
+        }
+    }
+
+    ScopedSocket(const ScopedSocket&) = delete;
+    ScopedSocket& operator=(const ScopedSocket&) = delete;
+
+    SocketHandle get() const {
+        return _socket;
+    }
+private:
+    SocketHandle _socket = InvalidSocket;
+};
+
+static bool isSocketWouldBlock() {
+#ifdef _WIN32
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+    return errno == EAGAIN || errno == EWOULDBLOCK;
+#endif
+}
+
+// A signal interrupted the call before it did anything, so it can be made again.
+static bool isSocketInterrupted() {
+#ifdef _WIN32
+    return WSAGetLastError() == WSAEINTR;
+#else
+    return errno == EINTR;
+#endif
+}
+
+// The connection was reset while it waited to be accepted; the next one can still be taken.
+static bool isAcceptAborted() {
+#ifdef _WIN32
+    return WSAGetLastError() == WSAECONNRESET;
+#else
+    return errno == ECONNABORTED || errno == EPROTO;
+#endif
+}
+
+static bool isOutOfDescriptors() {
+#ifdef _WIN32
+    return WSAGetLastError() == WSAEMFILE || WSAGetLastError() == WSAENOBUFS;
+#else
+    return errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM;
+#endif
+}
+
+static void setSocketNonBlocking(SocketHandle socket) {
+#ifdef _WIN32
+    auto mode = u_long{ 1 };
+    ioctlsocket(socket, FIONBIO, &mode);
+#else
+    fcntl(socket, F_SETFL, fcntl(socket, F_GETFL) | O_NONBLOCK);
+#endif
+}
+
+// Responses are small and a client waits for each one, so they must not be held back to be coalesced.
+static void setSocketNoDelay(SocketHandle socket) {
+    const auto value = 1;
+    setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+static sockaddr_in createLoopbackAddress(usize port) {
+    auto address = sockaddr_in{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<u16>(port));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return address;
+}
+
+static SocketHandle createListeningSocket(usize port) {
+    const auto listeningSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+
+    if (listeningSocket == InvalidSocket) {
+        throw std::runtime_error("The listening socket could not be created");
+    }
+
+    const auto reuseAddress = 1;
+    setsockopt(listeningSocket, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuseAddress), sizeof(reuseAddress));
+
+    const auto address = createLoopbackAddress(port);
+
+    if (bind(listeningSocket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 || listen(listeningSocket, SOMAXCONN) != 0) {
+        closeSocket(listeningSocket);
+        throw std::runtime_error(std::format("Port {} could not be opened", port));
+    }
+
+    setSocketNonBlocking(listeningSocket);
+    return listeningSocket;
+}
+
+struct SocketEvent {
+    SocketHandle socket{};
+    bool isReadable{};
+    bool isWritable{};
+};
+
+// Readiness notifications for the server sockets: epoll where it exists, WSAPoll on Windows.
+class SocketPoller {
+public:
+    SocketPoller() {
+#ifndef _WIN32
+        _epollDescriptor = epoll_create1(0);
+
+        if (_epollDescriptor < 0) {
+            throw std::runtime_error("The epoll instance could not be created");
+        }
+#endif
+    }
+
+    ~SocketPoller() {
+#ifndef _WIN32
+        close(_epollDescriptor);
+#endif
+    }
+
+    SocketPoller(const SocketPoller&) = delete;
+    SocketPoller& operator=(const SocketPoller&) = delete;
+
+    void add(SocketHandle socket) {
+#ifdef _WIN32
+        _descriptors.push_back({ socket, POLLRDNORM });
+#else
+        _control(EPOLL_CTL_ADD, socket, EPOLLIN);
+#endif
+    }
+
+    // Hang-ups and errors are reported as readable even while reads are not wanted.
+    void setInterest(SocketHandle socket, bool isReadWanted, bool isWriteWanted) {
+#ifdef _WIN32
+        _findDescriptor(socket).events = static_cast<SHORT>((isReadWanted ? POLLRDNORM : 0) | (isWriteWanted ? POLLWRNORM : 0));
+#else
+        _control(EPOLL_CTL_MOD, socket, (isReadWanted ? EPOLLIN : 0u) | (isWriteWanted ? EPOLLOUT : 0u));
+#endif
+    }
+
+    void remove(SocketHandle socket) {
+#ifdef _WIN32
+        std::swap(_findDescriptor(socket), _descriptors.back());
+        _descriptors.pop_back();
+#else
+        epoll_ctl(_epollDescriptor, EPOLL_CTL_DEL, socket, nullptr);
+#endif
+    }
+
+    // Without a timeout the wait only ends with events; with one it may also end without any.
+    void wait(std::vector<SocketEvent>& events, std::optional<std::chrono::milliseconds> timeout) {
+        events.clear();
+
+        const auto timeoutMilliseconds = timeout ? static_cast<int>(timeout->count()) : -1;
+
+#ifdef _WIN32
+        if (WSAPoll(_descriptors.data(), static_cast<ULONG>(_descriptors.size()), timeoutMilliseconds) < 0) {
+            throw std::runtime_error("Waiting for sockets failed");
+        }
+
+        for (const auto& descriptor : _descriptors) {
+            if (descriptor.revents != 0) {
+                events.push_back({ descriptor.fd, (descriptor.revents & (POLLRDNORM | POLLHUP | POLLERR)) != 0, (descriptor.revents & POLLWRNORM) != 0 });
+            }
+        }
+#else
+        auto epollEvents = std::array<epoll_event, 256>{};
+        const auto eventCount = epoll_wait(_epollDescriptor, epollEvents.data(), static_cast<int>(epollEvents.size()), timeoutMilliseconds);
+
+        if (eventCount < 0) {
+            if (errno == EINTR) {
+                return;
+            }
+
+            throw std::runtime_error("Waiting for sockets failed");
+        }
+
+        for (auto eventIndex = 0; eventIndex < eventCount; eventIndex++) {
+            const auto flags = epollEvents[eventIndex].events;
+            events.push_back({ epollEvents[eventIndex].data.fd, (flags & (EPOLLIN | EPOLLHUP | EPOLLERR)) != 0, (flags & EPOLLOUT) != 0 });
+        }
+#endif
+    }
+private:
+#ifdef _WIN32
+    WSAPOLLFD& _findDescriptor(SocketHandle socket) {
+        return *std::find_if(_descriptors.begin(), _descriptors.end(), [socket](const WSAPOLLFD& descriptor) {
+            return descriptor.fd == socket;
+        });
+    }
+
+    std::vector<WSAPOLLFD> _descriptors{};
+#else
+    void _control(int operation, SocketHandle socket, u32 flags) {
+        auto event = epoll_event{};
+        event.events = flags;
+        event.data.fd = socket;
+
+        if (epoll_ctl(_epollDescriptor, operation, socket, &event) != 0) {
+            throw std::runtime_error("A socket could not be registered with epoll");
+        }
+    }
+
+    int _epollDescriptor = -1;
+#endif
+};
+
+struct ServerConnection {
+    std::string input{};
+    std::string output{};
+    GameServerSession session{};
+    bool isReading = true;
+    bool isWaitingForWrite{};
+};
+
+// Sends as much of the pending output as the socket takes without blocking. Returns false when the connection failed.
+static bool flushConnection(SocketHandle socket, ServerConnection& connection) {
+    auto sentSize = 0ull;
+
+    while (sentSize < connection.output.size()) {
+        const auto result = send(socket, connection.output.data() + sentSize, static_cast<int>(connection.output.size() - sentSize), SendFlags);
+
+        if (result < 0) {
+            if (isSocketInterrupted()) {
+                continue;
+            }
+
+            if (isSocketWouldBlock()) {
+                break;
+            }
+
+            return false;
+        }
+
+        sentSize += static_cast<usize>(result);
+    }
+
+    connection.output.erase(0, sentSize);
+    return true;
+}
+
+// Answers each complete command line and keeps the unfinished one. Returns false when a line, complete or not, is
+// longer than MaximumCommandLineSize.
+static bool handleCommandLines(ServerConnection& connection, GameServer& server) {
+    auto lineBegin = 0ull;
+
+    for (auto lineEnd = connection.input.find('\n'); lineEnd != std::string::npos; lineEnd = connection.input.find('\n', lineBegin)) {
+        if (lineEnd - lineBegin > MaximumCommandLineSize) {
+            return false;
+        }
+
+        server.handleCommand(std::string_view{ connection.input }.substr(lineBegin, lineEnd - lineBegin), connection.session, connection.output);
+        lineBegin = lineEnd + 1;
+    }
+
+    connection.input.erase(0, lineBegin);
+    return connection.input.size() <= MaximumCommandLineSize;
+}
+
+// Reads once and answers each complete command line. The poller reports the socket again while more is waiting,
+// so a busy client cannot hold up the others. Returns false when the client disconnected or sent a line that is
+// too long.
+static bool readConnection(SocketHandle socket, ServerConnection& connection, GameServer& server) {
+    auto buffer = std::array<char, SocketReadSize>{};
+
+    while (true) {
+        const auto result = recv(socket, buffer.data(), static_cast<int>(buffer.size()), 0);
+
+        if (result == 0) {
+            return false;
+        }
+
+        if (result < 0) {
+            if (isSocketInterrupted()) {
+                continue;
+            }
+
+            return isSocketWouldBlock();
+        }
+
+        connection.input.append(buffer.data(), static_cast<usize>(result));
+        return handleCommandLines(connection, server);
+    }
+}
+
+using ServerConnections = std::unordered_map<SocketHandle, ServerConnection>;
+
+// Accepts every waiting connection. Returns false when the process or the system ran out of descriptors: the
+// listening socket then stays readable, so it has to be left out of the poll for a while.
+static bool acceptConnections(SocketHandle listeningSocket, SocketPoller& poller, ServerConnections& connections) {
+    while (true) {
+        const auto socket = accept(listeningSocket, nullptr, nullptr);
+
+        if (socket == InvalidSocket) {
+            if (isSocketInterrupted() || isAcceptAborted()) {
+                continue;
+            }
+
+            return !isOutOfDescriptors();
+        }
+
+        setSocketNonBlocking(socket);
+        setSocketNoDelay(socket);
+        poller.add(socket);
+        connections.emplace(socket, ServerConnection{});
+    }
+}
+
+int runGameServerCommand(const CommandLine& commandLine) {
+    const auto port = commandLine.getCount("port", 7070);
+    const auto socketLibrary = SocketLibrary{};
+
+    auto server = GameServer{ commandLine.getCount("capacity", 65536) };
+    auto poller = SocketPoller{};
+    auto connections = ServerConnections{};
+    auto events = std::vector<SocketEvent>{};
+
+    const auto scopedListeningSocket = ScopedSocket{ createListeningSocket(port) };
+    const auto listeningSocket = scopedListeningSocket.get();
+    poller.add(listeningSocket);
+
+    auto isAccepting = true;
+    auto acceptResumeTime = std::chrono::steady_clock::time_point{};
+
+    const auto resumeAccepting = [&] {
+        if (!isAccepting) {
+            poller.setInterest(listeningSocket, true, false);
+            isAccepting = true;
+        }
+    };
+
+    std::println("Listening on 127.0.0.1:{} for up to {} games", port, server.getCapacity());
+
+    while (true) {
+        if (isAccepting) {
+            poller.wait(events, std::nullopt);
+        } else {
+            const auto remainingTime = std::chrono::ceil<std::chrono::milliseconds>(acceptResumeTime - std::chrono::steady_clock::now());
+            poller.wait(events, std::max(remainingTime, std::chrono::milliseconds{ 0 }));
+
+            if (std::chrono::steady_clock::now() >= acceptResumeTime) {
+                resumeAccepting();
+            }
+        }
+
+        for (const auto& event : events) {
+            if (event.socket == listeningSocket) {
+                if (isAccepting && !acceptConnections(listeningSocket, poller, connections)) {
+                    poller.setInterest(listeningSocket, false, false);
+                    isAccepting = false;
+                    acceptResumeTime = std::chrono::steady_clock::now() + AcceptRetryInterval;
+                }
+
+                continue;
+            }
+
+            auto& connection = connections.at(event.socket);
+            auto isOpen = true;
+
+            if (event.isReadable && connection.isReading) {
+                isOpen = readConnection(event.socket, connection, server);
+            }
+
+            if (isOpen && !connection.output.empty()) {
+                isOpen = flushConnection(event.socket, connection);
+            }
+
+            // A hang-up is reported while reads are paused, and then only sending can notice the closed connection.
+            if (isOpen && event.isReadable && !connection.isReading && connection.output.empty()) {
+                isOpen = false;
+            }
+
+            if (!isOpen) {
+                server.closeSession(connection.session);
+                poller.remove(event.socket);
+                closeSocket(event.socket);
+                connections.erase(event.socket);
+                resumeAccepting();
+                continue;
+            }
+
+            // Reads pause while too many responses are unread, and write readiness is only watched while a
+            // response did not fit in the socket buffer.
+            const auto isReadWanted = connection.output.size() < MaximumPendingOutputSize;
+            const auto isWriteWanted = !connection.output.empty();
+
+            if (isReadWanted != connection.isReading || isWriteWanted != connection.isWaitingForWrite) {
+                poller.setInterest(event.socket, isReadWanted, isWriteWanted);
+                connection.isReading = isReadWanted;
+                connection.isWaitingForWrite = isWriteWanted;
+            }
+        }
+    }
+}
+
+struct LoadGame {
+    std::string id{};
+    std::vector<std::string> moves{};
+};
+
+struct LoadConnectionResult {
+    std::vector<f64> latencies{};
+    usize finishedGameCount{};
+    std::exception_ptr exception{};
+};
+
+static void sendLine(SocketHandle socket, std::string_view line) {
+    while (!line.empty()) {
+        const auto result = send(socket, line.data(), static_cast<int>(line.size()), SendFlags);
+
+        if (result < 0 && isSocketInterrupted()) {
+            continue;
+        }
+
+        if (result <= 0) {
+            throw std::runtime_error("The server closed the connection");
+        }
+
+        line.remove_prefix(static_cast<usize>(result));
+    }
+}
+
+static std::string receiveLine(SocketHandle socket, std::string& buffer) {
+    auto lineEnd = buffer.find('\n');
+
+    while (lineEnd == std::string::npos) {
+        auto chunk = std::array<char, SocketReadSize>{};
+        const auto result = recv(socket, chunk.data(), static_cast<int>(chunk.size()), 0);
+
+        if (result < 0 && isSocketInterrupted()) {
+            continue;
+        }
+
+        if (result <= 0) {
+            throw std::runtime_error("The server closed the connection");
+        }
+
+        buffer.append(chunk.data(), static_cast<usize>(result));
+        lineEnd = buffer.find('\n');
+    }
+
+    auto line = buffer.substr(0, lineEnd);
+    buffer.erase(0, lineEnd + 1);
+    return line;
+}
+
+// Splits "ok <id> <state> <six FEN fields> <moves...>" and returns false when the game is over.
+static bool parseGameResponse(std::string_view line, LoadGame& game) {
+    auto tokens = std::vector<std::string_view>{};
+
+    for (auto begin = 0ull; begin < line.size();) {
+        const auto end = std::min(line.find(' ', begin), line.size());
+        tokens.push_back(line.substr(begin, end - begin));
+        begin = end + 1;
+    }
+
+    if (tokens.size() < 9 || tokens[0] != "ok") {
+        throw std::runtime_error(std::format("Unexpected server response: {}", line));
+    }
+
+    game.id = tokens[1];
+    game.moves.assign(tokens.begin() + 9, tokens.end());
+
+    return tokens[2] == "in-progress";
+}
+
+static void runLoadConnection(usize port, usize gameCount, usize moveCount, u64 seed, LoadConnectionResult& result) {
+    const auto scopedSocket = ScopedSocket{ ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP) };
+    const auto socket = scopedSocket.get();
+    const auto address = createLoopbackAddress(port);
+
+    if (socket == InvalidSocket || connect(socket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        throw std::runtime_error(std::format("Could not connect to 127.0.0.1:{}", port));
+    }
+
+    setSocketNoDelay(socket);
+
+    auto random = std::mt19937_64{ seed };
+    auto buffer = std::string{};
+    auto games = std::vector<LoadGame>(gameCount);
+
+    for (auto& game : games) {
+        sendLine(socket, "new\n");
+        parseGameResponse(receiveLine(socket, buffer), game);
+    }
+
+    result.latencies.reserve(moveCount);
+
+    for (auto moveIndex = 0ull; moveIndex < moveCount; moveIndex++) {
+        auto& game = games[moveIndex % games.size()];
+        const auto command = std::format("move {} {}\n", game.id, game.moves[random() % game.moves.size()]);
+
+        const auto startTime = std::chrono::steady_clock::now();
+        sendLine(socket, command);
+        const auto response = receiveLine(socket, buffer);
+        result.latencies.push_back(std::chrono::duration<f64, std::micro>(std::chrono::steady_clock::now() - startTime).count());
+
+        if (!parseGameResponse(response, game)) {
+            sendLine(socket, std::format("close {}\nnew\n", game.id));
+            receiveLine(socket, buffer);
+            parseGameResponse(receiveLine(socket, buffer), game);
+            result.finishedGameCount++;
+        }
+    }
+
+    // Games belong to the server until closed, so the next run starts from the same capacity.
+    for (const auto& game : games) {
+        sendLine(socket, std::format("close {}\n", game.id));
+        receiveLine(socket, buffer);
+    }
+}
+
+int runGameLoadCommand(const CommandLine& commandLine) {
+    const auto port = commandLine.getCount("port", 7070);
+    const auto connectionCount = std::max<usize>(commandLine.getCount("connections", 8), 1);
+    const auto gameCount = std::max(commandLine.getCount("games", 1024), connectionCount);
+    const auto moveCount = commandLine.getCount("moves", 200000);
+    const auto seed = static_cast<u64>(commandLine.getCount("seed", 1));
+    const auto socketLibrary = SocketLibrary{};
+
+    auto results = std::vector<LoadConnectionResult>(connectionCount);
+    const auto startTime = std::chrono::steady_clock::now();
+
+    {
+        auto threads = std::vector<std::jthread>{};
+        threads.reserve(connectionCount);
+
+        for (auto connectionIndex = 0ull; connectionIndex < connectionCount; connectionIndex++) {
+            const auto connectionGameCount = gameCount / connectionCount + (connectionIndex < gameCount % connectionCount ? 1 : 0);
+            const auto connectionMoveCount = moveCount / connectionCount + (connectionIndex < moveCount % connectionCount ? 1 : 0);
+
+            threads.emplace_back([&, connectionIndex, connectionGameCount, connectionMoveCount] {
+                auto& result = results[connectionIndex];
+
+                try {
+                    runLoadConnection(port, connectionGameCount, connectionMoveCount, seed + connectionIndex, result);
+                } catch (...) {
+                    result.exception = std::current_exception();
+                }
+            });
+        }
+    }
+
+    const auto elapsedSeconds = std::chrono::duration<f64>(std::chrono::steady_clock::now() - startTime).count();
+
+    auto latencies = std::vector<f64>{};
+    auto finishedGameCount = 0ull;
+
+    for (const auto& result : results) {
+        if (result.exception) {
+            std::rethrow_exception(result.exception);
+        }
+
+        latencies.insert(latencies.end(), result.latencies.begin(), result.latencies.end());
+        finishedGameCount += result.finishedGameCount;
+    }
+
+    if (latencies.empty()) {
+        throw std::runtime_error("No moves were played");
+    }
+
+    std::ranges::sort(latencies);
+
+    const auto getPercentile = [&](f64 percentile) {
+        return latencies[std::min(static_cast<usize>(percentile * static_cast<f64>(latencies.size())), latencies.size() - 1)];
+    };
+
+    std::println("{} moves in {} games on {} connections in {:.2f} s, {} games finished", latencies.size(), gameCount, connectionCount, elapsedSeconds, finishedGameCount);
+    std::println("{:.0f} moves/s, latency p50 {:.1f} us, p99 {:.1f} us, max {:.1f} us",
+        static_cast<f64>(latencies.size()) / elapsedSeconds, getPercentile(0.5), getPercentile(0.99), latencies.back());
+
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include "Commands.h"
+
+#include <exception>
+#include <print>
+#include <span>
+#include <string_view>
+
+struct ToolCommand {
+    std::string_view name{};
+    std::string_view usage{};
+    int(*run)(const CommandLine& commandLine) = nullptr;
+};
+
+static constexpr ToolCommand ToolCommands[] = {
+    { "pgn-stats", "<file.pgn> [--threads n]", runPgnStatsCommand },
+    { "book-probe", "<book.bin> [--fen fen]", runBookProbeCommand },
+    { "syzygy-probe", "<directory> [--fen fen]", runSyzygyProbeCommand },
+    { "syzygy-verify", "<directory> [--positions 10000] [--seed n]", runSyzygyVerifyCommand },
+    { "epd-suite", "<file.epd> [--threads n] [--time ms] [--nodes n] [--depth n] [--hash mb] [--syzygy directory] [--stats info|json] [--trace file.trace]", runEpdSuiteCommand },
+    { "self-play", "[--games n] [--concurrency n] [--engine1 nodes=20000,depth=n,time=ms,clock=ms,inc=ms,tm=0|1,hash=mb] [--engine2 ...] [--openings file.epd | --book book.bin --book-plies n | --random-plies n] [--elo0 0] [--elo1 5] [--alpha 0.05] [--beta 0.05] [--max-plies 400] [--pgn games.pgn]", runSelfPlayCommand },
+    { "gen-data", "<output.bin> [--games n] [--threads n] [--nodes 5000] [--depth n] [--hash mb] [--random-plies 8] [--max-plies 400] [--seed n]", runGenerateDataCommand },
+    { "sample-data", "<data.bin> [--count 10] [--seed n]", runSampleDataCommand },
+    { "tune", "<data.bin> [--positions n] [--threads n] [--epochs 10] [--batch 16384] [--optimizer adam|gd] [--rate r] [--k constant] [--seed n] [--output file]", runTuneCommand },
+    { "position-index", "<file.pgn> <output.idx> [--threads n]", runPositionIndexCommand },
+    { "position-query", "<index.idx> [--fen fen] [--pgn file.pgn] [--limit 20]", runPositionQueryCommand },
+    { "compact-games", "<file.pgn> <output.cgm> [--encoding index|huffman] [--threads n]", runCompactGamesCommand },
+    { "compact-replay", "<file.cgm> [--pgn output.pgn]", runCompactReplayCommand },
+    { "review", "<file.pgn> [--game 1] [--depth 6] [--threads n] [--hash 64]", runReviewCommand },
+    { "game-server", "[--port 7070] [--capacity 65536]", runGameServerCommand },
+    { "game-load", "[--port 7070] [--connections 8] [--games 1024] [--moves 200000] [--seed n]", runGameLoadCommand },
+    { "analyze", "[--fen fen] [--lines 3] [--depth 6] [--time ms] [--hash 64] [--stats 0|1] [--trace file.trace]", runAnalyzeCommand },
+    { "mate", "[--fen fen] [--moves 10] [--nodes 10000000] [--hash 64]", runMateCommand },
+    { "perft", "[--fen fen] [--depth 6] [--threads n] [--hash 64] [--divide 0|1]", runPerftCommand },
+    { "trace-summary", "<file.trace> [--limit 10]", runTraceSummaryCommand },
+    { "batch-movegen", "<data.bin> [--positions n] [--rounds 10]", runBatchMoveGenCommand },
+    { "self-test", "", runSelfTestCommand },
+};
+
+static void printUsage() {
+    std::println("Usage: Tools <command> [arguments]");
+
+    for (const auto& command : ToolCommands) {
+        std::println("  {} {}", command.name, command.usage);
+    }
+}
+
+int main(int argc, char** argv) {
+    const auto arguments = std::span{ argv, static_cast<usize>(argc) };
+
+    if (arguments.size() < 2) {
+        printUsage();
+        return 1;
+    }
+
+    const auto commandName = std::string_view{ arguments[1] };
+
+    for (const auto& command : ToolCommands) {
+        if (command.name != commandName) {
+            continue;
+        }
+
+        try {
+            return command.run(CommandLine{ arguments.subspan(2) });
+        } catch (const std::exception& exception) {
+            std::println(stderr, "{}: {}", command.name, exception.what());
+            return 1;
+        }
+    }
+
+    printUsage();
+    return 1;
+}
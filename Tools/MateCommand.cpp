@@ -0,0 +1,53 @@
+#include "Commands.h"
+
+#include "ChessCore/Fen.h"
+#include "ChessCore/MateSolver.h"
+#include "ChessCore/San.h"
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <print>
+#include <string>
+
+using namespace ChessCore;
+
+int runMateCommand(const CommandLine& commandLine) {
+    const auto position = createPositionFromFen(commandLine.getOption("fen", StartingPositionFen));
+
+    auto limits = MateSearchLimits{};
+    limits.moveCount = static_cast<u32>(commandLine.getCount("moves", limits.moveCount));
+    limits.nodeCount = commandLine.getCount("nodes", limits.nodeCount);
+
+    auto solver = MateSolver{ commandLine.getCount("hash", 64) };
+    const auto result = solver.solve(position, limits);
+
+    const auto elapsedSeconds = std::chrono::duration<f64>(result.elapsedTime).count();
+    const auto nodesPerSecond = static_cast<f64>(result.nodeCount) / std::max(elapsedSeconds, 1e-9);
+
+    if (result.type == MateSearchResultType::Mate) {
+        auto solutionPosition = position;
+        auto solution = std::string{};
+
+        for (const auto& move : result.solution) {
+            auto buffer = SanBuffer{};
+
+            if (solutionPosition.getSideToMove() == ChessPieceColorType::White || solution.empty()) {
+                solution += std::format("{}{} ", solutionPosition.getFullmoveNumber(), solutionPosition.getSideToMove() == ChessPieceColorType::White ? "." : "...");
+            }
+
+            solution += std::format("{} ", writeSan(solutionPosition, move, buffer));
+            solutionPosition.makeMove(move);
+        }
+
+        std::println("Mate in {}: {}", result.moveCount, solution);
+    } else if (result.type == MateSearchResultType::NoMate) {
+        std::println("No mate in {} moves", limits.moveCount);
+    } else {
+        std::println("Unknown: the node budget ran out");
+    }
+
+    std::println("{} nodes in {:.2f} s ({:.0f} nodes/s)", result.nodeCount, elapsedSeconds, nodesPerSecond);
+
+    return result.type == MateSearchResultType::Unknown ? 1 : 0;
+}
@@ -0,0 +1,60 @@
+#include "Commands.h"
+
+#include "ChessCore/Fen.h"
+#include "ChessCore/Perft.h"
+#include "ChessCore/Uci.h"
+
+#include <algorithm>
+#include <chrono>
+#include <print>
+
+using namespace ChessCore;
+
+static u64 sumNodeCounts(const std::vector<PerftMoveCount>& moveCounts) {
+    auto nodeCount = 0ull;
+
+    for (const auto& moveCount : moveCounts) {
+        nodeCount += moveCount.nodeCount;
+    }
+
+    return nodeCount;
+}
+
+// Runs the single-threaded perft as the reference, then the parallel hashed one, and checks that both agree.
+int runPerftCommand(const CommandLine& commandLine) {
+    const auto position = createPositionFromFen(commandLine.getOption("fen", StartingPositionFen));
+    const auto depth = static_cast<u32>(commandLine.getCount("depth", 6));
+
+    auto settings = PerftSettings{};
+    settings.threadCount = commandLine.getCount("threads", getDefaultThreadCount());
+    settings.hashSize = commandLine.getCount("hash", 64);
+
+    const auto serialStartTime = std::chrono::steady_clock::now();
+    const auto serialNodeCount = perft(position, depth);
+    const auto serialSeconds = std::chrono::duration<f64>(std::chrono::steady_clock::now() - serialStartTime).count();
+
+    const auto parallelStartTime = std::chrono::steady_clock::now();
+    const auto moveCounts = perftDivide(position, depth, settings);
+    const auto parallelSeconds = std::chrono::duration<f64>(std::chrono::steady_clock::now() - parallelStartTime).count();
+
+    const auto parallelNodeCount = depth == 0 ? 1 : sumNodeCounts(moveCounts);
+
+    if (commandLine.getCount("divide", 0) != 0) {
+        for (const auto& moveCount : moveCounts) {
+            auto buffer = UciMoveBuffer{};
+            std::println("{}: {}", writeUciMove(moveCount.move, buffer), moveCount.nodeCount);
+        }
+    }
+
+    std::println("Serial:   {} nodes in {:.3f} s ({:.0f} nodes/s)", serialNodeCount, serialSeconds, serialNodeCount / std::max(serialSeconds, 1e-9));
+    std::println("Parallel: {} nodes in {:.3f} s ({:.0f} nodes/s) with {} threads and a {} MB table",
+        parallelNodeCount, parallelSeconds, parallelNodeCount / std::max(parallelSeconds, 1e-9), settings.threadCount, settings.hashSize);
+    std::println("Speedup:  {:.2f}x", serialSeconds / std::max(parallelSeconds, 1e-9));
+
+    if (parallelNodeCount != serialNodeCount) {
+        std::println(stderr, "Node counts differ");
+        return 1;
+    }
+
+    return 0;
+}
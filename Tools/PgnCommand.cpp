@@ -0,0 +1,62 @@
+#include "Commands.h"
+
+#include "ChessCore/MappedFile.h"
+#include "ChessCore/Pgn.h"
+
+#include <chrono>
+#include <print>
+#include <vector>
+
+using namespace ChessCore;
+
+struct PgnResultCounts {
+    usize whiteWinCount{};
+    usize blackWinCount{};
+    usize drawCount{};
+    usize unknownCount{};
+};
+
+int runPgnStatsCommand(const CommandLine& commandLine) {
+    const auto file = MappedFile{ commandLine.getPositional(0) };
+    const auto threadCount = commandLine.getCount("threads", getDefaultThreadCount());
+
+    auto shardResultCounts = std::vector<PgnResultCounts>(threadCount);
+
+    const auto startTime = std::chrono::steady_clock::now();
+
+    const auto statistics = readPgnGamesInParallel(file.getContents(), threadCount, [&shardResultCounts](usize shardIndex, const PgnGame& game) {
+        auto& counts = shardResultCounts[shardIndex];
+
+        switch (game.result) {
+        case PgnResultType::WhiteWin:
+            counts.whiteWinCount++;
+            break;
+        case PgnResultType::BlackWin:
+            counts.blackWinCount++;
+            break;
+        case PgnResultType::Draw:
+            counts.drawCount++;
+            break;
+        default:
+            counts.unknownCount++;
+            break;
+        }
+    });
+
+    const auto elapsedSeconds = std::chrono::duration<f64>(std::chrono::steady_clock::now() - startTime).count();
+
+    auto resultCounts = PgnResultCounts{};
+
+    for (const auto& counts : shardResultCounts) {
+        resultCounts.whiteWinCount += counts.whiteWinCount;
+        resultCounts.blackWinCount += counts.blackWinCount;
+        resultCounts.drawCount += counts.drawCount;
+        resultCounts.unknownCount += counts.unknownCount;
+    }
+
+    std::println("Games: {} ({} with errors), moves: {}", statistics.gameCount, statistics.errorCount, statistics.moveCount);
+    std::println("Results: {} white wins, {} black wins, {} draws, {} unknown", resultCounts.whiteWinCount, resultCounts.blackWinCount, resultCounts.drawCount, resultCounts.unknownCount);
+    std::println("Read {:.1f} MB in {:.3f} s on {} threads, {:.0f} games/min", file.getSize() / 1e6, elapsedSeconds, threadCount, statistics.gameCount / elapsedSeconds * 60.0);
+
+    return 0;
+}
@@ -0,0 +1,62 @@
+#include "Commands.h"
+
+#include "ChessCore/Fen.h"
+#include "ChessCore/MappedFile.h"
+#include "ChessCore/Pgn.h"
+#include "ChessCore/PositionIndex.h"
+
+#include <chrono>
+#include <optional>
+#include <print>
+#include <ranges>
+
+using namespace ChessCore;
+
+int runPositionIndexCommand(const CommandLine& commandLine) {
+    const auto file = MappedFile{ commandLine.getPositional(0) };
+    const auto threadCount = commandLine.getCount("threads", getDefaultThreadCount());
+
+    const auto startTime = std::chrono::steady_clock::now();
+    const auto statistics = buildPositionIndex(file.getContents(), commandLine.getPositional(1), threadCount);
+    const auto elapsedSeconds = std::chrono::duration<f64>(std::chrono::steady_clock::now() - startTime).count();
+
+    std::println("Games: {} ({} with errors), positions: {}, distinct keys: {}", statistics.gameCount, statistics.errorCount, statistics.entryCount, statistics.keyCount);
+    std::println("Index size {:.1f} MB, {:.2f} bytes per position, built in {:.3f} s on {} threads",
+        statistics.fileSize / 1e6, statistics.entryCount != 0 ? static_cast<f64>(statistics.fileSize) / statistics.entryCount : 0.0, elapsedSeconds, threadCount);
+
+    return 0;
+}
+
+int runPositionQueryCommand(const CommandLine& commandLine) {
+    const auto index = PositionIndex{ commandLine.getPositional(0) };
+    const auto position = createPositionFromFen(commandLine.getOption("fen", StartingPositionFen));
+    const auto limit = commandLine.getCount("limit", 20);
+
+    // With the PGN the index was built from, the players and result of each game are shown as well.
+    auto pgnFile = std::optional<MappedFile>{};
+    if (commandLine.hasOption("pgn")) {
+        pgnFile.emplace(commandLine.getOption("pgn", {}), MappedFileAccessType::Random);
+    }
+
+    const auto startTime = std::chrono::steady_clock::now();
+    const auto entries = index.findEntries(position);
+    const auto elapsedMicroseconds = std::chrono::duration<f64, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+
+    std::println("Key {:016x} reached {} times in {} games indexed, query took {:.1f} us", position.getKey(), entries.size(), index.getGameCount(), elapsedMicroseconds);
+
+    auto game = PgnGame{};
+
+    for (const auto& entry : entries | std::views::take(limit)) {
+        if (!pgnFile) {
+            std::println("  Game {:>8} ply {:>4}", entry.gameIndex + 1, entry.ply);
+            continue;
+        }
+
+        auto reader = PgnReader{ pgnFile->getContents().substr(index.getGameOffset(entry.gameIndex)) };
+        reader.readGame(game);
+
+        std::println("  Game {:>8} ply {:>4}  {} - {} {}", entry.gameIndex + 1, entry.ply, game.findTag("White"), game.findTag("Black"), mapPgnResultTypeToString(game.result));
+    }
+
+    return 0;
+}
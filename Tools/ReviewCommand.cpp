@@ -0,0 +1,65 @@
+#include "Commands.h"
+
+#include "ChessCore/MappedFile.h"
+#include "ChessCore/Pgn.h"
+#include "ChessCore/Review.h"
+#include "ChessCore/San.h"
+
+#include <array>
+#include <chrono>
+#include <format>
+#include <print>
+#include <stdexcept>
+
+using namespace ChessCore;
+
+int runReviewCommand(const CommandLine& commandLine) {
+    const auto file = MappedFile{ commandLine.getPositional(0) };
+    const auto gameNumber = commandLine.getCount("game", 1);
+
+    auto settings = ReviewSettings{};
+    settings.depth = static_cast<u32>(commandLine.getCount("depth", settings.depth));
+    settings.threadCount = commandLine.getCount("threads", getDefaultThreadCount());
+    settings.hashSize = commandLine.getCount("hash", settings.hashSize);
+
+    auto reader = PgnReader{ file.getContents() };
+    auto game = PgnGame{};
+
+    for (auto gameIndex = 0ull; gameIndex < gameNumber; gameIndex++) {
+        if (!reader.readGame(game)) {
+            throw std::runtime_error(std::format("The file has fewer than {} games", gameNumber));
+        }
+    }
+
+    const auto startTime = std::chrono::steady_clock::now();
+    const auto reviewedMoves = reviewGame(game.startingPosition, game.moves, settings);
+    const auto elapsedSeconds = std::chrono::duration<f64>(std::chrono::steady_clock::now() - startTime).count();
+
+    auto classificationCounts = std::array<std::array<usize, MoveClassificationTypeCount>, 2>{};
+    auto position = game.startingPosition;
+
+    for (const auto& reviewedMove : reviewedMoves) {
+        auto playedBuffer = SanBuffer{};
+        auto bestBuffer = SanBuffer{};
+
+        const auto isWhite = position.getSideToMove() == ChessPieceColorType::White;
+
+        std::println("{:>3}{} {:<8} {:<10} {:>6}  best {:<8} {:>6}", position.getFullmoveNumber(), isWhite ? ". " : "...",
+            writeSan(position, reviewedMove.move, playedBuffer), mapMoveClassificationTypeToString(reviewedMove.classification),
+            reviewedMove.playedScore, writeSan(position, reviewedMove.bestMove, bestBuffer), reviewedMove.bestScore);
+
+        classificationCounts[isWhite ? 0 : 1][static_cast<usize>(reviewedMove.classification)]++;
+        position.makeMove(reviewedMove.move);
+    }
+
+    for (auto colorIndex = 0ull; colorIndex < classificationCounts.size(); colorIndex++) {
+        const auto& counts = classificationCounts[colorIndex];
+
+        std::println("{}: {} best, {} good, {} inaccuracies, {} mistakes, {} blunders", colorIndex == 0 ? "White" : "Black",
+            counts[0], counts[1], counts[2], counts[3], counts[4]);
+    }
+
+    std::println("Reviewed {} positions at depth {} in {:.2f} s on {} threads", reviewedMoves.size() + 1, settings.depth, elapsedSeconds, settings.threadCount);
+
+    return 0;
+}
@@ -0,0 +1,395 @@
+#include "Commands.h"
+#include "Sprt.h"
+
+#include "ChessCore/Epd.h"
+#include "ChessCore/Game.h"
+#include "ChessCore/MappedFile.h"
+#include "ChessCore/MoveGen.h"
+#include "ChessCore/Pgn.h"
+#include "ChessCore/PolyglotBook.h"
+#include "ChessCore/Search.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <print>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ChessCore;
+
+struct SelfPlayEngine {
+    std::string name{};
+    SearchLimits limits{};
+    SearchParameters parameters{};
+    usize hashSize = 16;
+    // Without the time manager a clock is spent in equal shares, so A/B tests can measure what the manager gains.
+    bool isTimeManagerEnabled = true;
+};
+
+// The share of the clock each move gets when the time manager is off.
+static constexpr u32 FixedTimeShareMoveCount = 30;
+
+struct SelfPlayOpenings {
+    std::vector<EpdRecord> positions{};
+    std::unique_ptr<PolyglotBook> book{};
+    usize bookPlyCount{};
+    usize randomPlyCount{};
+    u64 seed{};
+};
+
+struct SelfPlayGameRecord {
+    Position startingPosition{};
+    std::vector<ChessMove> moves{};
+    PgnResultType result{};
+    std::string_view termination{};
+};
+
+// Engines are described as "nodes=20000,depth=12,time=100,hash=16", or play on a clock with "clock=10000,inc=100"
+// (milliseconds) and "tm=0" to turn the time manager off; without a budget a node limit is used.
+// Selectivity settings such as "nmp=0" or "rfp-margin=100" override the search parameters for A/B tests.
+static bool parseSearchParameter(std::string_view name, usize value, SearchParameters& parameters) {
+    const auto number = static_cast<i32>(value);
+
+    if (name == "nmp") {
+        parameters.isNullMovePruningEnabled = value != 0;
+    } else if (name == "nmp-depth") {
+        parameters.nullMoveMinimumDepth = number;
+    } else if (name == "nmp-reduction") {
+        parameters.nullMoveReduction = number;
+    } else if (name == "nmp-verify") {
+        parameters.nullMoveVerificationDepth = number;
+    } else if (name == "lmr") {
+        parameters.isLateMoveReductionEnabled = value != 0;
+    } else if (name == "lmr-depth") {
+        parameters.lateMoveReductionMinimumDepth = number;
+    } else if (name == "lmr-moves") {
+        parameters.lateMoveReductionMoveCount = static_cast<u32>(value);
+    } else if (name == "lmr-base") {
+        parameters.lateMoveReductionBase = number;
+    } else if (name == "lmr-divisor") {
+        parameters.lateMoveReductionDivisor = number;
+    } else if (name == "rfp") {
+        parameters.isReverseFutilityPruningEnabled = value != 0;
+    } else if (name == "rfp-depth") {
+        parameters.reverseFutilityMaximumDepth = number;
+    } else if (name == "rfp-margin") {
+        parameters.reverseFutilityMargin = number;
+    } else if (name == "fp") {
+        parameters.isFutilityPruningEnabled = value != 0;
+    } else if (name == "fp-depth") {
+        parameters.futilityMaximumDepth = number;
+    } else if (name == "fp-margin") {
+        parameters.futilityMargin = number;
+    } else if (name == "check-extension") {
+        parameters.isCheckExtensionEnabled = value != 0;
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+static SelfPlayEngine parseSelfPlayEngine(std::string_view name, std::string_view description) {
+    auto engine = SelfPlayEngine{ std::string{ name } };
+    auto hasBudget = false;
+
+    while (!description.empty()) {
+        const auto separatorIndex = description.find(',');
+        const auto setting = description.substr(0, separatorIndex);
+
+        description = separatorIndex == std::string_view::npos ? std::string_view{} : description.substr(separatorIndex + 1);
+
+        const auto equalsIndex = setting.find('=');
+
+        if (equalsIndex == std::string_view::npos) {
+            throw std::runtime_error(std::format("Expected name=value in engine setting '{}'", setting));
+        }
+
+        const auto settingName = setting.substr(0, equalsIndex);
+        const auto value = parseCount(setting.substr(equalsIndex + 1));
+
+        if (settingName == "nodes") {
+            engine.limits.nodeCount = value;
+            hasBudget = true;
+        } else if (settingName == "depth") {
+            engine.limits.depth = static_cast<u32>(value);
+            hasBudget = true;
+        } else if (settingName == "time") {
+            engine.limits.time = std::chrono::milliseconds{ value };
+            hasBudget = true;
+        } else if (settingName == "clock") {
+            engine.limits.timeControl.remainingTime = std::chrono::milliseconds{ value };
+            hasBudget = true;
+        } else if (settingName == "inc") {
+            engine.limits.timeControl.increment = std::chrono::milliseconds{ value };
+        } else if (settingName == "tm") {
+            engine.isTimeManagerEnabled = value != 0;
+        } else if (settingName == "hash") {
+            engine.hashSize = value;
+        } else if (!parseSearchParameter(settingName, value, engine.parameters)) {
+            throw std::runtime_error(std::format("Unknown engine setting '{}'", settingName));
+        }
+    }
+
+    if (!hasBudget) {
+        engine.limits.nodeCount = 20000;
+    }
+
+    return engine;
+}
+
+// Both games of a pair start from the same opening, which is chosen from the pair index so workers agree on it.
+static Position createSelfPlayOpening(const SelfPlayOpenings& openings, usize pairIndex) {
+    if (!openings.positions.empty()) {
+        return openings.positions[pairIndex % openings.positions.size()].position;
+    }
+
+    auto position = Position::createStartingPosition();
+    auto random = std::mt19937_64{ openings.seed + pairIndex };
+
+    if (openings.book) {
+        for (auto plyIndex = 0ull; plyIndex < openings.bookPlyCount; plyIndex++) {
+            const auto move = openings.book->pickMove(position, random());
+
+            if (!move) {
+                break;
+            }
+
+            position.makeMove(*move);
+        }
+
+        return position;
+    }
+
+    for (auto plyIndex = 0ull; plyIndex < openings.randomPlyCount; plyIndex++) {
+        const auto legalMoves = computeLegalMoves(position);
+
+        if (legalMoves.empty()) {
+            break;
+        }
+
+        position.makeMove(legalMoves[random() % legalMoves.size()]);
+    }
+
+    return position;
+}
+
+static SelfPlayGameRecord playSelfPlayGame(const Position& opening, std::array<Searcher*, 2> searchers, std::array<const SelfPlayEngine*, 2> engines, usize maximumPlyCount) {
+    auto record = SelfPlayGameRecord{ opening };
+    auto position = opening;
+    auto previousKeys = std::vector<u64>{};
+    auto remainingTimes = std::array{ engines[0]->limits.timeControl.remainingTime, engines[1]->limits.timeControl.remainingTime };
+
+    while (true) {
+        const auto state = computeGameState(position, previousKeys);
+
+        if (state != GameStateType::InProgress) {
+            record.result = mapGameStateTypeToPgnResultType(state, position.getSideToMove());
+            record.termination = mapGameStateTypeToString(state);
+            break;
+        }
+
+        if (record.moves.size() >= maximumPlyCount) {
+            record.result = PgnResultType::Draw;
+            record.termination = "Move limit";
+            break;
+        }
+
+        const auto sideIndex = position.getSideToMove() == ChessPieceColorType::White ? 0 : 1;
+        const auto& engine = *engines[sideIndex];
+        const auto hasClock = engine.limits.timeControl.remainingTime.count() != 0;
+
+        auto limits = engine.limits;
+        limits.timeControl.remainingTime = remainingTimes[sideIndex];
+
+        if (hasClock && !engine.isTimeManagerEnabled) {
+            limits.time = remainingTimes[sideIndex] / FixedTimeShareMoveCount + limits.timeControl.increment;
+            limits.timeControl = {};
+        }
+
+        const auto startTime = std::chrono::steady_clock::now();
+        const auto result = searchers[sideIndex]->search(position, limits, previousKeys);
+
+        if (hasClock) {
+            remainingTimes[sideIndex] -= std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+
+            if (remainingTimes[sideIndex].count() <= 0) {
+                record.result = sideIndex == 0 ? PgnResultType::BlackWin : PgnResultType::WhiteWin;
+                record.termination = "Time forfeit";
+                break;
+            }
+
+            remainingTimes[sideIndex] += engine.limits.timeControl.increment;
+        }
+
+        previousKeys.push_back(position.getKey());
+        position.makeMove(*result.bestMove);
+        record.moves.push_back(*result.bestMove);
+    }
+
+    return record;
+}
+
+static void writeSelfPlayGame(std::ofstream& file, const SelfPlayGameRecord& record, usize gameIndex, const SelfPlayEngine& white, const SelfPlayEngine& black) {
+    const auto round = std::to_string(gameIndex + 1);
+
+    auto game = PgnGame{};
+    game.startingPosition = record.startingPosition;
+    game.moves = record.moves;
+    game.result = record.result;
+    game.tags = {
+        { "Event", "Self-play" },
+        { "Round", round },
+        { "White", white.name },
+        { "Black", black.name },
+        { "Result", mapPgnResultTypeToString(record.result) },
+        { "Termination", record.termination },
+    };
+
+    auto text = std::string{};
+    writePgnGame(game, text);
+
+    file << text;
+}
+
+int runSelfPlayCommand(const CommandLine& commandLine) {
+    const auto engines = std::array{
+        parseSelfPlayEngine("engine1", commandLine.getOption("engine1", "")),
+        parseSelfPlayEngine("engine2", commandLine.getOption("engine2", "")),
+    };
+
+    auto openings = SelfPlayOpenings{};
+    openings.seed = commandLine.getCount("seed", 1);
+    openings.bookPlyCount = commandLine.getCount("book-plies", 8);
+    openings.randomPlyCount = commandLine.getCount("random-plies", 4);
+
+    if (commandLine.hasOption("openings")) {
+        const auto file = MappedFile{ commandLine.getOption("openings", {}) };
+        openings.positions = parseEpdRecords(file.getContents());
+    } else if (commandLine.hasOption("book")) {
+        openings.book = std::make_unique<PolyglotBook>(commandLine.getOption("book", {}));
+    }
+
+    const auto sprtParameters = SprtParameters{
+        commandLine.getNumber("elo0", 0.0),
+        commandLine.getNumber("elo1", 5.0),
+        commandLine.getNumber("alpha", 0.05),
+        commandLine.getNumber("beta", 0.05),
+    };
+
+    // Games are played in pairs with colours swapped, so the count is rounded up to an even number.
+    const auto gameCount = (commandLine.getCount("games", 1000) + 1) / 2 * 2;
+    const auto concurrency = std::clamp<usize>(commandLine.getCount("concurrency", getDefaultThreadCount()), 1, std::max<usize>(gameCount, 1));
+    const auto maximumPlyCount = commandLine.getCount("max-plies", 400);
+
+    auto pgnFile = std::optional<std::ofstream>{};
+    if (commandLine.hasOption("pgn")) {
+        pgnFile.emplace(std::string{ commandLine.getOption("pgn", {}) });
+    }
+
+    auto resultMutex = std::mutex{};
+    auto score = MatchScore{};
+    auto sprtResult = SprtResultType::Continue;
+    auto completedGameCount = 0ull;
+
+    auto nextGameIndex = std::atomic<usize>{};
+    auto isStopRequested = std::atomic<bool>{};
+
+    std::println("{} games of {} vs {} on {} threads, SPRT elo0 {} elo1 {} alpha {} beta {}",
+        gameCount, engines[0].name, engines[1].name, concurrency, sprtParameters.elo0, sprtParameters.elo1, sprtParameters.alpha, sprtParameters.beta);
+
+    {
+        auto threads = std::vector<std::jthread>{};
+        threads.reserve(concurrency);
+
+        for (auto threadIndex = 0ull; threadIndex < concurrency; threadIndex++) {
+            threads.emplace_back([&] {
+                auto firstTable = TranspositionTable{ engines[0].hashSize };
+                auto secondTable = TranspositionTable{ engines[1].hashSize };
+                auto firstSearcher = Searcher{ firstTable };
+                auto secondSearcher = Searcher{ secondTable };
+
+                firstSearcher.setParameters(engines[0].parameters);
+                secondSearcher.setParameters(engines[1].parameters);
+
+                while (!isStopRequested.load()) {
+                    const auto gameIndex = nextGameIndex++;
+
+                    if (gameIndex >= gameCount) {
+                        break;
+                    }
+
+                    const auto isFirstEngineWhite = gameIndex % 2 == 0;
+                    const auto opening = createSelfPlayOpening(openings, gameIndex / 2);
+
+                    firstTable.clear();
+                    secondTable.clear();
+
+                    const auto searchers = isFirstEngineWhite ? std::array{ &firstSearcher, &secondSearcher } : std::array{ &secondSearcher, &firstSearcher };
+                    const auto players = isFirstEngineWhite ? std::array{ &engines[0], &engines[1] } : std::array{ &engines[1], &engines[0] };
+
+                    const auto record = playSelfPlayGame(opening, searchers, players, maximumPlyCount);
+
+                    const auto lock = std::scoped_lock{ resultMutex };
+
+                    const auto firstEngineResult = isFirstEngineWhite ? record.result
+                        : record.result == PgnResultType::WhiteWin ? PgnResultType::BlackWin
+                        : record.result == PgnResultType::BlackWin ? PgnResultType::WhiteWin
+                        : record.result;
+
+                    switch (firstEngineResult) {
+                    case PgnResultType::WhiteWin:
+                        score.winCount++;
+                        break;
+                    case PgnResultType::BlackWin:
+                        score.lossCount++;
+                        break;
+                    default:
+                        score.drawCount++;
+                        break;
+                    }
+
+                    completedGameCount++;
+
+                    if (pgnFile) {
+                        writeSelfPlayGame(*pgnFile, record, gameIndex, *players[0], *players[1]);
+                    }
+
+                    std::println("Game {} ({}/{}): {} vs {} {} {}, W-D-L {}-{}-{}, LLR {:.2f} [{:.2f}, {:.2f}]",
+                        gameIndex + 1, completedGameCount, gameCount, players[0]->name, players[1]->name,
+                        mapPgnResultTypeToString(record.result), record.termination, score.winCount, score.drawCount, score.lossCount,
+                        computeSprtLogLikelihoodRatio(score, sprtParameters), computeSprtLowerBound(sprtParameters), computeSprtUpperBound(sprtParameters));
+
+                    // Games already running are finished and counted, but no new ones are started, and they do not
+                    // change the decision the test already reached.
+                    if (sprtResult == SprtResultType::Continue) {
+                        sprtResult = evaluateSprt(score, sprtParameters);
+                    }
+
+                    if (sprtResult != SprtResultType::Continue) {
+                        isStopRequested.store(true);
+                    }
+                }
+            });
+        }
+    }
+
+    const auto gameTotal = score.getGameCount();
+    const auto scorePercentage = gameTotal != 0 ? 100.0 * (score.winCount + 0.5 * score.drawCount) / gameTotal : 0.0;
+
+    std::println("Score of {} vs {}: {} - {} - {} [{:.1f}%] {} games", engines[0].name, engines[1].name, score.winCount, score.lossCount, score.drawCount, scorePercentage, gameTotal);
+    std::println("Elo difference: {:.1f} +/- {:.1f}", computeEloDifference(score), computeEloErrorMargin(score));
+    std::println("SPRT: LLR {:.2f} [{:.2f}, {:.2f}], {}", computeSprtLogLikelihoodRatio(score, sprtParameters),
+        computeSprtLowerBound(sprtParameters), computeSprtUpperBound(sprtParameters), mapSprtResultTypeToString(sprtResult));
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+#include "Commands.h"
+
+#include "ChessCore/Fen.h"
+#include "ChessCore/Pgn.h"
+#include "ChessCore/PolyglotBook.h"
+#include "ChessCore/San.h"
+
+#include <format>
+#include <functional>
+#include <string>
+#include <print>
+#include <string_view>
+
+using namespace ChessCore;
+
+// Runs checks of ChessCore behaviour that the other commands do not exercise and reports each failure.
+class SelfTest {
+public:
+    void expect(std::string_view name, bool isPassed) {
+        _checkCount++;
+
+        if (!isPassed) {
+            _failureCount++;
+            std::println(stderr, "FAILED: {}", name);
+        }
+    }
+
+    void expectThrow(std::string_view name, const std::function<void()>& function) {
+        auto isThrown = false;
+
+        try {
+            function();
+        } catch (const std::exception&) {
+            isThrown = true;
+        }
+
+        expect(name, isThrown);
+    }
+
+    int finish() const {
+        std::println("{} of {} checks passed", _checkCount - _failureCount, _checkCount);
+        return _failureCount == 0 ? 0 : 1;
+    }
+private:
+    usize _checkCount{};
+    usize _failureCount{};
+};
+
+static void testSanPromotions(SelfTest& test) {
+    const auto position = createPositionFromFen("8/4P3/8/8/8/8/8/k6K w - - 0 1");
+
+    test.expect("SAN e8=Q promotes to a queen", createMoveFromSan(position, "e8=Q").promotionType == ChessPieceType::Queen);
+    test.expect("SAN e8N promotes to a knight", createMoveFromSan(position, "e8N").promotionType == ChessPieceType::Knight);
+    test.expectThrow("SAN e8=K is rejected", [&position] { createMoveFromSan(position, "e8=K"); });
+    test.expectThrow("SAN e8=P is rejected", [&position] { createMoveFromSan(position, "e8=P"); });
+    test.expectThrow("SAN e8 without a promotion is rejected", [&position] { createMoveFromSan(position, "e8"); });
+}
+
+// The keys published with the Polyglot book format for the start position and the moves that lead from it.
+static void testPolyglotKeys(SelfTest& test) {
+    struct PolyglotKeyCase {
+        std::string_view fen;
+        u64 key{};
+    };
+
+    static constexpr PolyglotKeyCase Cases[] = {
+        { "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 0x463b96181691fc9c },
+        { "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1", 0x823c9b50fd114196 },
+        { "rnbqkbnr/ppp1pppp/8/3p4/4P3/8/PPPP1PPP/RNBQKBNR w KQkq d6 0 2", 0x0756b94461c50fb0 },
+        { "rnbqkbnr/ppp1pppp/8/3pP3/8/8/PPPP1PPP/RNBQKBNR b KQkq - 0 2", 0x662fafb965db29d4 },
+        { "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3", 0x22a48b5a8e47ff78 },
+        { "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR b kq - 0 3", 0x652a607ca3f242c1 },
+        { "rnbq1bnr/ppp1pkpp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR w - - 0 4", 0x00fdd303c946bdd9 },
+        { "rnbqkbnr/p1pppppp/8/8/PpP4P/8/1P1PPPP1/RNBQKBNR b KQkq c3 0 3", 0x3c8123ea7b067637 },
+        { "rnbqkbnr/p1pppppp/8/8/P6P/R1p5/1P1PPPP1/1NBQKBNR b Kkq - 0 4", 0x5c3f9b829b279560 },
+    };
+
+    for (const auto& keyCase : Cases) {
+        test.expect(std::format("Polyglot key of {}", keyCase.fen), computePolyglotKey(createPositionFromFen(keyCase.fen)) == keyCase.key);
+    }
+}
+
+static void testPgnTagRoundTrip(SelfTest& test) {
+    constexpr auto Text = std::string_view{ "[Event \"The \\\"Open\\\" C:\\\\Chess\"]\n[Result \"1-0\"]\n\n1. e4 e5 1-0\n" };
+
+    auto game = PgnGame{};
+    auto reader = PgnReader{ Text };
+    reader.readGame(game);
+
+    auto text = std::string{};
+    writePgnGame(game, text);
+
+    auto writtenGame = PgnGame{};
+    auto writtenReader = PgnReader{ text };
+    writtenReader.readGame(writtenGame);
+
+    test.expect("PGN tag with a quote and a backslash is written as read", text.starts_with("[Event \"The \\\"Open\\\" C:\\\\Chess\"]\n"));
+    test.expect("PGN tag with a quote and a backslash reads back unchanged", writtenGame.findTag("Event") == game.findTag("Event"));
+}
+
+int runSelfTestCommand(const CommandLine&) {
+    auto test = SelfTest{};
+
+    testSanPromotions(test);
+    testPolyglotKeys(test);
+    testPgnTagRoundTrip(test);
+
+    return test.finish();
+}
@@ -0,0 +1,93 @@
+#include "Sprt.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+static f64 mapEloToScore(f64 elo) {
+    return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+}
+
+static f64 mapScoreToElo(f64 score) {
+    const auto clampedScore = std::clamp(score, 1e-6, 1.0 - 1e-6);
+    return -400.0 * std::log10(1.0 / clampedScore - 1.0);
+}
+
+static f64 computeMeanScore(const MatchScore& score) {
+    return (score.winCount + 0.5 * score.drawCount) / score.getGameCount();
+}
+
+static f64 computeScoreVariance(const MatchScore& score) {
+    const auto gameCount = static_cast<f64>(score.getGameCount());
+    const auto mean = computeMeanScore(score);
+
+    return (score.winCount * std::pow(1.0 - mean, 2.0) + score.drawCount * std::pow(0.5 - mean, 2.0) + score.lossCount * std::pow(mean, 2.0)) / gameCount;
+}
+
+f64 computeSprtLowerBound(const SprtParameters& parameters) {
+    return std::log(parameters.beta / (1.0 - parameters.alpha));
+}
+
+f64 computeSprtUpperBound(const SprtParameters& parameters) {
+    return std::log((1.0 - parameters.beta) / parameters.alpha);
+}
+
+f64 computeSprtLogLikelihoodRatio(const MatchScore& score, const SprtParameters& parameters) {
+    if (score.getGameCount() == 0) {
+        return 0.0;
+    }
+
+    // Until two different results were seen the variance is zero and there is no evidence either way.
+    const auto variance = computeScoreVariance(score);
+
+    if (variance <= 0.0) {
+        return 0.0;
+    }
+
+    const auto score0 = mapEloToScore(parameters.elo0);
+    const auto score1 = mapEloToScore(parameters.elo1);
+
+    return score.getGameCount() * (score1 - score0) * (2.0 * computeMeanScore(score) - score0 - score1) / (2.0 * variance);
+}
+
+SprtResultType evaluateSprt(const MatchScore& score, const SprtParameters& parameters) {
+    const auto logLikelihoodRatio = computeSprtLogLikelihoodRatio(score, parameters);
+
+    if (logLikelihoodRatio >= computeSprtUpperBound(parameters)) {
+        return SprtResultType::AcceptH1;
+    }
+
+    if (logLikelihoodRatio <= computeSprtLowerBound(parameters)) {
+        return SprtResultType::AcceptH0;
+    }
+
+    return SprtResultType::Continue;
+}
+
+f64 computeEloDifference(const MatchScore& score) {
+    return score.getGameCount() != 0 ? mapScoreToElo(computeMeanScore(score)) : 0.0;
+}
+
+f64 computeEloErrorMargin(const MatchScore& score) {
+    if (score.getGameCount() == 0) {
+        return 0.0;
+    }
+
+    const auto mean = computeMeanScore(score);
+    const auto deviation = 1.96 * std::sqrt(computeScoreVariance(score) / score.getGameCount());
+
+    return (mapScoreToElo(mean + deviation) - mapScoreToElo(mean - deviation)) / 2.0;
+}
+
+std::string_view mapSprtResultTypeToString(SprtResultType type) {
+    switch (type) {
+    case SprtResultType::Continue:
+        return "inconclusive";
+    case SprtResultType::AcceptH0:
+        return "H0 accepted";
+    case SprtResultType::AcceptH1:
+        return "H1 accepted";
+    default:
+        throw std::runtime_error("Unreachable");
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Pandora/Pandora.h"
+
+#include <string_view>
+
+struct MatchScore {
+    usize winCount{};
+    usize drawCount{};
+    usize lossCount{};
+
+    usize getGameCount() const {
+        return winCount + drawCount + lossCount;
+    }
+};
+
+// Tests H0: Elo difference is elo0 against H1: it is elo1, with alpha and beta the false positive and false negative rates.
+struct SprtParameters {
+    f64 elo0{};
+    f64 elo1 = 5.0;
+    f64 alpha = 0.05;
+    f64 beta = 0.05;
+};
+
+enum class SprtResultType : i16 {
+    Continue,
+    AcceptH0,
+    AcceptH1,
+};
+
+f64 computeSprtLowerBound(const SprtParameters& parameters);
+
+f64 computeSprtUpperBound(const SprtParameters& parameters);
+
+// Log-likelihood ratio of H1 against H0 under a normal approximation of the per-game score.
+f64 computeSprtLogLikelihoodRatio(const MatchScore& score, const SprtParameters& parameters);
+
+SprtResultType evaluateSprt(const MatchScore& score, const SprtParameters& parameters);
+
+f64 computeEloDifference(const MatchScore& score);
+
+// Half width of the 95% confidence interval of the Elo difference.
+f64 computeEloErrorMargin(const MatchScore& score);
+
+std::string_view mapSprtResultTypeToString(SprtResultType type);
@@ -0,0 +1,275 @@
+#include "Commands.h"
+
+#include "ChessCore/Fen.h"
+#include "ChessCore/MoveGen.h"
+#include "ChessCore/Syzygy.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <optional>
+#include <print>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace ChessCore;
+
+static constexpr std::string_view SyzygyVerifyPieceCharacters = " QRBNPK";
+
+// Printed per table, the rest are only counted.
+static constexpr usize MaximumReportedMismatchCount = 5;
+
+int runSyzygyProbeCommand(const CommandLine& commandLine) {
+    const auto tablebase = SyzygyTablebase{ commandLine.getPositional(0) };
+    const auto position = createPositionFromFen(commandLine.getOption("fen", StartingPositionFen));
+
+    std::println("{} tables with up to {} pieces", tablebase.getTableCount(), tablebase.getMaximumPieceCount());
+
+    if (!tablebase.canProbe(position)) {
+        std::println("Position is outside of the tablebase");
+        return 1;
+    }
+
+    const auto wdl = tablebase.probeWdl(position);
+    const auto dtz = tablebase.probeDtz(position);
+
+    std::println("WDL {}", wdl ? mapSyzygyWdlTypeToString(*wdl) : "unavailable");
+
+    if (dtz) {
+        std::println("DTZ {}", *dtz);
+    } else {
+        std::println("DTZ unavailable");
+    }
+
+    return wdl ? 0 : 1;
+}
+
+// The pieces of a table name such as KRPvKR, the side before the v as white.
+static std::optional<std::vector<ChessPiece>> parseSyzygyMaterial(std::string_view name) {
+    auto pieces = std::vector<ChessPiece>{};
+    auto color = ChessPieceColorType::White;
+
+    for (const auto character : name) {
+        if (character == 'v' && color == ChessPieceColorType::White) {
+            color = ChessPieceColorType::Black;
+            continue;
+        }
+
+        const auto typeIndex = SyzygyVerifyPieceCharacters.find(character);
+
+        if (typeIndex == std::string_view::npos || typeIndex == 0) {
+            return std::nullopt;
+        }
+
+        pieces.push_back({ static_cast<ChessPieceType>(typeIndex), color });
+    }
+
+    if (color != ChessPieceColorType::Black) {
+        return std::nullopt;
+    }
+
+    return pieces;
+}
+
+// Pawns stay off the first and last ranks and the side that just moved must not be in check.
+static std::optional<Position> createRandomPosition(std::span<const ChessPiece> pieces, std::mt19937_64& random) {
+    auto position = Position{};
+
+    for (const auto piece : pieces) {
+        const auto isPawn = piece.type == ChessPieceType::Pawn;
+        auto squareIndex = usize{};
+
+        do {
+            squareIndex = isPawn ? 8 + random() % 48 : random() % BoardSquareCount;
+        } while (position.getPiece(squareIndex) != ChessPieces::None);
+
+        position.setPiece(squareIndex, piece);
+    }
+
+    const auto sideToMove = random() % 2 == 0 ? ChessPieceColorType::White : ChessPieceColorType::Black;
+    position.setSideToMove(sideToMove);
+
+    if (position.isKingUnderCheck(mapColorToOpposite(sideToMove))) {
+        return std::nullopt;
+    }
+
+    return position;
+}
+
+static bool isZeroingMove(const Position& position, const ChessMove& move) {
+    return position.getPiece(move.startingSquareIndex).type == ChessPieceType::Pawn || position.getPiece(move.targetSquareIndex) != ChessPieces::None || move.isEnPassant;
+}
+
+static int computeSign(i32 value) {
+    return (value > 0) - (value < 0);
+}
+
+// 1, 0 or -1 for the side to move, ignoring the 50-move rule: cursed wins count as wins and blessed losses as losses.
+static int mapSyzygyWdlTypeToResult(SyzygyWdlType type) {
+    return computeSign(static_cast<i32>(type));
+}
+
+struct SyzygyExpectation {
+    int result{};
+    std::optional<i32> dtz{};
+};
+
+// The result and DTZ a position must have given the tables' values one move later. Mates and stalemates are decided
+// by the rules instead of the tables. DTZ is left empty when it cannot be derived: for mates and stalemates, for
+// positions whose 50-move outcome is cursed or blessed and when a DTZ table is missing.
+static std::optional<SyzygyExpectation> computeSyzygyExpectation(const SyzygyTablebase& tablebase, const Position& position, SyzygyWdlType wdl) {
+    const auto moves = computeLegalMoves(position);
+
+    if (moves.empty()) {
+        return SyzygyExpectation{ position.isKingUnderCheck() ? -1 : 0 };
+    }
+
+    auto expectation = SyzygyExpectation{ -1 };
+    auto winningDtz = std::optional<i32>{};
+    auto losingDtz = i32{};
+    auto isDtzAvailable = true;
+
+    for (const auto& move : moves) {
+        auto nextPosition = position;
+        nextPosition.makeMove(move);
+
+        const auto isZeroing = isZeroingMove(position, move);
+        const auto isFinal = computeLegalMoves(nextPosition).empty();
+        auto nextResult = 0;
+        auto nextDtz = std::optional<i32>{};
+
+        if (isFinal) {
+            nextResult = nextPosition.isKingUnderCheck() ? -1 : 0;
+        } else {
+            const auto nextWdl = tablebase.probeWdl(nextPosition);
+
+            if (!nextWdl) {
+                return std::nullopt;
+            }
+
+            nextResult = mapSyzygyWdlTypeToResult(*nextWdl);
+            nextDtz = isZeroing ? std::nullopt : tablebase.probeDtz(nextPosition);
+            isDtzAvailable = isDtzAvailable && (isZeroing || nextDtz.has_value());
+        }
+
+        expectation.result = std::max(expectation.result, -nextResult);
+
+        // A zeroing move or a mate ends the count after one ply, any other move one ply before the next position's.
+        const auto plyCount = isZeroing || isFinal ? 1 : std::abs(nextDtz.value_or(0)) + 1;
+
+        if (nextResult == -1) {
+            winningDtz = std::min(winningDtz.value_or(plyCount), plyCount);
+        } else if (nextResult == 1) {
+            losingDtz = std::max(losingDtz, plyCount);
+        }
+    }
+
+    const auto isCursed = wdl == SyzygyWdlType::CursedWin || wdl == SyzygyWdlType::BlessedLoss;
+
+    if (!isDtzAvailable || isCursed) {
+        return expectation;
+    }
+
+    if (expectation.result == 1) {
+        expectation.dtz = winningDtz;
+    } else if (expectation.result == -1) {
+        expectation.dtz = -losingDtz;
+    } else {
+        expectation.dtz = 0;
+    }
+
+    return expectation;
+}
+
+// Checks every table in the directory on random positions of its material, with either colour on either side,
+// against the tables' own values one move later: WDL must agree exactly and DTZ within the one ply probeDtz may
+// add. Mates, stalemates and captures into smaller tables tie the tables to the rules of the game.
+int runSyzygyVerifyCommand(const CommandLine& commandLine) {
+    const auto directory = std::filesystem::path{ commandLine.getPositional(0) };
+    const auto tablebase = SyzygyTablebase{ directory };
+    const auto positionCount = commandLine.getCount("positions", 10000);
+
+    auto random = std::mt19937_64{ commandLine.getCount("seed", 1) };
+    auto tableCount = usize{};
+    auto totalCheckedCount = usize{};
+    auto mismatchCount = usize{};
+
+    for (const auto& entry : std::filesystem::directory_iterator{ directory }) {
+        const auto name = entry.path().stem().string();
+        const auto pieces = parseSyzygyMaterial(name);
+
+        if (entry.path().extension() != ".rtbw" || !pieces) {
+            continue;
+        }
+
+        auto mirroredPieces = *pieces;
+
+        for (auto& piece : mirroredPieces) {
+            piece.color = mapColorToOpposite(piece.color);
+        }
+
+        auto checkedCount = usize{};
+        auto skippedCount = usize{};
+        auto wdlMismatchCount = usize{};
+        auto dtzMismatchCount = usize{};
+        auto reportedMismatches = std::vector<std::string>{};
+
+        for (auto positionIndex = 0ull; positionIndex < positionCount; positionIndex++) {
+            const auto position = createRandomPosition(positionIndex % 2 == 0 ? *pieces : mirroredPieces, random);
+
+            if (!position) {
+                continue;
+            }
+
+            const auto wdl = tablebase.probeWdl(*position);
+            const auto dtz = tablebase.probeDtz(*position);
+            const auto expectation = wdl ? computeSyzygyExpectation(tablebase, *position, *wdl) : std::nullopt;
+
+            if (!expectation) {
+                skippedCount++;
+                continue;
+            }
+
+            checkedCount++;
+
+            const auto isWdlMismatch = mapSyzygyWdlTypeToResult(*wdl) != expectation->result;
+            const auto isDtzMismatch = dtz && expectation->dtz
+                && (computeSign(*dtz) != computeSign(*expectation->dtz) || std::abs(*dtz - *expectation->dtz) > 1);
+
+            wdlMismatchCount += isWdlMismatch;
+            dtzMismatchCount += isDtzMismatch;
+
+            if ((isWdlMismatch || isDtzMismatch) && reportedMismatches.size() < MaximumReportedMismatchCount) {
+                reportedMismatches.push_back(std::format("  {}: WDL {} DTZ {}, expected result {} DTZ {}", convertPositionToFen(*position), mapSyzygyWdlTypeToString(*wdl),
+                    dtz ? std::to_string(*dtz) : "unavailable", expectation->result, expectation->dtz ? std::to_string(*expectation->dtz) : "unknown"));
+            }
+        }
+
+        std::println("{}: {} positions checked, {} skipped, {} WDL and {} DTZ mismatches", name, checkedCount, skippedCount, wdlMismatchCount, dtzMismatchCount);
+
+        for (const auto& mismatch : reportedMismatches) {
+            std::println("{}", mismatch);
+        }
+
+        tableCount++;
+        totalCheckedCount += checkedCount;
+        mismatchCount += wdlMismatchCount + dtzMismatchCount;
+    }
+
+    if (tableCount == 0) {
+        std::println("No tables found in {}", directory.string());
+        return 1;
+    }
+
+    // Unreadable tables fail every probe, which must not pass as a clean run.
+    if (totalCheckedCount == 0) {
+        std::println("No position could be probed in {}", directory.string());
+        return 1;
+    }
+
+    return mismatchCount == 0 ? 0 : 1;
+}
@@ -0,0 +1,264 @@
+#include "Commands.h"
+
+#include "ChessCore/SearchTrace.h"
+#include "ChessCore/Uci.h"
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <print>
+#include <ranges>
+#include <string>
+#include <vector>
+
+using namespace ChessCore;
+
+// Lines are the root moves and the replies to them, which is where a search regression usually shows.
+static constexpr u8 MaximumTraceLinePly = 2;
+static constexpr usize NoTraceLineIndex = ~0ull;
+
+struct TraceLine {
+    std::string moves{};
+    u64 nodeCount{};
+    u64 visitCount{};
+    u64 researchCount{};
+    u64 researchNodeCount{};
+};
+
+struct TraceReasonSummary {
+    u64 count{};
+    u64 nodeCount{};
+};
+
+struct TracePlySummary {
+    u64 nodeCount{};
+    u64 researchCount{};
+    u64 researchNodeCount{};
+};
+
+struct TraceFrame {
+    SearchTraceEvent event{};
+    std::array<usize, MaximumTraceLinePly> lineIndices{};
+    bool isInsideResearch{};
+};
+
+struct TraceSummary {
+    u64 nodeCount{};
+    u64 eventCount{};
+    u64 droppedEventCount{};
+    u64 unmatchedEventCount{};
+    std::array<TraceReasonSummary, SearchTraceReasonTypeCount> enterReasons{};
+    std::array<u64, SearchTraceReasonTypeCount> exitReasonCounts{};
+    std::vector<TracePlySummary> plies{};
+    std::vector<TraceLine> lines{};
+    std::map<std::string, usize> lineIndices{};
+};
+
+static bool isResearchReason(SearchTraceReasonType reason) {
+    return reason == SearchTraceReasonType::ReducedResearch || reason == SearchTraceReasonType::WindowResearch;
+}
+
+// Only the squares and the promotion are stored, which is all the notation needs.
+static std::string writeTraceMove(u16 encodedMove) {
+    if (encodedMove == 0) {
+        return "null";
+    }
+
+    const auto move = ChessMove{ static_cast<u8>(encodedMove & 63), static_cast<u8>(encodedMove >> 6 & 63), static_cast<ChessPieceType>(encodedMove >> 12) };
+
+    auto buffer = UciMoveBuffer{};
+    return std::string{ writeUciMove(move, buffer) };
+}
+
+static usize findTraceLine(TraceSummary& summary, const std::string& moves) {
+    const auto [iterator, isInserted] = summary.lineIndices.try_emplace(moves, summary.lines.size());
+
+    if (isInserted) {
+        summary.lines.push_back({ moves });
+    }
+
+    return iterator->second;
+}
+
+static TraceFrame createTraceFrame(TraceSummary& summary, const std::vector<TraceFrame>& frames, const SearchTraceEvent& event) {
+    auto frame = TraceFrame{ event };
+    frame.lineIndices.fill(NoTraceLineIndex);
+
+    if (frames.empty()) {
+        return frame;
+    }
+
+    const auto& parent = frames.back();
+    frame.lineIndices = parent.lineIndices;
+    frame.isInsideResearch = parent.isInsideResearch || isResearchReason(parent.event.reason);
+
+    // A verification search is the same node again, so it extends no line.
+    if (event.ply == parent.event.ply + 1 && event.ply >= 1 && event.ply <= MaximumTraceLinePly) {
+        const auto parentLineIndex = event.ply >= 2 ? parent.lineIndices[event.ply - 2] : NoTraceLineIndex;
+        const auto parentMoves = parentLineIndex == NoTraceLineIndex ? std::string{} : summary.lines[parentLineIndex].moves + ' ';
+
+        frame.lineIndices[event.ply - 1] = findTraceLine(summary, parentMoves + writeTraceMove(event.move));
+    }
+
+    return frame;
+}
+
+static void addTraceExit(TraceSummary& summary, const TraceFrame& frame, const SearchTraceEvent& event) {
+    const auto nodeCount = static_cast<u64>(event.nodeCount - frame.event.nodeCount);
+    const auto enterReason = static_cast<usize>(frame.event.reason);
+
+    summary.enterReasons[enterReason].count++;
+    summary.enterReasons[enterReason].nodeCount += nodeCount;
+    summary.exitReasonCounts[static_cast<usize>(event.reason)]++;
+
+    if (summary.plies.size() <= event.ply) {
+        summary.plies.resize(event.ply + 1);
+    }
+
+    auto& ply = summary.plies[event.ply];
+
+    if (frame.event.reason == SearchTraceReasonType::Root) {
+        summary.nodeCount += nodeCount;
+    }
+
+    if (event.ply >= 1 && event.ply <= MaximumTraceLinePly && frame.lineIndices[event.ply - 1] != NoTraceLineIndex
+        && frame.event.reason != SearchTraceReasonType::Verification) {
+        auto& line = summary.lines[frame.lineIndices[event.ply - 1]];
+        line.nodeCount += nodeCount;
+        line.visitCount++;
+    }
+
+    ply.nodeCount += nodeCount;
+
+    if (!isResearchReason(frame.event.reason)) {
+        return;
+    }
+
+    ply.researchCount++;
+
+    // Nested re-searches are part of the outer one, so only the outermost adds its nodes.
+    if (frame.isInsideResearch) {
+        return;
+    }
+
+    ply.researchNodeCount += nodeCount;
+
+    for (const auto lineIndex : frame.lineIndices) {
+        if (lineIndex != NoTraceLineIndex) {
+            summary.lines[lineIndex].researchCount++;
+            summary.lines[lineIndex].researchNodeCount += nodeCount;
+        }
+    }
+}
+
+// Replays the events of one thread on a stack of open nodes. Dropped events leave exits without a matching
+// entry, which are skipped, and entries without an exit, which are closed by the next exit of an outer node.
+static void summarizeTraceThread(TraceSummary& summary, const SearchTraceThread& thread) {
+    auto frames = std::vector<TraceFrame>{};
+
+    summary.eventCount += thread.events.size();
+    summary.droppedEventCount += thread.droppedEventCount;
+
+    for (const auto& event : thread.events) {
+        if (event.type == SearchTraceEventType::Enter) {
+            frames.push_back(createTraceFrame(summary, frames, event));
+            continue;
+        }
+
+        while (!frames.empty() && (frames.back().event.ply != event.ply || frames.back().event.move != event.move)) {
+            frames.pop_back();
+            summary.unmatchedEventCount++;
+        }
+
+        if (frames.empty()) {
+            summary.unmatchedEventCount++;
+            continue;
+        }
+
+        const auto frame = frames.back();
+        frames.pop_back();
+
+        addTraceExit(summary, frame, event);
+    }
+
+    summary.unmatchedEventCount += frames.size();
+}
+
+static f64 computeTracePercentage(u64 part, u64 total) {
+    return total == 0 ? 0.0 : 100.0 * static_cast<f64>(part) / static_cast<f64>(total);
+}
+
+int runTraceSummaryCommand(const CommandLine& commandLine) {
+    const auto threads = readSearchTrace(commandLine.getPositional(0));
+    const auto limit = commandLine.getCount("limit", 10);
+
+    auto summary = TraceSummary{};
+
+    for (const auto& thread : threads) {
+        summarizeTraceThread(summary, thread);
+    }
+
+    std::println("{} events from {} threads, {} nodes searched from the roots", summary.eventCount, threads.size(), summary.nodeCount);
+
+    if (summary.droppedEventCount != 0 || summary.unmatchedEventCount != 0) {
+        std::println("{} events dropped while recording, {} left unmatched", summary.droppedEventCount, summary.unmatchedEventCount);
+    }
+
+    std::println("");
+    std::println("{:<20} {:>10} {:>14}", "Searched as", "count", "average nodes");
+
+    for (auto reasonIndex = 0ull; reasonIndex < SearchTraceReasonTypeCount; reasonIndex++) {
+        const auto& reason = summary.enterReasons[reasonIndex];
+
+        if (reason.count != 0) {
+            std::println("{:<20} {:>10} {:>14.1f}", mapSearchTraceReasonTypeToString(static_cast<SearchTraceReasonType>(reasonIndex)),
+                reason.count, static_cast<f64>(reason.nodeCount) / static_cast<f64>(reason.count));
+        }
+    }
+
+    std::println("");
+    std::println("{:<20} {:>10}", "Returned by", "count");
+
+    for (auto reasonIndex = 0ull; reasonIndex < SearchTraceReasonTypeCount; reasonIndex++) {
+        if (summary.exitReasonCounts[reasonIndex] != 0) {
+            std::println("{:<20} {:>10}", mapSearchTraceReasonTypeToString(static_cast<SearchTraceReasonType>(reasonIndex)), summary.exitReasonCounts[reasonIndex]);
+        }
+    }
+
+    std::println("");
+    std::println("{:>4} {:>12} {:>11} {:>12} {:>7}", "Ply", "subtree", "re-searches", "re-searched", "share");
+
+    for (auto plyIndex = 1ull; plyIndex < summary.plies.size(); plyIndex++) {
+        const auto& ply = summary.plies[plyIndex];
+
+        if (ply.researchCount != 0) {
+            std::println("{:>4} {:>12} {:>11} {:>12} {:>6.1f}%", plyIndex, ply.nodeCount, ply.researchCount, ply.researchNodeCount,
+                computeTracePercentage(ply.researchNodeCount, ply.nodeCount));
+        }
+    }
+
+    auto lines = summary.lines;
+
+    std::println("");
+    std::println("Hottest lines:");
+    std::ranges::sort(lines, std::ranges::greater{}, &TraceLine::nodeCount);
+
+    for (const auto& line : lines | std::views::take(limit)) {
+        std::println("  {:<12} {:>12} nodes {:>6.1f}% in {} visits", line.moves, line.nodeCount, computeTracePercentage(line.nodeCount, summary.nodeCount), line.visitCount);
+    }
+
+    std::println("");
+    std::println("Most re-searched lines:");
+    std::ranges::sort(lines, std::ranges::greater{}, &TraceLine::researchNodeCount);
+
+    for (const auto& line : lines | std::views::take(limit)) {
+        if (line.researchNodeCount == 0) {
+            break;
+        }
+
+        std::println("  {:<12} {:>12} nodes in {} re-searches, {:.1f}% of the line", line.moves, line.researchNodeCount, line.researchCount,
+            computeTracePercentage(line.researchNodeCount, line.nodeCount));
+    }
+
+    return 0;
+}
@@ -0,0 +1,183 @@
+#include "Commands.h"
+
+#include "ChessCore/Fen.h"
+#include "ChessCore/Game.h"
+#include "ChessCore/MoveGen.h"
+#include "ChessCore/Search.h"
+#include "ChessCore/TrainingData.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <print>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace ChessCore;
+
+// Each worker collects about 2 MiB of records before handing them to the writer in one sequential write.
+static constexpr usize TrainingBufferRecordCount = 65536;
+
+struct TrainingGameSettings {
+    SearchLimits limits{};
+    usize randomPlyCount{};
+    usize maximumPlyCount{};
+    u64 seed{};
+};
+
+static Position createTrainingOpening(const TrainingGameSettings& settings, usize gameIndex) {
+    auto position = Position::createStartingPosition();
+    auto random = std::mt19937_64{ settings.seed + gameIndex };
+
+    for (auto plyIndex = 0ull; plyIndex < settings.randomPlyCount; plyIndex++) {
+        const auto legalMoves = computeLegalMoves(position);
+
+        if (legalMoves.empty()) {
+            break;
+        }
+
+        position.makeMove(legalMoves[random() % legalMoves.size()]);
+    }
+
+    return position;
+}
+
+static bool isQuietMove(const Position& position, const ChessMove& move) {
+    return position.getPiece(move.targetSquareIndex).type == ChessPieceType::None && !move.isEnPassant && move.promotionType == ChessPieceType::None;
+}
+
+static i8 mapPgnResultTypeToTrainingResult(PgnResultType type) {
+    switch (type) {
+    case PgnResultType::WhiteWin:
+        return 1;
+    case PgnResultType::BlackWin:
+        return -1;
+    default:
+        return 0;
+    }
+}
+
+// Positions in check, with a tactical best move or a decisive score say little about the static evaluation and are skipped.
+static void playTrainingGame(const TrainingGameSettings& settings, usize gameIndex, Searcher& searcher, std::vector<TrainingRecord>& records) {
+    auto position = createTrainingOpening(settings, gameIndex);
+    auto previousKeys = std::vector<u64>{};
+    const auto firstRecordIndex = records.size();
+
+    auto result = PgnResultType::Draw;
+
+    for (auto plyIndex = 0ull; plyIndex < settings.maximumPlyCount; plyIndex++) {
+        const auto state = computeGameState(position, previousKeys);
+
+        if (state != GameStateType::InProgress) {
+            result = mapGameStateTypeToPgnResultType(state, position.getSideToMove());
+            break;
+        }
+
+        const auto searchResult = searcher.search(position, settings.limits, previousKeys);
+        const auto& move = *searchResult.bestMove;
+
+        if (!position.isKingUnderCheck() && isQuietMove(position, move) && !isDecisiveScore(searchResult.score)) {
+            const auto ply = static_cast<u16>(settings.randomPlyCount + plyIndex);
+            records.push_back(packTrainingRecord(position, static_cast<i16>(searchResult.score), 0, ply));
+        }
+
+        previousKeys.push_back(position.getKey());
+        position.makeMove(move);
+    }
+
+    const auto trainingResult = mapPgnResultTypeToTrainingResult(result);
+
+    for (auto recordIndex = firstRecordIndex; recordIndex < records.size(); recordIndex++) {
+        records[recordIndex].result = trainingResult;
+    }
+}
+
+int runGenerateDataCommand(const CommandLine& commandLine) {
+    const auto outputPath = commandLine.getPositional(0);
+
+    auto settings = TrainingGameSettings{};
+    settings.limits.nodeCount = commandLine.getCount("nodes", 5000);
+    settings.limits.depth = static_cast<u32>(commandLine.getCount("depth", MaximumSearchDepth));
+    settings.randomPlyCount = commandLine.getCount("random-plies", 8);
+    settings.maximumPlyCount = commandLine.getCount("max-plies", 400);
+    settings.seed = commandLine.getCount("seed", 1);
+
+    const auto gameCount = commandLine.getCount("games", 1000);
+    const auto threadCount = std::clamp<usize>(commandLine.getCount("threads", getDefaultThreadCount()), 1, std::max<usize>(gameCount, 1));
+    const auto hashSize = commandLine.getCount("hash", 16);
+
+    auto writer = TrainingDataWriter{ outputPath };
+    auto nextGameIndex = std::atomic<usize>{};
+
+    std::println("{} games at {} nodes per move on {} threads", gameCount, settings.limits.nodeCount, threadCount);
+
+    const auto startTime = std::chrono::steady_clock::now();
+
+    {
+        auto threads = std::vector<std::jthread>{};
+        threads.reserve(threadCount);
+
+        for (auto threadIndex = 0ull; threadIndex < threadCount; threadIndex++) {
+            threads.emplace_back([&] {
+                auto transpositionTable = TranspositionTable{ hashSize };
+                auto searcher = Searcher{ transpositionTable };
+                auto records = std::vector<TrainingRecord>{};
+
+                records.reserve(TrainingBufferRecordCount + settings.maximumPlyCount);
+
+                while (true) {
+                    const auto gameIndex = nextGameIndex++;
+
+                    if (gameIndex >= gameCount) {
+                        break;
+                    }
+
+                    transpositionTable.clear();
+                    playTrainingGame(settings, gameIndex, searcher, records);
+
+                    if (records.size() >= TrainingBufferRecordCount) {
+                        writer.write(records);
+                        records.clear();
+                    }
+
+                    if ((gameIndex + 1) % 100 == 0) {
+                        std::println("{} games, {} positions written", gameIndex + 1, writer.getRecordCount());
+                    }
+                }
+
+                writer.write(records);
+            });
+        }
+    }
+
+    const auto elapsedTime = std::chrono::duration<f64>(std::chrono::steady_clock::now() - startTime).count();
+    const auto recordCount = writer.getRecordCount();
+
+    std::println("{} positions from {} games in {:.1f} s, {:.0f} positions/s", recordCount, gameCount, elapsedTime, recordCount / std::max(elapsedTime, 1e-9));
+
+    return 0;
+}
+
+int runSampleDataCommand(const CommandLine& commandLine) {
+    const auto reader = TrainingDataReader{ commandLine.getPositional(0) };
+    const auto sampleCount = commandLine.getCount("count", 10);
+
+    auto random = std::mt19937_64{ commandLine.getCount("seed", std::random_device{}()) };
+    auto resultCounts = std::array<usize, 3>{};
+
+    std::println("{} records", reader.getRecordCount());
+
+    for (auto sampleIndex = 0ull; sampleIndex < sampleCount; sampleIndex++) {
+        const auto record = reader.sampleRecord(random());
+        const auto position = unpackTrainingRecord(record);
+
+        resultCounts[record.result + 1]++;
+        std::println("{:<90} score {:>6} result {:>2} ply {}", convertPositionToFen(position), record.score, static_cast<i32>(record.result), record.ply);
+    }
+
+    std::println("Sampled results: {} white wins, {} draws, {} black wins", resultCounts[2], resultCounts[1], resultCounts[0]);
+
+    return 0;
+}
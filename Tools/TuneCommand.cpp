@@ -0,0 +1,116 @@
+#include "Commands.h"
+
+#include "ChessCore/Tuner.h"
+
+#include <array>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <print>
+#include <stdexcept>
+#include <string>
+
+using namespace ChessCore;
+
+static constexpr std::array<std::string_view, ChessPieceTypeCount> TunedPieceNames = { "None", "Queen", "Rook", "Bishop", "Knight", "Pawn", "King" };
+
+static constexpr std::array<std::string_view, GamePhaseTypeCount> TunedPhaseNames = { "Middlegame", "Endgame" };
+
+static TunerOptimizerType parseTunerOptimizerType(std::string_view name) {
+    if (name == "adam") {
+        return TunerOptimizerType::Adam;
+    }
+
+    if (name == "gd") {
+        return TunerOptimizerType::GradientDescent;
+    }
+
+    throw std::runtime_error(std::format("Unknown optimizer '{}', expected adam or gd", name));
+}
+
+// Written in the layout of the tables in Evaluation.cpp, so tuned values can be pasted back.
+static std::string writeEvaluationParameters(const EvaluationParameters& parameters) {
+    auto text = std::string{};
+
+    for (auto phase = 0ull; phase < GamePhaseTypeCount; phase++) {
+        text += std::format("pieceValues[{}] = {{ ", TunedPhaseNames[phase]);
+
+        for (auto type = 0ull; type < ChessPieceTypeCount; type++) {
+            text += std::format("{}{}", type == 0 ? "" : ", ", parameters.pieceValues[phase][type]);
+        }
+
+        text += " };\n";
+    }
+
+    for (auto type = 1ull; type < ChessPieceTypeCount; type++) {
+        for (auto phase = 0ull; phase < GamePhaseTypeCount; phase++) {
+            text += std::format("\n{}{}Table = {{\n", TunedPieceNames[type], TunedPhaseNames[phase]);
+
+            for (auto rank = 0ull; rank < BoardSquareSize; rank++) {
+                text += "   ";
+
+                for (auto file = 0ull; file < BoardSquareSize; file++) {
+                    text += std::format(" {:>4},", parameters.pieceSquareValues[phase][type][rank * BoardSquareSize + file]);
+                }
+
+                text += '\n';
+            }
+
+            text += "};\n";
+        }
+    }
+
+    return text;
+}
+
+int runTuneCommand(const CommandLine& commandLine) {
+    const auto reader = TrainingDataReader{ commandLine.getPositional(0) };
+
+    auto settings = TunerSettings{};
+    settings.optimizer = parseTunerOptimizerType(commandLine.getOption("optimizer", "adam"));
+    settings.threadCount = commandLine.getCount("threads", getDefaultThreadCount());
+    settings.batchSize = commandLine.getCount("batch", 16384);
+    settings.epochCount = commandLine.getCount("epochs", 10);
+    settings.seed = commandLine.getCount("seed", 1);
+
+    // Plain gradients of the sigmoid loss are tiny compared to centipawn weights, Adam steps are about the rate itself.
+    settings.learningRate = commandLine.getNumber("rate", settings.optimizer == TunerOptimizerType::Adam ? 1.0 : 5000.0);
+
+    auto tuner = EvaluationTuner{ getDefaultEvaluationParameters() };
+
+    const auto loadStartTime = std::chrono::steady_clock::now();
+    tuner.loadPositions(reader, commandLine.getCount("positions", 0), settings.threadCount);
+
+    std::println("Resolved {} positions with a quiescence search in {:.1f} s", tuner.getPositionCount(),
+        std::chrono::duration<f64>(std::chrono::steady_clock::now() - loadStartTime).count());
+
+    if (commandLine.hasOption("k")) {
+        tuner.setScalingConstant(commandLine.getNumber("k", 1.0));
+    } else {
+        tuner.fitScalingConstant(settings.threadCount);
+    }
+
+    std::println("K {:.4f}, initial loss {:.6f}", tuner.getScalingConstant(), tuner.computeLoss(settings.threadCount));
+    std::println("{} epochs with {}, learning rate {}, batches of {} on {} threads",
+        settings.epochCount, mapTunerOptimizerTypeToString(settings.optimizer), settings.learningRate, settings.batchSize, settings.threadCount);
+
+    const auto tuneStartTime = std::chrono::steady_clock::now();
+
+    tuner.tune(settings, [&](usize epochIndex, f64 loss) {
+        const auto elapsedTime = std::chrono::duration<f64>(std::chrono::steady_clock::now() - tuneStartTime).count();
+        std::println("Epoch {:>4}: loss {:.6f}, {:.1f} s", epochIndex + 1, loss, elapsedTime);
+    });
+
+    std::println("Final loss {:.6f}", tuner.computeLoss(settings.threadCount));
+
+    const auto text = writeEvaluationParameters(tuner.getParameters());
+
+    if (commandLine.hasOption("output")) {
+        auto file = std::ofstream{ std::string{ commandLine.getOption("output", {}) } };
+        file << text;
+    } else {
+        std::print("\n{}", text);
+    }
+
+    return 0;
+}